@@ -0,0 +1,400 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <array>
+#include <cmath>
+#include <type_traits>
+
+// Optima includes
+#include <Optima/ConstraintFunction.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/ObjectiveFunction.hpp>
+
+namespace Optima {
+
+/// Used to represent a number for forward-mode automatic differentiation along *N* directions.
+/// The derivatives along the *N* directions are stored contiguously so that
+/// their propagation through arithmetic operations can be vectorized. Nesting
+/// (e.g., `Dual<Dual<double, N>, N>`) permits second-order derivatives with
+/// forward-over-forward differentiation.
+template<typename T, Index N>
+struct Dual
+{
+    /// The value of the number.
+    T val = {};
+
+    /// The derivatives of the number along each direction.
+    std::array<T, N> grad = {};
+
+    /// Construct a default Dual object with zero value and derivatives.
+    Dual() = default;
+
+    /// Construct a Dual object with given constant value.
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    Dual(U val) : val(val) {}
+
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    auto operator=(U other) -> Dual& { val = other; grad = {}; return *this; }
+
+    auto operator+=(const Dual& other) -> Dual& { return *this = *this + other; }
+    auto operator-=(const Dual& other) -> Dual& { return *this = *this - other; }
+    auto operator*=(const Dual& other) -> Dual& { return *this = *this * other; }
+    auto operator/=(const Dual& other) -> Dual& { return *this = *this / other; }
+};
+
+/// Return the value of a number (i.e., without any derivatives).
+inline auto value(double x) -> double { return x; }
+
+/// Return the value of a dual number (i.e., without any derivatives).
+template<typename T, Index N>
+auto value(const Dual<T, N>& x) -> double { return value(x.val); }
+
+/// Return the dual number with given value and derivatives *dfdx* times those of *x*.
+template<typename T, Index N>
+auto chain(const T& f, const T& dfdx, const Dual<T, N>& x) -> Dual<T, N>
+{
+    Dual<T, N> res;
+    res.val = f;
+    for(Index i = 0; i < N; ++i)
+        res.grad[i] = dfdx * x.grad[i];
+    return res;
+}
+
+template<typename T, Index N>
+auto operator+(const Dual<T, N>& a) -> Dual<T, N> { return a; }
+
+template<typename T, Index N>
+auto operator-(const Dual<T, N>& a) -> Dual<T, N>
+{
+    Dual<T, N> res;
+    res.val = -a.val;
+    for(Index i = 0; i < N; ++i)
+        res.grad[i] = -a.grad[i];
+    return res;
+}
+
+template<typename T, Index N>
+auto operator+(const Dual<T, N>& a, const Dual<T, N>& b) -> Dual<T, N>
+{
+    Dual<T, N> res;
+    res.val = a.val + b.val;
+    for(Index i = 0; i < N; ++i)
+        res.grad[i] = a.grad[i] + b.grad[i];
+    return res;
+}
+
+template<typename T, Index N>
+auto operator-(const Dual<T, N>& a, const Dual<T, N>& b) -> Dual<T, N>
+{
+    Dual<T, N> res;
+    res.val = a.val - b.val;
+    for(Index i = 0; i < N; ++i)
+        res.grad[i] = a.grad[i] - b.grad[i];
+    return res;
+}
+
+template<typename T, Index N>
+auto operator*(const Dual<T, N>& a, const Dual<T, N>& b) -> Dual<T, N>
+{
+    Dual<T, N> res;
+    res.val = a.val * b.val;
+    for(Index i = 0; i < N; ++i)
+        res.grad[i] = a.grad[i] * b.val + a.val * b.grad[i];
+    return res;
+}
+
+template<typename T, Index N>
+auto operator/(const Dual<T, N>& a, const Dual<T, N>& b) -> Dual<T, N>
+{
+    Dual<T, N> res;
+    const T inv = 1.0 / b.val;
+    res.val = a.val * inv;
+    for(Index i = 0; i < N; ++i)
+        res.grad[i] = (a.grad[i] - res.val * b.grad[i]) * inv;
+    return res;
+}
+
+template<typename T, Index N> auto operator+(const Dual<T, N>& a, double b) -> Dual<T, N> { Dual<T, N> res = a; res.val = a.val + b; return res; }
+template<typename T, Index N> auto operator+(double a, const Dual<T, N>& b) -> Dual<T, N> { return b + a; }
+template<typename T, Index N> auto operator-(const Dual<T, N>& a, double b) -> Dual<T, N> { Dual<T, N> res = a; res.val = a.val - b; return res; }
+template<typename T, Index N> auto operator-(double a, const Dual<T, N>& b) -> Dual<T, N> { return -b + a; }
+template<typename T, Index N> auto operator/(double a, const Dual<T, N>& b) -> Dual<T, N> { const T f = a / b.val; return chain(f, -f / b.val, b); }
+
+template<typename T, Index N>
+auto operator*(const Dual<T, N>& a, double b) -> Dual<T, N>
+{
+    Dual<T, N> res;
+    res.val = a.val * b;
+    for(Index i = 0; i < N; ++i)
+        res.grad[i] = a.grad[i] * b;
+    return res;
+}
+
+template<typename T, Index N> auto operator*(double a, const Dual<T, N>& b) -> Dual<T, N> { return b * a; }
+template<typename T, Index N> auto operator/(const Dual<T, N>& a, double b) -> Dual<T, N> { return a * (1.0 / b); }
+
+template<typename T, Index N> auto operator==(const Dual<T, N>& a, const Dual<T, N>& b) -> bool { return value(a) == value(b); }
+template<typename T, Index N> auto operator!=(const Dual<T, N>& a, const Dual<T, N>& b) -> bool { return value(a) != value(b); }
+template<typename T, Index N> auto operator< (const Dual<T, N>& a, const Dual<T, N>& b) -> bool { return value(a) <  value(b); }
+template<typename T, Index N> auto operator> (const Dual<T, N>& a, const Dual<T, N>& b) -> bool { return value(a) >  value(b); }
+template<typename T, Index N> auto operator<=(const Dual<T, N>& a, const Dual<T, N>& b) -> bool { return value(a) <= value(b); }
+template<typename T, Index N> auto operator>=(const Dual<T, N>& a, const Dual<T, N>& b) -> bool { return value(a) >= value(b); }
+template<typename T, Index N> auto operator==(const Dual<T, N>& a, double b) -> bool { return value(a) == b; }
+template<typename T, Index N> auto operator!=(const Dual<T, N>& a, double b) -> bool { return value(a) != b; }
+template<typename T, Index N> auto operator< (const Dual<T, N>& a, double b) -> bool { return value(a) <  b; }
+template<typename T, Index N> auto operator> (const Dual<T, N>& a, double b) -> bool { return value(a) >  b; }
+template<typename T, Index N> auto operator<=(const Dual<T, N>& a, double b) -> bool { return value(a) <= b; }
+template<typename T, Index N> auto operator>=(const Dual<T, N>& a, double b) -> bool { return value(a) >= b; }
+template<typename T, Index N> auto operator==(double a, const Dual<T, N>& b) -> bool { return a == value(b); }
+template<typename T, Index N> auto operator!=(double a, const Dual<T, N>& b) -> bool { return a != value(b); }
+template<typename T, Index N> auto operator< (double a, const Dual<T, N>& b) -> bool { return a <  value(b); }
+template<typename T, Index N> auto operator> (double a, const Dual<T, N>& b) -> bool { return a >  value(b); }
+template<typename T, Index N> auto operator<=(double a, const Dual<T, N>& b) -> bool { return a <= value(b); }
+template<typename T, Index N> auto operator>=(double a, const Dual<T, N>& b) -> bool { return a >= value(b); }
+
+// The mathematical functions below are found by argument-dependent lookup,
+// and so they must be called unqualified in user functions (e.g., `exp(x)`
+// instead of `std::exp(x)`). The nested calls on `x.val` resolve to the
+// functions in namespace std when `T` is `double`.
+
+template<typename T, Index N> auto abs(const Dual<T, N>& x) -> Dual<T, N> { return x < 0.0 ? -x : x; }
+template<typename T, Index N> auto exp(const Dual<T, N>& x) -> Dual<T, N> { using std::exp; const T f = exp(x.val); return chain(f, f, x); }
+template<typename T, Index N> auto log(const Dual<T, N>& x) -> Dual<T, N> { using std::log; return chain(T(log(x.val)), T(1.0 / x.val), x); }
+template<typename T, Index N> auto log10(const Dual<T, N>& x) -> Dual<T, N> { using std::log; return log(x) * (1.0 / log(10.0)); }
+template<typename T, Index N> auto sqrt(const Dual<T, N>& x) -> Dual<T, N> { using std::sqrt; const T f = sqrt(x.val); return chain(f, T(0.5 / f), x); }
+template<typename T, Index N> auto sin(const Dual<T, N>& x) -> Dual<T, N> { using std::sin; using std::cos; return chain(T(sin(x.val)), T(cos(x.val)), x); }
+template<typename T, Index N> auto cos(const Dual<T, N>& x) -> Dual<T, N> { using std::sin; using std::cos; return chain(T(cos(x.val)), T(-sin(x.val)), x); }
+template<typename T, Index N> auto tan(const Dual<T, N>& x) -> Dual<T, N> { using std::tan; const T f = tan(x.val); return chain(f, T(1.0 + f * f), x); }
+template<typename T, Index N> auto atan(const Dual<T, N>& x) -> Dual<T, N> { using std::atan; return chain(T(atan(x.val)), T(1.0 / (1.0 + x.val * x.val)), x); }
+template<typename T, Index N> auto sinh(const Dual<T, N>& x) -> Dual<T, N> { using std::sinh; using std::cosh; return chain(T(sinh(x.val)), T(cosh(x.val)), x); }
+template<typename T, Index N> auto cosh(const Dual<T, N>& x) -> Dual<T, N> { using std::sinh; using std::cosh; return chain(T(cosh(x.val)), T(sinh(x.val)), x); }
+template<typename T, Index N> auto tanh(const Dual<T, N>& x) -> Dual<T, N> { using std::tanh; const T f = tanh(x.val); return chain(f, T(1.0 - f * f), x); }
+template<typename T, Index N> auto pow(const Dual<T, N>& x, double a) -> Dual<T, N> { using std::pow; return chain(T(pow(x.val, a)), T(a * pow(x.val, a - 1.0)), x); }
+template<typename T, Index N> auto pow(double a, const Dual<T, N>& x) -> Dual<T, N> { using std::log; return exp(x * log(a)); }
+template<typename T, Index N> auto pow(const Dual<T, N>& x, const Dual<T, N>& y) -> Dual<T, N> { return exp(y * log(x)); }
+
+/// Return an objective function whose derivatives are computed with forward-mode automatic differentiation.
+/// The given function must be callable as `fn(x, p)` with `x` and `p` of
+/// type `const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>&` and return the
+/// value of *f(x, p)* as `Scalar`, where `Scalar` is `double` or a Dual
+/// number type (e.g., a generic lambda with `auto` arguments). The gradient
+/// *fx* is computed in passes of *N* directions. The Hessian blocks *fxx*
+/// and *fxp* are computed with forward-over-forward differentiation, only if
+/// requested in ObjectiveOptions::eval, and only the upper block triangle of
+/// the symmetric *fxx* is computed.
+/// @param fn The function computing *f(x, p)*.
+/// @param fxx4basicvars True if only the columns of *fxx* corresponding to
+/// the basic variables in ObjectiveOptions::ibasicvars should be computed
+/// (see ObjectiveResult::fxx4basicvars). The inner directions of the passes
+/// for *fxx* are then seeded only along these variables, which needs fewer
+/// passes when there are fewer basic variables than about half of the
+/// variables in *x* (otherwise, *fxx* is computed in full). Note that the
+/// remaining columns of *fxx* are then considered zero in the calculation,
+/// and so this should be enabled only if this approximation is acceptable.
+template<Index N = 4, typename Function>
+auto autodiffObjectiveFunction(Function fn, bool fxx4basicvars = false) -> ObjectiveFunction
+{
+    using Dual1 = Dual<double, N>;
+    using Dual2 = Dual<Dual1, N>;
+    using Vector1 = Eigen::Matrix<Dual1, Eigen::Dynamic, 1>;
+    using Vector2 = Eigen::Matrix<Dual2, Eigen::Dynamic, 1>;
+
+    return ObjectiveFunction([=](ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions opts)
+    {
+        const Index nx = x.size();
+        const Index np = p.size();
+        const auto evalfxx = opts.eval.fxx && nx > 0;
+        const auto evalfxp = opts.eval.fxp && nx > 0 && np > 0;
+
+        if(nx == 0)
+        {
+            res.f = fn(Vector(x), Vector(p));
+            return;
+        }
+
+        if(!evalfxx && !evalfxp)
+        {
+            // First-order passes along N directions of x at a time for f and fx.
+            Vector1 xd = x.template cast<Dual1>();
+            Vector1 pd = p.template cast<Dual1>();
+            for(Index i = 0; i < nx; i += N)
+            {
+                const Index n = std::min(N, nx - i);
+                for(Index a = 0; a < n; ++a) xd[i + a].grad[a] = 1.0;
+                const Dual1 r = fn(xd, pd);
+                for(Index a = 0; a < n; ++a) xd[i + a].grad[a] = 0.0;
+                for(Index a = 0; a < n; ++a) res.fx[i + a] = r.grad[a];
+                res.f = r.val;
+            }
+            return;
+        }
+
+        // Second-order passes with outer directions along x (giving fx) and
+        // inner directions along x (giving fxx) or along p (giving fxp). The
+        // inner directions are the entries in z given by the index map jz.
+        Vector2 xd = x.template cast<Dual2>();
+        Vector2 pd = p.template cast<Dual2>();
+
+        const auto pass = [&](Index i, Index ni, Vector2& zd, Index nj, auto&& jz, auto&& store)
+        {
+            for(Index a = 0; a < ni; ++a) xd[i + a].grad[a].val = 1.0;
+            for(Index b = 0; b < nj; ++b) zd[jz(b)].val.grad[b] = 1.0;
+            const Dual2 r = fn(xd, pd);
+            for(Index a = 0; a < ni; ++a) xd[i + a].grad[a].val = 0.0;
+            for(Index b = 0; b < nj; ++b) zd[jz(b)].val.grad[b] = 0.0;
+            res.f = r.val.val;
+            for(Index a = 0; a < ni; ++a) res.fx[i + a] = r.grad[a].val;
+            for(Index a = 0; a < ni; ++a)
+                for(Index b = 0; b < nj; ++b)
+                    store(i + a, jz(b), r.grad[a].grad[b]);
+        };
+
+        // The passes for fxx along the basic variables only are used if fewer than those for its upper block triangle.
+        const auto jb = opts.ibasicvars;
+        const Index nb = jb.size();
+        const Index mx = (nx + N - 1)/N;
+        const Index mb = (nb + N - 1)/N;
+        const auto basic = evalfxx && fxx4basicvars && mx*mb < mx*(mx + 1)/2;
+
+        res.fxx4basicvars = basic;
+
+        for(Index i = 0; i < nx; i += N)
+        {
+            const Index ni = std::min(N, nx - i);
+            if(evalfxx && basic)
+                for(Index j = 0; j < nb; j += N)
+                    pass(i, ni, xd, std::min(N, nb - j), [&](Index b) { return jb[j + b]; }, [&](Index k, Index l, double d) { res.fxx(k, l) = d; });
+            if(evalfxx && !basic)
+                for(Index j = i; j < nx; j += N)
+                    pass(i, ni, xd, std::min(N, nx - j), [&](Index b) { return j + b; }, [&](Index k, Index l, double d) { res.fxx(k, l) = res.fxx(l, k) = d; });
+            if(evalfxp)
+                for(Index j = 0; j < np; j += N)
+                    pass(i, ni, pd, std::min(N, np - j), [&](Index b) { return j + b; }, [&](Index k, Index l, double d) { res.fxp(k, l) = d; });
+            if(basic && nb == 0 && !evalfxp) // no pass above has computed f and fx
+                pass(i, ni, xd, 0, [&](Index b) { return b; }, [&](Index k, Index l, double d) {});
+        }
+    });
+}
+
+/// Return a constraint function whose derivatives are computed with forward-mode automatic differentiation.
+/// The given function must be callable as `fn(x, p)` with `x` and `p` of
+/// type `const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>&` and return the
+/// value of *c(x, p)* as `Eigen::Matrix<Scalar, Eigen::Dynamic, 1>`, where
+/// `Scalar` is `double` or a Dual number type. The Jacobian matrices *ddx*
+/// and *ddp* are computed in passes of *N* directions, only if requested in
+/// ConstraintOptions::eval.
+/// @param fn The function computing *c(x, p)*.
+/// @param ddx4basicvars True if only the columns of *ddx* corresponding to
+/// the basic variables in ConstraintOptions::ibasicvars should be computed
+/// (see ConstraintResult::ddx4basicvars). The directions of the passes for
+/// *ddx* are then seeded only along these variables, which needs fewer
+/// passes when there are fewer basic variables than variables in *x*
+/// (otherwise, or if no basic variables are given, *ddx* is computed in
+/// full). This is enabled by default, since the function is evaluated again
+/// for the variables that become basic after an evaluation (see
+/// ResidualFunction). Note that the remaining columns of *ddx* are then
+/// considered zero in the calculation.
+template<Index N = 4, typename Function>
+auto autodiffConstraintFunction(Function fn, bool ddx4basicvars = true) -> ConstraintFunction
+{
+    using Dual1 = Dual<double, N>;
+    using Vector1 = Eigen::Matrix<Dual1, Eigen::Dynamic, 1>;
+
+    return ConstraintFunction([=](ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts)
+    {
+        const Index nx = x.size();
+        const Index np = p.size();
+        const auto evalddx = opts.eval.ddx && nx > 0;
+        const auto evalddp = opts.eval.ddp && np > 0;
+
+        // The passes for ddx along the basic variables only are used if fewer than those along all variables.
+        const auto jb = opts.ibasicvars;
+        const Index nb = jb.size();
+        const auto basic = evalddx && ddx4basicvars && nb > 0 && (nb + N - 1)/N < (nx + N - 1)/N;
+
+        res.ddx4basicvars = basic;
+
+        if(!evalddx && !evalddp)
+        {
+            res.val = fn(Vector(x), Vector(p));
+            return;
+        }
+
+        Vector1 xd = x.template cast<Dual1>();
+        Vector1 pd = p.template cast<Dual1>();
+
+        // A pass along the entries in z given by the index map jz, whose derivatives are stored in the columns of dd.
+        const auto pass = [&](Vector1& zd, Index nj, auto&& jz, MatrixRef dd)
+        {
+            for(Index b = 0; b < nj; ++b) zd[jz(b)].grad[b] = 1.0;
+            const Vector1 r = fn(xd, pd);
+            for(Index b = 0; b < nj; ++b) zd[jz(b)].grad[b] = 0.0;
+            for(Index c = 0; c < r.size(); ++c)
+            {
+                res.val[c] = r[c].val;
+                for(Index b = 0; b < nj; ++b)
+                    dd(c, jz(b)) = r[c].grad[b];
+            }
+        };
+
+        if(evalddx && basic)
+            for(Index j = 0; j < nb; j += N)
+                pass(xd, std::min(N, nb - j), [&](Index b) { return jb[j + b]; }, res.ddx);
+        if(evalddx && !basic)
+            for(Index j = 0; j < nx; j += N)
+                pass(xd, std::min(N, nx - j), [&](Index b) { return j + b; }, res.ddx);
+        if(evalddp)
+            for(Index j = 0; j < np; j += N)
+                pass(pd, std::min(N, np - j), [&](Index b) { return j + b; }, res.ddp);
+    });
+}
+
+} // namespace Optima
+
+namespace Eigen {
+
+template<typename T, Optima::Index N>
+struct NumTraits<Optima::Dual<T, N>> : NumTraits<double>
+{
+    using Real = Optima::Dual<T, N>;
+    using NonInteger = Optima::Dual<T, N>;
+    using Nested = Optima::Dual<T, N>;
+    using Literal = Optima::Dual<T, N>;
+
+    enum
+    {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = 1,
+        AddCost = 1 + N,
+        MulCost = 1 + 2 * N
+    };
+};
+
+template<typename T, Optima::Index N, typename BinaryOp>
+struct ScalarBinaryOpTraits<Optima::Dual<T, N>, double, BinaryOp> { using ReturnType = Optima::Dual<T, N>; };
+
+template<typename T, Optima::Index N, typename BinaryOp>
+struct ScalarBinaryOpTraits<double, Optima::Dual<T, N>, BinaryOp> { using ReturnType = Optima::Dual<T, N>; };
+
+} // namespace Eigen
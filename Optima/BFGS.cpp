@@ -0,0 +1,82 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BFGS.hpp"
+
+namespace Optima {
+
+BFGS::BFGS(Index n)
+: B(n, n), x0(n), g0(n), s(n), y(n), Bs(n)
+{
+    reset();
+}
+
+auto BFGS::reset() -> void
+{
+    B.setIdentity();
+    empty = true;
+    initial = true;
+}
+
+auto BFGS::update(VectorView x, VectorView g) -> void
+{
+    if(empty)
+    {
+        x0 = x;
+        g0 = g;
+        empty = false;
+        return;
+    }
+
+    s.noalias() = x - x0;
+    y.noalias() = g - g0;
+    x0 = x;
+    g0 = g;
+
+    // Skip the update if the point has not changed (e.g., a rejected step).
+    if(s.squaredNorm() == 0.0)
+        return;
+
+    const auto sy = s.dot(y);
+
+    // Scale the initial identity matrix with the curvature along s, if positive.
+    if(initial && sy > 0.0)
+        B.diagonal().fill(y.squaredNorm()/sy);
+    initial = false;
+
+    Bs.noalias() = B*s;
+    const auto sBs = s.dot(Bs);
+
+    // Powell's damping: replace y by r = theta*y + (1 - theta)*B*s so that s'r >= 0.2*s'Bs.
+    const auto theta = (sy >= 0.2*sBs) ? 1.0 : 0.8*sBs/(sBs - sy);
+    y = theta*y + (1 - theta)*Bs;
+    const auto sr = s.dot(y);
+
+    if(!(sBs > 0.0 && sr > 0.0)) // protect against round-off in degenerate cases
+        return;
+
+    // B = B - (Bs)(Bs)'/(s'Bs) + rr'/(s'r), with the rank-one updates applied column by column to avoid temporaries
+    for(Index j = 0; j < B.cols(); ++j)
+        B.col(j) += (y[j]/sr)*y - (Bs[j]/sBs)*Bs;
+}
+
+auto BFGS::hessian() const -> MatrixView
+{
+    return B;
+}
+
+} // namespace Optima
@@ -0,0 +1,60 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// Used to approximate a Hessian matrix with damped BFGS updates.
+/// The approximation *B* of the Hessian matrix of a function is updated
+/// from the changes in its gradient *g* between successive points *x*. The
+/// damping of Powell ensures that *B* remains positive definite even when
+/// the curvature condition \eq{s^{T}y > 0} fails, where \eq{s=x-x_{0}} and
+/// \eq{y=g-g_{0}}. The first approximation is the identity matrix, which
+/// is scaled by \eq{y^{T}y/s^{T}y} at the first update.
+class BFGS
+{
+private:
+    Matrix B;       ///< The current approximation of the Hessian matrix.
+    Vector x0;      ///< The point in the last update.
+    Vector g0;      ///< The gradient at the point in the last update.
+    Vector s;       ///< The workspace for the change in x.
+    Vector y;       ///< The workspace for the change in g.
+    Vector Bs;      ///< The workspace for the product B*s.
+    bool empty;     ///< True if no update has been performed since construction or last reset.
+    bool initial;   ///< True if the approximation is still the initial identity matrix.
+
+public:
+    /// Construct a BFGS object.
+    /// @param n The number of variables.
+    BFGS(Index n);
+
+    /// Reset the approximation of the Hessian matrix to the identity matrix.
+    auto reset() -> void;
+
+    /// Update the approximation of the Hessian matrix with the gradient *g* at point *x*.
+    auto update(VectorView x, VectorView g) -> void;
+
+    /// Return the current approximation of the Hessian matrix.
+    auto hessian() const -> MatrixView;
+};
+
+} // namespace Optima
@@ -17,6 +17,9 @@
 
 #include "BacktrackSearch.hpp"
 
+// C++ includes
+#include <cmath>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 
@@ -24,13 +27,47 @@ namespace Optima {
 
 struct BacktrackSearch::Impl
 {
+    /// The trial state of u = (x, p, y, z) during the backtrack search.
+    MasterVector utrial;
+
+    /// The options for the backtrack search.
+    BacktrackSearchOptions options;
+
+    /// The token checked in each iteration of the backtrack search to stop it if the calculation has been cancelled.
+    CancellationToken cancellation;
+
     Impl(const MasterDims& dims)
+    : utrial(dims)
+    {
+    }
+
+    auto setOptions(const Options& opts) -> void
     {
+        options = opts.backtrack;
+        cancellation = opts.cancellation;
     }
 
-    auto start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
+    auto start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> bool
     {
+        const auto factor = options.factor;
+        const auto maxiters = options.maxiters;
+
+        // Successively decrease the length of the step from uo to u until the error is finite.
+        auto alpha = 1.0;
+        for(auto i = 0; i < maxiters && !cancellation.cancelled(); ++i)
+        {
+            alpha *= factor;
+            utrial = uo*(1 - alpha) + alpha*u; // using uo + alpha*(u - uo) is sensitive to round-off errors!
+            F.updateSkipJacobian(utrial);
+            E.update(utrial, F);
+            if(F.result().succeeded && std::isfinite(E.error))
+            {
+                u = utrial;
+                return true;
+            }
+        }
 
+        return false; // u is left unchanged, since no trial state has a finite error (or maxiters is zero, or the calculation was cancelled)
     }
 };
 
@@ -51,9 +88,14 @@ auto BacktrackSearch::operator=(BacktrackSearch other) -> BacktrackSearch&
     return *this;
 }
 
-auto BacktrackSearch::start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
+auto BacktrackSearch::setOptions(const Options& options) -> void
 {
+    pimpl->setOptions(options);
+}
 
+auto BacktrackSearch::start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> bool
+{
+    return pimpl->start(uo, u, F, E);
 }
 
 } // namespace Optima
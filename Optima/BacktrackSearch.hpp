@@ -22,6 +22,7 @@
 
 // Optima includes
 #include <Optima/MasterVector.hpp>
+#include <Optima/Options.hpp>
 #include <Optima/ResidualErrors.hpp>
 #include <Optima/ResidualFunction.hpp>
 
@@ -48,8 +49,17 @@ public:
     /// Assign a BacktrackSearch object to this.
     auto operator=(BacktrackSearch other) -> BacktrackSearch&;
 
+    /// Set the options of this BacktrackSearch object.
+    /// The backtrack search stops before its next trial state once Options::cancellation is cancelled.
+    auto setOptions(const Options& options) -> void;
+
     /// Start the backtrack search until the error is no longer infinity.
-    auto start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void;
+    /// The trial states along the step from *uo* to *u* are evaluated with
+    /// @ref ResidualFunction::updateSkipJacobian, so that *F* and *E* are
+    /// evaluated at the returned *u* without Jacobian evaluations.
+    /// @return True if a trial state with finite error was found. Otherwise (also if the calculation is cancelled),
+    /// *u* is left unchanged and *F* and *E* are not evaluated at it.
+    auto start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> bool;
 };
 
 } // namespace Optima
@@ -0,0 +1,184 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BatchLU.hpp"
+
+// C++ includes
+#include <cassert>
+#include <cmath>
+
+namespace Optima {
+
+struct BatchLU::Impl
+{
+    /// The dimension of the matrices in the last decomposition.
+    Index n = 0;
+
+    /// The lower and upper triangular factors of the matrices in all lanes (row `i*n + j` holds their entries *(i, j)*).
+    LaneMatrix LUw;
+
+    /// The row swapped with row *k* in the *k*-th step of the decomposition of each lane (row *k* for all lanes).
+    Eigen::Matrix<Index, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> piv;
+
+    /// The lanes whose matrix is singular.
+    LaneMask singularlanes;
+
+    /// The workspace for the magnitudes of the pivots in the lanes.
+    Eigen::Array<double, 1, Eigen::Dynamic> best;
+
+    /// The workspace for the pivot rows in the lanes.
+    Eigen::Array<Index, 1, Eigen::Dynamic> ipiv;
+
+    /// The workspace for the swap of rows in the lanes.
+    Eigen::Array<double, 1, Eigen::Dynamic> tmp;
+
+    /// The workspace for the lanes whose rows are swapped.
+    LaneMask mask;
+
+    /// Return the entries *(i, j)* of the factors in all lanes.
+    auto at(Index i, Index j)
+    {
+        return LUw.row(i*n + j).array();
+    }
+
+    /// Swap the rows *k* and *i* of a matrix with given number of columns in the lanes flagged in *mask*.
+    template<typename RowFn>
+    auto swapRows(Index k, Index i, Index cols, const RowFn& row) -> void
+    {
+        for(Index j = 0; j < cols; ++j)
+        {
+            auto rk = row(k, j);
+            auto ri = row(i, j);
+            tmp = mask.select(ri, rk);
+            ri = mask.select(rk, ri);
+            rk = tmp;
+        }
+    }
+
+    auto decompose(LaneMatrixView A) -> void
+    {
+        n = std::lround(std::sqrt(A.rows()));
+        assert(n*n == A.rows());
+
+        const auto lanes = A.cols();
+
+        LUw = A;
+        piv.resize(n, lanes);
+        singularlanes.setConstant(lanes, false);
+        best.resize(lanes);
+        ipiv.resize(lanes);
+        tmp.resize(lanes);
+        mask.resize(lanes);
+
+        for(Index k = 0; k < n; ++k)
+        {
+            // Find the row of the entry with largest magnitude in column k of each lane
+            best = at(k, k).abs();
+            ipiv.fill(k);
+            for(Index i = k + 1; i < n; ++i)
+            {
+                mask = at(i, k).abs() > best;
+                best = mask.select(at(i, k).abs(), best);
+                ipiv = mask.select(i, ipiv);
+            }
+
+            piv.row(k) = ipiv.matrix();
+            singularlanes = singularlanes || (best == 0.0);
+
+            // Swap row k with the pivot row of each lane, only in the lanes where they differ
+            for(Index i = k + 1; i < n; ++i)
+            {
+                mask = ipiv == i;
+                if(mask.any())
+                    swapRows(k, i, n, [&](Index r, Index j) { return at(r, j); });
+            }
+
+            // Eliminate the entries below the pivot in all lanes
+            for(Index i = k + 1; i < n; ++i)
+            {
+                at(i, k) /= at(k, k);
+                for(Index j = k + 1; j < n; ++j)
+                    at(i, j) -= at(i, k) * at(k, j);
+            }
+        }
+    }
+
+    auto solve(LaneMatrixRef x) -> void
+    {
+        assert(x.rows() == n && x.cols() == LUw.cols());
+
+        auto row = [&](Index i, Index) { return x.row(i).array(); };
+
+        // Apply the row swaps of each lane
+        for(Index k = 0; k < n; ++k)
+        {
+            for(Index i = k + 1; i < n; ++i)
+            {
+                mask = piv.row(k).array() == i;
+                if(mask.any())
+                    swapRows(k, i, 1, row);
+            }
+        }
+
+        // Solve L*y = P*b, with unit diagonal in L
+        for(Index i = 1; i < n; ++i)
+            for(Index j = 0; j < i; ++j)
+                x.row(i).array() -= at(i, j) * x.row(j).array();
+
+        // Solve U*x = y
+        for(Index i = n - 1; i >= 0; --i)
+        {
+            for(Index j = i + 1; j < n; ++j)
+                x.row(i).array() -= at(i, j) * x.row(j).array();
+            x.row(i).array() /= at(i, i);
+        }
+    }
+};
+
+BatchLU::BatchLU()
+: pimpl(new Impl())
+{}
+
+BatchLU::BatchLU(const BatchLU& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+BatchLU::~BatchLU()
+{}
+
+auto BatchLU::operator=(BatchLU other) -> BatchLU&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto BatchLU::decompose(LaneMatrixView A) -> void
+{
+    pimpl->decompose(A);
+}
+
+auto BatchLU::solve(LaneMatrixRef x) -> void
+{
+    pimpl->solve(x);
+}
+
+auto BatchLU::singular() const -> const LaneMask&
+{
+    return pimpl->singularlanes;
+}
+
+} // namespace Optima
@@ -0,0 +1,65 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// Used to compute the LU decompositions of many small matrices of the same dimension in lockstep.
+/// The matrices are stored in structure-of-arrays form, with one lane per matrix, so that every
+/// operation is performed on all lanes at once (and vectorized with SIMD instructions). Each lane
+/// is decomposed with its own partial pivoting, which is applied with masks across the lanes.
+class BatchLU
+{
+public:
+    /// Construct a default BatchLU object.
+    BatchLU();
+
+    /// Construct a copy of a BatchLU object.
+    BatchLU(const BatchLU& other);
+
+    /// Destroy this BatchLU object.
+    virtual ~BatchLU();
+
+    /// Assign a BatchLU object to this.
+    auto operator=(BatchLU other) -> BatchLU&;
+
+    /// Compute the LU decompositions of the matrices in the lanes of *A*.
+    /// @param A The matrices with dimension *n* by *n*, in which row `i*n + j` holds the entries *(i, j)* of all lanes.
+    auto decompose(LaneMatrixView A) -> void;
+
+    /// Solve the linear systems `A*x = b` in all lanes using the LU decompositions obtained with @ref decompose.
+    /// @param[in,out] x As input, the right-hand side vectors *b* (one row per entry). As output, the solutions *x*.
+    auto solve(LaneMatrixRef x) -> void;
+
+    /// Return the lanes whose matrix was found singular in the last decomposition (their solutions are not finite).
+    auto singular() const -> const LaneMask&;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -0,0 +1,418 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BatchLockstepSolver.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Eigen includes
+#include <Optima/deps/eigen3/Eigen/Cholesky>
+
+// Optima includes
+#include <Optima/BatchLU.hpp>
+#include <Optima/Echelonizer.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/TaskPool.hpp>
+#include <Optima/Timing.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+namespace {
+
+/// The type of the arrays with one value per lane.
+using LaneArray = Eigen::Array<double, 1, Eigen::Dynamic>;
+
+/// The type of the arrays of flags with one column per lane.
+using LaneFlags = Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/// The workspace of a worker in the lockstep solution of the problems in a chunk of lanes.
+struct LockstepWorker
+{
+    LaneMatrix x;      ///< The variables *x* in the lanes.
+    LaneMatrix y;      ///< The Lagrange multipliers *y* of the echelonized constraints in the lanes.
+    LaneMatrix xo;     ///< The variables *x* in the lanes at the start of the current iteration.
+    LaneMatrix yo;     ///< The Lagrange multipliers *y* in the lanes at the start of the current iteration.
+    LaneMatrix b;      ///< The right-hand side vectors of the echelonized constraints in the lanes.
+    LaneMatrix xlower; ///< The lower bounds of the variables *x* in the lanes.
+    LaneMatrix xupper; ///< The upper bounds of the variables *x* in the lanes.
+    LaneMatrix fx;     ///< The gradients of the objective functions in the lanes.
+    LaneMatrix fxx;    ///< The Hessians of the objective functions in the lanes.
+    LaneMatrix s;      ///< The stability measures *s = fx + Ab' y* in the lanes.
+    LaneMatrix ew;     ///< The residuals *Ab x - b* of the echelonized constraints in the lanes.
+    LaneMatrix K;      ///< The Jacobian matrices of the Newton steps in the lanes.
+    LaneMatrix d;      ///< The right-hand side vectors and then the solutions of the Newton steps in the lanes.
+    LaneFlags unstable; ///< The flags of the variables at their bounds that would move past them in the lanes.
+    LaneArray error;   ///< The residual errors in the lanes.
+    LaneArray erroro;  ///< The residual errors in the lanes at the start of the current iteration.
+    LaneArray alpha;   ///< The lengths of the steps in the lanes.
+    LaneMask active;   ///< The lanes whose problems have neither converged nor failed.
+    LaneMask trial;    ///< The lanes whose steps are still being halved.
+    LaneMask succeeded; ///< The lanes whose problems converged.
+    Indices iterations; ///< The number of iterations in the lanes.
+    BatchLU lu;        ///< The LU decompositions of the Jacobian matrices of the Newton steps in the lanes.
+    Result result;     ///< The accumulated result of the chunks solved by this worker in the current solve call.
+};
+
+/// Return the lanes in which all entries of a matrix are finite.
+auto finiteLanes(const LaneMatrix& mat) -> LaneMask
+{
+    return (mat.array() - mat.array() == 0.0).colwise().all();
+}
+
+} // namespace
+
+LockstepProblem::LockstepProblem(const Dims& dims)
+: dims(dims),
+  Aex(zeros(dims.be, dims.x)),
+  be(zeros(dims.be)),
+  xlower(constants(dims.x, -infinity())),
+  xupper(constants(dims.x, infinity()))
+{
+    error(dims.p || dims.bg || dims.he || dims.hg, "Cannot create a LockstepProblem object. "
+        "Only the dimensions of x and be can be non-zero.");
+}
+
+struct BatchLockstepSolver::Impl
+{
+    const Dims dims;                                      ///< The dimensions of the optimization problems in the batch.
+    Options options;                                      ///< The options for the optimization calculations.
+    TaskPool pool;                                        ///< The worker threads used to solve the chunks of lanes concurrently.
+    std::vector<std::unique_ptr<LockstepWorker>> workers; ///< The workers that solve the chunks of lanes (one per worker thread).
+    Index nb = 0;                                         ///< The number of linearly independent rows in *Aex*.
+    Matrix Rb;                                            ///< The echelonizer matrix of *Aex* without the rows of its dependent rows.
+    Matrix Ab;                                            ///< The matrix *Rb Aex* of the echelonized constraints.
+    Matrix Py;                                            ///< The matrix that maps the Lagrange multipliers *w* of *Aex* into those *y* of *Ab*.
+
+    Impl(const LockstepProblem& problem)
+    : dims(problem.dims)
+    {
+        setOptions(options);
+    }
+
+    Impl(const Impl& other)
+    : dims(other.dims)
+    {
+        setOptions(other.options);
+    }
+
+    auto setOptions(const Options& opts) -> void
+    {
+        error(opts.batch.lanes < 1, "Cannot set the options of BatchLockstepSolver. The number of lanes must be positive.");
+
+        options = opts;
+
+        const auto nthreads = options.batch.threads < 2 ? 0 : options.batch.threads;
+        if(pool.size() != nthreads)
+            pool = TaskPool(nthreads);
+
+        const auto nworkers = std::max<Index>(nthreads, 1);
+        if(Index(workers.size()) != nworkers)
+        {
+            workers.resize(nworkers);
+            for(auto& worker : workers)
+                if(!worker) worker = std::make_unique<LockstepWorker>();
+        }
+    }
+
+    auto solve(const LockstepProblem& problem, const BatchProblem& batch, BatchState& state) -> Result
+    {
+        const auto nx = dims.x;
+        const auto ny = dims.be;
+        const auto size = state.x.cols();
+
+        error(nx == 0, "Cannot solve the batch of optimization problems. There are no variables.");
+        error(!problem.f, "Cannot solve the batch of optimization problems. The objective function is not set.");
+        error(problem.Aex.rows() != ny || problem.Aex.cols() != nx || problem.be.size() != ny ||
+            problem.xlower.size() != nx || problem.xupper.size() != nx,
+            "Cannot solve the batch of optimization problems. "
+            "The members of LockstepProblem are not consistent with its dimensions.");
+
+        const auto checkrows = [&](const Matrix& data, Index rows, const char* name)
+        {
+            error(data.size() && (data.cols() != size || data.rows() != rows), "Cannot solve the batch of optimization problems. "
+                "The matrix BatchProblem::", name, " does not have dimensions ", rows, " by ", size, ".");
+        };
+
+        checkrows(batch.be, ny, "be");
+        checkrows(batch.xlower, nx, "xlower");
+        checkrows(batch.xupper, nx, "xupper");
+
+        error(batch.bg.size() || batch.plower.size() || batch.pupper.size(), "Cannot solve the batch of optimization problems. "
+            "The matrices BatchProblem::bg, BatchProblem::plower and BatchProblem::pupper must be empty.");
+
+        error(state.x.rows() != nx || state.w.rows() != ny || state.w.cols() != size ||
+            state.s.rows() != nx || state.s.cols() != size ||
+            state.iterations.size() != size || state.succeeded.size() != size,
+            "Cannot solve the batch of optimization problems. "
+            "The members of BatchState are not consistent with the dimensions of the problem and the number of columns in BatchState::x.");
+
+        Timer timer;
+
+        // Remove the linearly dependent rows of Aex with its echelon form, computed once for all problems
+        nb = 0;
+        if(ny > 0)
+        {
+            const Echelonizer echelonizer(problem.Aex);
+            nb = echelonizer.numBasicVariables();
+            Rb = echelonizer.R().topRows(nb);
+        }
+        else Rb.resize(0, 0);
+
+        Ab = Rb * problem.Aex;
+
+        // The least-squares solution y of Ab' y = Aex' w, used to start from given Lagrange multipliers w
+        Py = (Ab * Ab.transpose()).llt().solve(Ab * problem.Aex.transpose());
+
+        for(auto& worker : workers)
+        {
+            worker->result = Result();
+            worker->result.succeeded = true;
+        }
+
+        // Each worker takes the next unsolved chunk of lanes until there is none left
+        const Index lanes = options.batch.lanes;
+        const Index nchunks = (size + lanes - 1) / lanes;
+
+        std::atomic<Index> next(0);
+
+        for(auto& worker : workers)
+        {
+            auto& wk = *worker;
+            pool.enqueue([&] {
+                for(auto c = next++; c < nchunks; c = next++)
+                    solveChunk(wk, c * lanes, std::min(lanes, size - c * lanes), problem, batch, state);
+            });
+        }
+
+        pool.wait();
+
+        Result result;
+        result.succeeded = true;
+
+        for(auto& worker : workers)
+            result += worker->result;
+
+        result.time = timer.elapsed();
+
+        return result;
+    }
+
+    /// Solve the problems in the lanes from index *offset* in the batch in lockstep using a given worker.
+    auto solveChunk(LockstepWorker& wk, Index offset, Index lanes, const LockstepProblem& problem, const BatchProblem& batch, BatchState& state) -> void
+    {
+        const auto nx = dims.x;
+        const auto n = nx + nb;
+        const auto tolerance = options.convergence.tolerance;
+        const auto maxiterations = Index(options.maxiterations);
+
+        auto& x = wk.x;
+        auto& y = wk.y;
+        auto& s = wk.s;
+        auto& ew = wk.ew;
+        auto& d = wk.d;
+        auto& unstable = wk.unstable;
+        auto& error = wk.error;
+        auto& alpha = wk.alpha;
+        auto& active = wk.active;
+        auto& trial = wk.trial;
+
+        Result result;
+        result.succeeded = true;
+
+        const auto fail = [&](const LaneMask& lanesfailed, const char* reason)
+        {
+            if(result.succeeded && lanesfailed.any())
+            {
+                result.succeeded = false;
+                result.failure_reason = reason;
+            }
+        };
+
+        // The data of the problems in the lanes
+        if(batch.be.size()) wk.b = Rb * batch.be.middleCols(offset, lanes);
+        else wk.b = (Rb * problem.be).replicate(1, lanes);
+
+        if(batch.xlower.size()) wk.xlower = batch.xlower.middleCols(offset, lanes);
+        else wk.xlower = problem.xlower.replicate(1, lanes);
+
+        if(batch.xupper.size()) wk.xupper = batch.xupper.middleCols(offset, lanes);
+        else wk.xupper = problem.xupper.replicate(1, lanes);
+
+        x = state.x.middleCols(offset, lanes).cwiseMax(wk.xlower).cwiseMin(wk.xupper);
+        y = Py * state.w.middleCols(offset, lanes);
+
+        // Evaluate f(x) and the residual errors at (x, y) in all lanes, with infinite error in the lanes where f(x) could not be evaluated
+        const auto evaluate = [&]()
+        {
+            wk.fx.setZero(nx, lanes);
+            wk.fxx.setZero(nx*nx, lanes);
+            problem.f(x, offset, wk.fx, wk.fxx);
+            result.num_objective_evals += lanes;
+
+            s.noalias() = wk.fx + Ab.transpose() * y;
+            ew.noalias() = Ab * x - wk.b;
+
+            unstable = (x.array() == wk.xlower.array() && s.array() > 0.0) ||
+                       (x.array() == wk.xupper.array() && s.array() < 0.0);
+
+            error = unstable.select(0.0, s.array().abs()).colwise().maxCoeff();
+            if(nb > 0)
+                error = error.max(ew.array().abs().colwise().maxCoeff());
+
+            const LaneMask finite = finiteLanes(s) && finiteLanes(ew) && finiteLanes(wk.fxx);
+            error = finite.select(error, infinity());
+        };
+
+        // Set (x, y) to the step of given lengths from (xo, yo) in the lanes flagged in trial
+        const auto step = [&]()
+        {
+            for(Index i = 0; i < nx; ++i)
+                x.row(i).array() = trial.select((wk.xo.row(i).array() + alpha * d.row(i).array())
+                    .max(wk.xlower.row(i).array()).min(wk.xupper.row(i).array()), x.row(i).array());
+            for(Index k = 0; k < nb; ++k)
+                y.row(k).array() = trial.select(wk.yo.row(k).array() + alpha * d.row(nx + k).array(), y.row(k).array());
+        };
+
+        // The rows of the Jacobian matrices for the constraints, which are the same in all lanes and iterations
+        wk.K.setZero(n*n, lanes);
+        for(Index k = 0; k < nb; ++k)
+            for(Index i = 0; i < nx; ++i)
+                wk.K.row((nx + k)*n + i).setConstant(Ab(k, i));
+
+        active.setConstant(lanes, true);
+        wk.succeeded.setConstant(lanes, false);
+        wk.iterations.setZero(lanes);
+
+        evaluate();
+
+        while(true)
+        {
+            // Mask off the lanes whose problems converged or failed
+            const LaneMask converged = active && error < tolerance;
+            const LaneMask notevaluated = active && !(error < infinity());
+            wk.succeeded = wk.succeeded || converged;
+            active = active && !converged && !notevaluated;
+            fail(notevaluated, "The objective function could not be evaluated.");
+
+            const LaneMask exhausted = active && wk.iterations.transpose().array() == maxiterations;
+            active = active && !exhausted;
+            fail(exhausted, "The maximum number of iterations has been reached.");
+
+            if(!active.any())
+                break;
+
+            // The Newton steps for the stable variables and y, with the unstable variables kept at their bounds
+            for(Index i = 0; i < nx; ++i)
+            {
+                const auto ui = unstable.row(i);
+                for(Index j = 0; j < nx; ++j)
+                    wk.K.row(i*n + j).array() = ui.select(i == j ? 1.0 : 0.0, wk.fxx.row(i*nx + j).array());
+                for(Index k = 0; k < nb; ++k)
+                    wk.K.row(i*n + nx + k).array() = (!ui).cast<double>() * Ab(k, i);
+            }
+
+            d.resize(n, lanes);
+            d.topRows(nx) = unstable.select(0.0, -s.array()).matrix();
+            d.bottomRows(nb) = -ew;
+
+            wk.lu.decompose(wk.K);
+            wk.lu.solve(d);
+            result.num_linear_decompositions += lanes;
+
+            const LaneMask singular = active && (wk.lu.singular() || !finiteLanes(d));
+            active = active && !singular;
+            fail(singular, "The Jacobian matrix of the Newton step is singular.");
+
+            if(!active.any())
+                break;
+
+            wk.xo = x;
+            wk.yo = y;
+            wk.erroro = error;
+
+            // Halve the steps while the errors do not decrease, and take the
+            // Newton steps as they are in the lanes where this fails (see TinySolver)
+            alpha.setOnes(lanes);
+            trial = active;
+            while(true)
+            {
+                step();
+                evaluate();
+                trial = trial && !(error < wk.erroro || alpha < 1e-3);
+                if(!trial.any())
+                    break;
+                alpha = trial.select(0.5 * alpha, alpha);
+            }
+
+            trial = active && !(error < wk.erroro) && alpha != 1.0;
+            if(trial.any())
+            {
+                alpha.setOnes(lanes);
+                step();
+                evaluate();
+            }
+
+            wk.iterations += active.transpose().cast<Index>().matrix();
+        }
+
+        state.x.middleCols(offset, lanes) = x;
+        state.w.middleCols(offset, lanes) = Rb.transpose() * y;
+        state.s.middleCols(offset, lanes) = s;
+        state.iterations.segment(offset, lanes) = wk.iterations;
+        state.succeeded.segment(offset, lanes) = wk.succeeded.transpose().cast<Index>().matrix();
+
+        result.iterations = wk.iterations.sum();
+        result.error = error.maxCoeff();
+
+        wk.result += result;
+    }
+};
+
+BatchLockstepSolver::BatchLockstepSolver(const LockstepProblem& problem)
+: pimpl(new Impl(problem))
+{}
+
+BatchLockstepSolver::BatchLockstepSolver(const BatchLockstepSolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+BatchLockstepSolver::~BatchLockstepSolver()
+{}
+
+auto BatchLockstepSolver::operator=(BatchLockstepSolver other) -> BatchLockstepSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto BatchLockstepSolver::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto BatchLockstepSolver::solve(const LockstepProblem& problem, const BatchProblem& batch, BatchState& state) -> Result
+{
+    return pimpl->solve(problem, batch, state);
+}
+
+} // namespace Optima
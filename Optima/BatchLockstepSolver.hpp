@@ -0,0 +1,111 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <functional>
+#include <memory>
+
+// Optima includes
+#include <Optima/BatchSolver.hpp>
+#include <Optima/Dims.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Options;
+class Result;
+
+/// The objective function of many optimization problems evaluated in lockstep, one problem per lane.
+/// @param x The variables of the problems, in which row *i* holds *x[i]* of all lanes.
+/// @param offset The index in the batch of the problem in the first lane (e.g., to look up the temperature and pressure of its cell).
+/// @param fx The output gradients, in which row *i* holds *fx[i]* of all lanes (zero on input).
+/// @param fxx The output Hessians, in which row `i*nx + j` holds *fxx(i, j)* of all lanes (zero on input).
+/// The lanes in which the evaluation fails should be set to a non-finite value in *fx*.
+using LockstepObjectiveFunction = std::function<void(LaneMatrixView x, Index offset, LaneMatrixRef fx, LaneMatrixRef fxx)>;
+
+/// The data common to the optimization problems solved in lockstep with BatchLockstepSolver.
+/// The problems are to minimize *f(x)* subject to *Aex x = be* and *xlower <= x <= xupper*.
+struct LockstepProblem
+{
+    /// The dimensions of the optimization problems (only *x* and *be* can be non-zero).
+    const Dims dims;
+
+    /// The coefficient matrix of the linear equality constraints.
+    Matrix Aex;
+
+    /// The right-hand side vector of the linear equality constraints.
+    Vector be;
+
+    /// The lower bounds of the variables *x*.
+    Vector xlower;
+
+    /// The upper bounds of the variables *x*.
+    Vector xupper;
+
+    /// The objective function evaluated in all lanes at once.
+    LockstepObjectiveFunction f;
+
+    /// Construct a LockstepProblem object with given dimensions.
+    LockstepProblem(const Dims& dims);
+};
+
+/// Used to solve a batch of tiny optimization problems with the same structure in lockstep.
+/// Unlike BatchSolver, which solves one problem at a time in each worker thread, this advances
+/// Options::batch.lanes problems at once, with their data in structure-of-arrays form (one lane
+/// per problem), so that the evaluation of the objective function, the assembly of the residuals
+/// and the Newton matrices and their LU decompositions (see BatchLU) are vectorized across the
+/// problems. This uses the Newton method of TinySolver: the variables at their bounds that would
+/// move past them are kept fixed, with the partition determined in each lane, and steps that do
+/// not decrease the error are halved. The lanes are masked off as their problems converge or fail.
+/// The problems differ only in BatchProblem::be, BatchProblem::xlower and BatchProblem::xupper.
+class BatchLockstepSolver
+{
+public:
+    /// Construct a BatchLockstepSolver instance with given optimization problem.
+    BatchLockstepSolver(const LockstepProblem& problem);
+
+    /// Construct a copy of a BatchLockstepSolver instance.
+    BatchLockstepSolver(const BatchLockstepSolver& other);
+
+    /// Destroy this BatchLockstepSolver instance.
+    virtual ~BatchLockstepSolver();
+
+    /// Assign a BatchLockstepSolver instance to this.
+    auto operator=(BatchLockstepSolver other) -> BatchLockstepSolver&;
+
+    /// Set the options for the optimization calculations (only Options::maxiterations,
+    /// Options::convergence.tolerance and Options::batch are used).
+    auto setOptions(const Options& options) -> void;
+
+    /// Solve the optimization problems in a batch.
+    /// @param problem The optimization problem with the data common to all problems.
+    /// @param batch The data of each problem in the batch.
+    /// @param state The initial guesses and, on exit, the solutions of the problems.
+    /// @return The accumulated result, which is successful only if every problem converged.
+    auto solve(const LockstepProblem& problem, const BatchProblem& batch, BatchState& state) -> Result;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -0,0 +1,41 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/Index.hpp>
+
+namespace Optima {
+
+/// Used to organize the options for the solution of a batch of optimization problems with BatchSolver or BatchLockstepSolver.
+struct BatchOptions
+{
+    /// The number of worker threads used to solve the problems in a batch concurrently.
+    /// Each worker thread has its own solver and takes the next unsolved problem when it
+    /// finishes one, so that problems that take many iterations do not hold back the
+    /// others. The problems are solved sequentially if this is less than two. Enable this
+    /// only if the objective and constraint functions can safely be evaluated at the same time.
+    Index threads = 0;
+
+    /// The number of problems advanced in lockstep by BatchLockstepSolver, in which each worker
+    /// thread takes the next chunk of this many problems. This should be a multiple of the number
+    /// of values of type double in a SIMD register (e.g., 4 with AVX2 and 8 with AVX-512).
+    Index lanes = 8;
+};
+
+} // namespace Optima
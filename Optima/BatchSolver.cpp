@@ -0,0 +1,228 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "BatchSolver.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+#include <Optima/TaskPool.hpp>
+#include <Optima/Timing.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+namespace {
+
+/// The solver and the workspace of a worker in the solution of a batch of optimization problems.
+struct BatchWorker
+{
+    Solver solver;                    ///< The solver of the problems assigned to this worker.
+    State state;                      ///< The state of the problem being solved by this worker.
+    std::unique_ptr<Problem> problem; ///< The copy of the optimization problem used by this worker (created in each solve call).
+    Result result;                    ///< The accumulated result of the problems solved by this worker in the current solve call.
+
+    /// Construct a BatchWorker object for optimization problems with given dimensions.
+    BatchWorker(const Problem& problem)
+    : solver(problem), state(problem.dims) {}
+};
+
+} // namespace
+
+BatchState::BatchState(const Dims& dims, Index size)
+: x(zeros(dims.x, size)),
+  p(zeros(dims.p, size)),
+  w(zeros(dims.be + dims.bg + dims.he + dims.hg, size)),
+  s(zeros(dims.x, size)),
+  xbg(zeros(dims.bg, size)),
+  xhg(zeros(dims.hg, size)),
+  iterations(Indices::Zero(size)),
+  succeeded(Indices::Zero(size))
+{}
+
+struct BatchSolver::Impl
+{
+    const Dims dims;                                  ///< The dimensions of the optimization problems in the batch.
+    Options options;                                  ///< The options for the optimization calculations.
+    TaskPool pool;                                    ///< The worker threads used to solve the problems concurrently.
+    std::vector<std::unique_ptr<BatchWorker>> workers; ///< The workers that solve the problems (one per worker thread).
+
+    Impl(const Problem& problem)
+    : dims(problem.dims)
+    {
+        setOptions(options);
+    }
+
+    Impl(const Impl& other)
+    : dims(other.dims)
+    {
+        setOptions(other.options);
+    }
+
+    auto setOptions(const Options& opts) -> void
+    {
+        options = opts;
+
+        const auto nthreads = options.batch.threads < 2 ? 0 : options.batch.threads;
+        if(pool.size() != nthreads)
+            pool = TaskPool(nthreads);
+
+        const auto nworkers = std::max<Index>(nthreads, 1);
+        if(Index(workers.size()) != nworkers)
+        {
+            const Problem problem(dims); // only its dimensions are used to construct the solvers
+            workers.resize(nworkers);
+            for(auto& worker : workers)
+                if(!worker) worker = std::make_unique<BatchWorker>(problem);
+        }
+
+        for(auto& worker : workers)
+            worker->solver.setOptions(options);
+    }
+
+    auto solve(const Problem& problem, const BatchProblem& batch, const Setup& setup, BatchState& state) -> Result
+    {
+        const auto size = state.x.cols();
+
+        const auto checkcols = [&](const Matrix& data, const char* name)
+        {
+            error(data.size() && data.cols() != size, "Cannot solve the batch of optimization problems. "
+                "The number of columns in BatchProblem::", name, " (", data.cols(), ") is not the number of problems (", size, ").");
+        };
+
+        checkcols(batch.be, "be");
+        checkcols(batch.bg, "bg");
+        checkcols(batch.xlower, "xlower");
+        checkcols(batch.xupper, "xupper");
+        checkcols(batch.plower, "plower");
+        checkcols(batch.pupper, "pupper");
+
+        error(state.p.cols() != size || state.w.cols() != size || state.s.cols() != size ||
+            state.xbg.cols() != size || state.xhg.cols() != size ||
+            state.iterations.size() != size || state.succeeded.size() != size,
+            "Cannot solve the batch of optimization problems. "
+            "The members of BatchState are not consistent with the number of columns in BatchState::x.");
+
+        Timer timer;
+
+        for(auto& worker : workers)
+        {
+            worker->problem = std::make_unique<Problem>(problem);
+            worker->result = Result();
+            worker->result.succeeded = true;
+        }
+
+        // Each worker takes the next unsolved problem until there is none left
+        std::atomic<Index> next(0);
+
+        for(auto& worker : workers)
+        {
+            auto& wk = *worker;
+            pool.enqueue([&] { for(auto i = next++; i < size; i = next++) solveOne(wk, i, batch, setup, state); });
+        }
+
+        pool.wait();
+
+        Result result;
+        result.succeeded = true;
+
+        for(auto& worker : workers)
+            result += worker->result;
+
+        result.time = timer.elapsed();
+
+        return result;
+    }
+
+    /// Solve the problem with given index in the batch using a given worker.
+    auto solveOne(BatchWorker& wk, Index i, const BatchProblem& batch, const Setup& setup, BatchState& state) -> void
+    {
+        auto& problem = *wk.problem;
+        auto& st = wk.state;
+
+        if(batch.be.size()) problem.be = batch.be.col(i);
+        if(batch.bg.size()) problem.bg = batch.bg.col(i);
+        if(batch.xlower.size()) problem.xlower = batch.xlower.col(i);
+        if(batch.xupper.size()) problem.xupper = batch.xupper.col(i);
+        if(batch.plower.size()) problem.plower = batch.plower.col(i);
+        if(batch.pupper.size()) problem.pupper = batch.pupper.col(i);
+
+        if(setup)
+            setup(problem, i);
+
+        st.x = state.x.col(i);
+        st.p = state.p.col(i);
+        st.w = state.w.col(i);
+        st.xbg = state.xbg.col(i);
+        st.xhg = state.xhg.col(i);
+
+        const auto res = wk.solver.solve(problem, st);
+
+        state.x.col(i) = st.x;
+        state.p.col(i) = st.p;
+        state.w.col(i) = st.w;
+        state.s.col(i) = st.s;
+        state.xbg.col(i) = st.xbg;
+        state.xhg.col(i) = st.xhg;
+        state.iterations[i] = res.iterations;
+        state.succeeded[i] = res.succeeded;
+
+        wk.result += res;
+    }
+};
+
+BatchSolver::BatchSolver(const Problem& problem)
+: pimpl(new Impl(problem))
+{}
+
+BatchSolver::BatchSolver(const BatchSolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+BatchSolver::~BatchSolver()
+{}
+
+auto BatchSolver::operator=(BatchSolver other) -> BatchSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto BatchSolver::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto BatchSolver::solve(const Problem& problem, const BatchProblem& batch, BatchState& state) -> Result
+{
+    return pimpl->solve(problem, batch, {}, state);
+}
+
+auto BatchSolver::solve(const Problem& problem, const BatchProblem& batch, const Setup& setup, BatchState& state) -> Result
+{
+    return pimpl->solve(problem, batch, setup, state);
+}
+
+} // namespace Optima
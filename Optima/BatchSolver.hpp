@@ -0,0 +1,140 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <functional>
+#include <memory>
+
+// Optima includes
+#include <Optima/Dims.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Options;
+class Problem;
+class Result;
+
+/// The data that differ between the optimization problems in a batch, with one column per problem.
+/// An empty matrix indicates that the corresponding data in Problem is used for every problem.
+struct BatchProblem
+{
+    /// The right-hand side vectors *be* of the linear equality constraints.
+    Matrix be;
+
+    /// The right-hand side vectors *bg* of the linear inequality constraints.
+    Matrix bg;
+
+    /// The lower bounds of the variables *x*.
+    Matrix xlower;
+
+    /// The upper bounds of the variables *x*.
+    Matrix xupper;
+
+    /// The lower bounds of the variables *p*.
+    Matrix plower;
+
+    /// The upper bounds of the variables *p*.
+    Matrix pupper;
+};
+
+/// The states of the optimization problems in a batch, with one column (or entry) per problem.
+/// On input, the columns are the initial guesses of the problems. On output, they are their solutions.
+struct BatchState
+{
+    /// The variables *x* of the problems.
+    Matrix x;
+
+    /// The parameter variables *p* of the problems.
+    Matrix p;
+
+    /// The Lagrange multipliers *w = (ye, yg, ze, zg)* of the problems.
+    Matrix w;
+
+    /// The stability measures *s* of the variables *x* of the problems.
+    Matrix s;
+
+    /// The variables *xbg* of the basic optimization problems.
+    Matrix xbg;
+
+    /// The variables *xhg* of the basic optimization problems.
+    Matrix xhg;
+
+    /// The number of iterations in the solution of each problem.
+    Indices iterations;
+
+    /// The flag (1 or 0) that indicates if the solution of each problem converged.
+    Indices succeeded;
+
+    /// Construct a BatchState object for a batch of problems with given dimensions.
+    /// @param dims The dimensions of the optimization problems.
+    /// @param size The number of problems in the batch.
+    BatchState(const Dims& dims, Index size);
+};
+
+/// Used to solve a batch of optimization problems with the same structure (e.g., one in each cell of a mesh).
+/// The problems in the batch share the same dimensions, the matrices *Aex*, *Aep*, *Agx*, *Agp* and the
+/// objective and constraint functions. They differ in the data in BatchProblem and in an optional set-up
+/// step of each problem (e.g., to set the temperature and pressure used in the functions of a cell).
+class BatchSolver
+{
+public:
+    /// The function that prepares the problem with given index in the batch before its solution.
+    /// The given problem is a copy of the original one owned by the worker that solves the problem.
+    using Setup = std::function<void(Problem& problem, Index i)>;
+
+    /// Construct a BatchSolver instance with given optimization problem.
+    BatchSolver(const Problem& problem);
+
+    /// Construct a copy of a BatchSolver instance.
+    BatchSolver(const BatchSolver& other);
+
+    /// Destroy this BatchSolver instance.
+    virtual ~BatchSolver();
+
+    /// Assign a BatchSolver instance to this.
+    auto operator=(BatchSolver other) -> BatchSolver&;
+
+    /// Set the options for the optimization calculations.
+    auto setOptions(const Options& options) -> void;
+
+    /// Solve the optimization problems in a batch.
+    /// @param problem The optimization problem with the data common to all problems.
+    /// @param batch The data of each problem in the batch.
+    /// @param state The initial guesses and, on exit, the solutions of the problems.
+    /// @return The accumulated result, which is successful only if every problem converged.
+    auto solve(const Problem& problem, const BatchProblem& batch, BatchState& state) -> Result;
+
+    /// Solve the optimization problems in a batch, with each problem prepared by a set-up function.
+    /// @param problem The optimization problem with the data common to all problems.
+    /// @param batch The data of each problem in the batch.
+    /// @param setup The function that prepares each problem after the data in *batch* is set.
+    /// @param state The initial guesses and, on exit, the solutions of the problems.
+    /// @return The accumulated result, which is successful only if every problem converged.
+    auto solve(const Problem& problem, const BatchProblem& batch, const Setup& setup, BatchState& state) -> Result;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -0,0 +1,41 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "CancellationToken.hpp"
+
+namespace Optima {
+
+CancellationToken::CancellationToken()
+: flag(std::make_shared<std::atomic<bool>>(false))
+{}
+
+auto CancellationToken::cancel() -> void
+{
+    flag->store(true);
+}
+
+auto CancellationToken::cancelled() const -> bool
+{
+    return flag->load(std::memory_order_relaxed);
+}
+
+auto CancellationToken::reset() -> void
+{
+    flag->store(false);
+}
+
+} // namespace Optima
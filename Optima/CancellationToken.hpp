@@ -0,0 +1,49 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <atomic>
+#include <memory>
+
+namespace Optima {
+
+/// Used to request the interruption of optimization calculations from another thread.
+/// Copies of a CancellationToken object share the same state, so that a token set in
+/// Options (and thus copied into the solvers) can be cancelled through the original one.
+class CancellationToken
+{
+public:
+    /// Construct a CancellationToken object that has not been cancelled.
+    CancellationToken();
+
+    /// Request the interruption of the optimization calculations using this token.
+    auto cancel() -> void;
+
+    /// Return true if the interruption of the optimization calculations has been requested.
+    auto cancelled() const -> bool;
+
+    /// Withdraw the request for interruption so that this token can be used again.
+    auto reset() -> void;
+
+private:
+    /// The flag shared among the copies of this token.
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+} // namespace Optima
@@ -24,9 +24,21 @@
 #include <Optima/CanonicalDims.hpp>
 #include <Optima/MasterDims.hpp>
 #include <Optima/MasterMatrix.hpp>
+#include <Optima/Utils.hpp>
 
 namespace Optima {
 
+/// Used to represent the structure of the blocks in the canonical form of a master matrix.
+struct CanonicalStructure
+{
+    MatrixStructure Hss   = MatrixStructure::Dense; ///< The structure of matrix Hss in the canonical master matrix.
+    MatrixStructure Hsp   = MatrixStructure::Dense; ///< The structure of matrix Hsp in the canonical master matrix.
+    MatrixStructure Vps   = MatrixStructure::Dense; ///< The structure of matrix Vps in the canonical master matrix.
+    MatrixStructure Vpp   = MatrixStructure::Dense; ///< The structure of matrix Vpp in the canonical master matrix.
+    MatrixStructure Sbsns = MatrixStructure::Dense; ///< The structure of matrix Sbsns in the canonical master matrix.
+    MatrixStructure Sbsp  = MatrixStructure::Dense; ///< The structure of matrix Sbsp in the canonical master matrix.
+};
+
 /// Used to represent the canonical form of a master matrix.
 struct CanonicalMatrix
 {
@@ -42,6 +54,7 @@ struct CanonicalMatrix
     IndicesView jn;     ///< The indices of the non-basic variables ordered as jn = (jns, jnu).
     IndicesView js;     ///< The indices of the stable variables ordered as js = (jbs, jns).
     IndicesView ju;     ///< The indices of the unstable variables ordered as ju = (jbu, jnu).
+    CanonicalStructure structure; ///< The structure of the blocks Hss, Hsp, Vps, Vpp, Sbsns, Sbsp (zero, diagonal or dense).
 };
 
 } // namespace Optima
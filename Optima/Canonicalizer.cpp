@@ -17,6 +17,9 @@
 
 #include "Canonicalizer.hpp"
 
+// C++ includes
+#include <algorithm>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/IndexUtils.hpp>
@@ -34,8 +37,8 @@ struct Canonicalizer::Impl
     Index nn = 0;       ///< The number of non-basic variables.
     Index nl = 0;       ///< The number of linearly dependent rows in Wx = [Ax; Jx].
 
-    Matrix R;           ///< The matrix R in RWQ = [Ibb Sbn Sbp].
-    Matrix S;           ///< The matrix S' = [Sbsns Sbsnu Sbsp; 0 Sbunu Sbup].
+    Matrix R;           ///< The matrix Rbs in R = [Rbs; 0] gathered from the echelonizer matrix of W.
+    Matrix S;           ///< The matrix S' = [Sbsns Sbsp] gathered from the echelon form of W.
     Indices jbn;        ///< The order of x variables as x = (xb, xn) = (xbs, xbu, xns, xnu) = (xbe, xbi, xbu, xne, xni, xnu).
 
     Index nbs = 0;      ///< The number of basic stable variables.
@@ -49,28 +52,80 @@ struct Canonicalizer::Impl
     Index nni = 0;      ///< The number of implicit non-basic stable variables.
 
     Indices bs;         ///< The boolean flags that indicate which variables in x are stable.
-    Indices Kb;         ///< The permutation matrix used to order the basic variables as xb = (xbe, xbi, xbu) with `e` and `i` denoting pivot and non-pivot.
-    Indices Kn;         ///< The permutation matrix used to order the non-basic variables as xn = (xne, xni, xnu) with `e` and `i` denoting pivot and non-pivot.
+    Indices Kb;         ///< The index map used to order the basic variables as xb = (xbe, xbi, xbu) with `e` and `i` denoting pivot and non-pivot (only its first `nb` entries).
+    Indices Kn;         ///< The index map used to order the non-basic variables as xn = (xne, xni, xnu) with `e` and `i` denoting pivot and non-pivot (only its first `nn` entries).
+
+    Indices jbnprev;    ///< The indices of the basic and non-basic variables in the previous update (in the order of the echelon form of W).
+    Indices juprev;     ///< The indices of the unstable variables in the previous update (only its first `nuprev` entries).
+    Index nbprev = -1;  ///< The number of basic variables in the previous update (or -1 if there was no previous update).
+    Index nuprev = -1;  ///< The number of unstable variables in the previous update (or -1 if there was no previous update).
+    Index revisionprev = -1; ///< The identifier of the echelon form of W in the previous update (or -1 if unknown).
 
     Indices jsu;        ///< The order of x variables as x = (xs, xu) = (xbs, xns, xbu, xnu) = (xbe, xbi, xne, xni, xbu, xnu).
 
     Matrix Hprime;      ///< The matrix H' = [Hss Hsp].
-    Matrix Vprime;      ///< The matrix V' = [Vps Vpu Vpp].
-    Matrix Wprime;      ///< The matrix W' = [Ws Wu Wp] = [As Au Ap; Js Ju Jp].
+    Matrix Vprime;      ///< The matrix V' = [Vps Vpp].
+
+    CanonicalStructure structure; ///< The structure of the blocks Hss, Hsp, Vps, Vpp, Sbsns, Sbsp in the canonical form.
 
     bool diagHxx = false; ///< The flag indicating whether Hxx is diagonal.
+    bool diagHss = false; ///< The flag indicating whether the off-diagonal entries of Hss in H' are currently zero.
+
+    bool orderbyindex = false; ///< The flag indicating whether the explicit and implicit stable variables are ordered by their indices.
 
     Impl(const MasterDims& dims)
     : dims(dims)
     {
         const auto [nx, np, ny, nz, nw, nt] = dims;
 
+        R = zeros(nw, nw);
         S = zeros(nw, nx + np);
         Hprime = zeros(nx, nx + np);
         Vprime = zeros(np, nx + np);
-        Wprime = zeros(nw, nx + np);
         jbn.resize(nx);
         jsu.resize(nx);
+        Kb.resize(nx);
+        Kn.resize(nx);
+        bs.resize(nx);
+        jbnprev.resize(nx);
+        juprev.resize(nx);
+    }
+
+    /// Assign another Canonicalizer::Impl object to this reusing its memory.
+    auto assign(const Impl& other) -> void
+    {
+        assert(dims.nx == other.dims.nx && dims.np == other.dims.np && dims.nw == other.dims.nw);
+        ns = other.ns;
+        nu = other.nu;
+        nb = other.nb;
+        nn = other.nn;
+        nl = other.nl;
+        R = other.R;
+        S = other.S;
+        jbn = other.jbn;
+        nbs = other.nbs;
+        nbu = other.nbu;
+        nns = other.nns;
+        nnu = other.nnu;
+        nbe = other.nbe;
+        nbi = other.nbi;
+        nne = other.nne;
+        nni = other.nni;
+        bs = other.bs;
+        Kb = other.Kb;
+        Kn = other.Kn;
+        jbnprev = other.jbnprev;
+        juprev = other.juprev;
+        nbprev = other.nbprev;
+        nuprev = other.nuprev;
+        revisionprev = other.revisionprev;
+        jsu = other.jsu;
+        Hprime = other.Hprime;
+        Vprime = other.Vprime;
+        structure = other.structure;
+        diagHxx = other.diagHxx;
+        diagHss = other.diagHss;
+        orderbyindex = other.orderbyindex;
     }
 
     Impl(const MasterMatrix& M)
@@ -79,13 +134,20 @@ struct Canonicalizer::Impl
         update(M);
     }
 
+    /// Return true if the basic, non-basic and unstable variables are the same as in the previous update.
+    auto isPartitionUnchanged(IndicesView jb, IndicesView jn, IndicesView ju) const -> bool
+    {
+        return jb.size() == nbprev && jb == jbnprev.head(nbprev) &&
+               jn == jbnprev.tail(jn.size()) &&
+               ju.size() == nuprev && ju == juprev.head(nuprev);
+    }
+
     auto update(const MasterMatrix& M) -> void
     {
         const auto [nx, np, ny, nz, nw, nt] = dims;
 
         const auto H   = M.H;
         const auto V   = M.V;
-        const auto W   = M.W;
         const auto RWQ = M.RWQ;
         const auto ju0 = M.ju;
 
@@ -100,55 +162,58 @@ struct Canonicalizer::Impl
         nn = RWQ.jn.size();
         nl = nw - nb;
 
-        //======================================================================
-        // Initialize matrices R, Sbn, Sbp and indices of variables jbn
-        //======================================================================
-
-        auto Sbn = S.topLeftCorner(nb, nn);
-        auto Sbp = S.topRightCorner(nb, np);
-
-        R = RWQ.R;
-
-        Sbn = RWQ.Sbn;
-        Sbp = RWQ.Sbp;
-
-        jbn << RWQ.jb, RWQ.jn; // the indices of the variables ordered as x = (xb, xn), but xb and xn not yet properly sorted
-
-        auto jb = jbn.head(nb); // the indices of the basic variables
-        auto jn = jbn.tail(nn); // the indices of the non-basic variables
+        // The views to the matrices in RWQ = [Ibb Sbn Sbp], which are never
+        // copied nor permuted here. Instead, index maps Kb and Kn are computed
+        // below and only the needed blocks are gathered with them.
+        const auto Sbn = RWQ.Sbn;
+        const auto Sbp = RWQ.Sbp;
+        const auto jb0 = RWQ.jb;
+        const auto jn0 = RWQ.jn;
 
         //======================================================================
-        // Initialize permutation matrices Kb and Kn so that
-        // basic and non-basic variables can later be ordered as:
+        // Initialize index maps Kb and Kn so that basic and non-basic
+        // variables can later be ordered as:
         //     xb = (xbs, xbu) = (xbe, xbi, xbu)
         //     xn = (xns, xnu) = (xne, xni, xnu)
+        //----------------------------------------------------------------------
+        // Note: The partition into stable and unstable variables is reused if
+        // jb, jn and ju have not changed since the previous update.
         //======================================================================
 
-        Kb = indices(nb);
-        Kn = indices(nn);
+        const auto samepartition = isPartitionUnchanged(jb0, jn0, ju0);
 
-        bs.setOnes(nx); // 1 for stable, 0 for unstable
-        bs(ju0).fill(0);
+        if(!samepartition)
+        {
+            Kb.head(nb) = indices(nb);
+            Kn.head(nn) = indices(nn);
 
-        const auto Hd = H.Hxx.diagonal(); // the diagonal entries in Hxx used to sort the variables
+            bs.fill(1); // 1 for stable, 0 for unstable
+            bs(ju0).fill(0);
 
-        using std::abs;
-        using std::sort;
+            auto jb_kth_is_stable = [&](auto i) { return bs[jb0[i]]; }; // returts true if k-th basic variable is stable
+            auto jn_kth_is_stable = [&](auto i) { return bs[jn0[i]]; }; // returts true if k-th non-basic variable is stable
 
-        auto jb_kth_is_stable = [&](auto i) { return bs[jb[i]]; }; // returts true if k-th basic variable is stable
-        auto jn_kth_is_stable = [&](auto i) { return bs[jn[i]]; }; // returts true if k-th non-basic variable is stable
+            // Partition Kb = (Kbs, Kbu) and Kn = (Kns, Knu)
+            nbs = moveLeftIf(Kb.head(nb), jb_kth_is_stable); // as a result, update the number of basic stable variables
+            nns = moveLeftIf(Kn.head(nn), jn_kth_is_stable); // as a result, update the number of non-basic stable variables
 
-        // Partition Kb = (Kbs, Kbu) and Kn = (Kns, Knu)
-        nbs = moveLeftIf(Kb, jb_kth_is_stable); // as a result, update the number of basic stable variables
-        nns = moveLeftIf(Kn, jn_kth_is_stable); // as a result, update the number of non-basic stable variables
+            nbu = nb - nbs; // update the number of basic unstable variables
+            nnu = nn - nns; // update the number of non-basic unstable variables
 
-        nbu = nb - nbs; // update the number of basic unstable variables
-        nnu = nn - nns; // update the number of non-basic unstable variables
+            jbnprev << jb0, jn0;
+            juprev.head(nu) = ju0;
+            nbprev = nb;
+            nuprev = nu;
+        }
 
         // Ensure no basic variable has been marked as unstable.
         error(nbu > 0, "Canonicalizer::update failed with given indices of "
             "unstable variables, which contain indices of basic variables.");
 
+        const auto Hd = H.Hxx.diagonal(); // the diagonal entries in Hxx used to sort the variables
+
+        using std::abs;
+
         // Partition Kbs = (Kbe, Kbi) and Kns = (Kne, Kni)
         auto Kbs = Kb.head(nbs);
         auto Kns = Kn.head(nns);
@@ -156,7 +221,7 @@ struct Canonicalizer::Impl
         // Return true if the k-th stable basic variable is a pivot/explicit variable
         auto jbs_kth_is_explicit = [&](auto k)
         {
-            const auto idx = jb[k];                     // the global index of the k-th basic variable
+            const auto idx = jb0[k];                    // the global index of the k-th basic variable
             const auto Hkk = Hd[idx];                   // the corresponding diagonal entry in the H matrix
             const auto a1 = 1.0;                        // the max value along the corresponding column of the identity matrix
             const auto a2 = norminf(V.Vpx.col(idx));    // the max value along the corresponding column of the Vpx matrix
@@ -166,7 +231,7 @@ struct Canonicalizer::Impl
         // Return true if the k-th stable non-basic variable is a pivot/explicit variable
         auto jns_kth_is_explicit = [&](auto k)
         {
-            const auto idx = jn[k];                     // the global index of the k-th non-basic variable
+            const auto idx = jn0[k];                    // the global index of the k-th non-basic variable
             const auto Hkk = Hd[idx];                   // the corresponding diagonal entry in the H matrix
             const auto a1 = norminf(Sbn.col(k));        // the max value along the corresponding column of the Sbn matrix
             const auto a2 = norminf(V.Vpx.col(idx));    // the max value along the corresponding column of the Vpx matrix
@@ -180,26 +245,47 @@ struct Canonicalizer::Impl
         nbi = nbs - nbe;
         nni = nns - nne;
 
+        // Order the stable variables in Kbe, Kbi, Kne and Kni by their indices if
+        // requested, since the order of jb and jn in the echelon form changes with
+        // the priority weights even if the basic variables do not. The canonical
+        // form then depends only on the partition of the variables.
+        if(orderbyindex)
+        {
+            auto bybasicindex = [&](Index a, Index b) { return jb0[a] < jb0[b]; };
+            auto bynonbasicindex = [&](Index a, Index b) { return jn0[a] < jn0[b]; };
+            std::sort(Kbs.begin(), Kbs.begin() + nbe, bybasicindex);
+            std::sort(Kbs.begin() + nbe, Kbs.end(), bybasicindex);
+            std::sort(Kns.begin(), Kns.begin() + nne, bynonbasicindex);
+            std::sort(Kns.begin() + nne, Kns.end(), bynonbasicindex);
+        }
+
         //======================================================================
-        // Apply permutation to R, Sbn, Sbp and indices of variables jbn
+        // Order the indices of variables jbn using the index maps Kb and Kn
+        //----------------------------------------------------------------------
+        // Note: Kb and Kn are used through views below, since Eigen copies
+        // (and thus allocates) plain index vectors stored in indexed views.
         //======================================================================
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Sbn);
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Sbp);
+        auto jb = jbn.head(nb);
+        auto jn = jbn.tail(nn);
 
-        Kn.asPermutation().applyThisOnTheRight(Sbn);
+        jb = jb0(Kb.head(nb)); // jb is now ordered as (jbs, jbu) = (jbe, jbi, jbu)
+        jn = jn0(Kn.head(nn)); // jn is now ordered as (jns, jnu) = (jne, jni, jnu)
 
-        Kb.asPermutation().transpose().applyThisOnTheLeft(R);
+        //======================================================================
+        // Gather matrices Rbs, Sbsns and Sbsp using the index maps Kbs and Kns
+        //----------------------------------------------------------------------
+        // Note: Since there are no basic unstable variables, we have nbs = nb
+        // and the blocks Sbunu, Sbup of the permuted echelon form are empty.
+        //======================================================================
+        using Eigen::all;
 
-        Kb.asPermutation().transpose().applyThisOnTheLeft(jb); // jb is now ordered as (jbs, jbu) = (jbe, jbi, jbu)
-        Kn.asPermutation().transpose().applyThisOnTheLeft(jn); // jn is now ordered as (jns, jnu) = (jne, jni, jnu)
+        auto Rbs   = R.topRows(nbs);
+        auto Sbsns = S.topLeftCorner(nbs, nns);
+        auto Sbsp  = S.topRightCorner(nbs, np);
 
-        // ---------------------------------------------------------------------
-        // ***NOTE***
-        // ---------------------------------------------------------------------
-        // At this point, Sbn and Sbp have now the following structure:
-        //     Sbn = [Sbsns Sbsnu; 0 Sbunu; 0bl]
-        //     Sbp = [Sbsp; Sbup; 0bl]
-        // ---------------------------------------------------------------------
+        Rbs   = RWQ.R(Kbs, all);
+        Sbsns = Sbn(Kbs, Kns);
+        Sbsp  = Sbp(Kbs, all);
 
         //=========================================================================================
         // Update the order of x variables as x = (xs, xu) = (xbs, xns, xbu, xnu), where:
@@ -226,41 +312,76 @@ struct Canonicalizer::Impl
 
         // The indices of the stable variables js = (jbs, jns) = (jbe, jbi, jne, jni)
         const auto js = jsu.head(ns);
-        const auto ju = jsu.tail(nu);
 
         //=========================================================================================
         // Initialize matrices Hss, Hsp
+        //-----------------------------------------------------------------------------------------
+        // Note: If Hxx is diagonal (a requirement of the rangespace method),
+        // only the diagonal of Hss is gathered. Its off-diagonal entries are
+        // zeroed only once, when switching from a dense Hss. If Hxx has been
+        // evaluated only on the columns of the basic variables, only the
+        // columns Hsbs in Hss = [Hsbs Hsns] are gathered and Hsns is zero.
         //=========================================================================================
-        using Eigen::all;
-
         auto Hss = Hprime.topLeftCorner(ns, ns);
         auto Hsp = Hprime.topRightCorner(ns, np);
 
-        Hss = H.Hxx(js, js);
-        Hsp = H.Hxp(js, all);
-
         diagHxx = H.isHxxDiag;
 
+        if(diagHxx)
+        {
+            if(!diagHss)
+                Hprime.leftCols(nx).fill(0.0);
+            Hss.diagonal() = Hd(js);
+            if(H.isHxx4basicvars)
+                Hss.diagonal().tail(nns).fill(0.0);
+            diagHss = true;
+        }
+        else if(H.isHxx4basicvars)
+        {
+            Hss.leftCols(nbs) = H.Hxx(js, jbs);
+            Hss.rightCols(nns).fill(0.0);
+            diagHss = false;
+        }
+        else
+        {
+            Hss = H.Hxx(js, js);
+            diagHss = false;
+        }
+
+        Hsp = H.Hxp(js, all);
+
         //=========================================================================================
         // Initialize matrices Vps, Vpp
         //=========================================================================================
         auto Vps = Vprime.topLeftCorner(np, ns);
         auto Vpp = Vprime.topRightCorner(np, np);
 
-        Vps = V.Vpx(all, js);
+        if(V.isVpx4basicvars)
+        {
+            Vps.leftCols(nbs) = V.Vpx(all, jbs);
+            Vps.rightCols(nns).fill(0.0);
+        }
+        else Vps = V.Vpx(all, js);
+
         Vpp = V.Vpp;
 
         //=========================================================================================
-        // Initialize matrices Ws, Wu and Wp in W = [Ws Wu Wp] = [As Au Ap; Js Ju Jp]
+        // Identify the structure of the canonical blocks so that linear solvers can skip
+        // products with zero blocks and use row scalings instead of products with diagonal ones.
         //=========================================================================================
-
-        auto Ws = Wprime.leftCols(ns);
-        auto Wu = Wprime.middleCols(ns, nu);
-        auto Wp = Wprime.rightCols(np);
-
-        Ws = W.Wx(all, js);
-        Wu = W.Wx(all, ju);
-        Wp = W.Wp;
+        structure.Hss   = diagHxx ? MatrixStructure::Diagonal : detectMatrixStructure(Hss);
+        structure.Hsp   = detectMatrixStructure(Hsp);
+        structure.Vps   = detectMatrixStructure(Vps);
+        structure.Vpp   = detectMatrixStructure(Vpp);
+
+        // The blocks Sbsns and Sbsp are gathered from the same echelon form of W and with the same
+        // sets of stable basic and non-basic variables as in the previous update if both its
+        // identifier and the partition are unchanged (e.g., when W = [Ax Ap] is constant). Their
+        // structure is then known, unless diagonal, since their rows and columns may be reordered.
+        const auto sameS = samepartition && RWQ.revision >= 0 && RWQ.revision == revisionprev;
+        revisionprev = RWQ.revision;
+        if(!sameS || structure.Sbsns == MatrixStructure::Diagonal) structure.Sbsns = detectMatrixStructure(Sbsns);
+        if(!sameS || structure.Sbsp  == MatrixStructure::Diagonal) structure.Sbsp  = detectMatrixStructure(Sbsp);
     }
 
     auto canonicalMatrix() const -> CanonicalMatrix
@@ -280,7 +401,7 @@ struct Canonicalizer::Impl
         const auto js = jsu.head(ns);
         const auto ju = jsu.tail(nu);
 
-        return {dims, Hss, Hsp, Vps, Vpp, Sbsns, Sbsp, Rbs, jb, jn, js, ju};
+        return {dims, Hss, Hsp, Vps, Vpp, Sbsns, Sbsp, Rbs, jb, jn, js, ju, structure};
     }
 };
 
@@ -305,6 +426,16 @@ auto Canonicalizer::operator=(Canonicalizer other) -> Canonicalizer&
     return *this;
 }
 
+auto Canonicalizer::assign(const Canonicalizer& other) -> void
+{
+    pimpl->assign(*other.pimpl);
+}
+
+auto Canonicalizer::setOrderByIndex(bool enable) -> void
+{
+    pimpl->orderbyindex = enable;
+}
+
 auto Canonicalizer::update(const MasterMatrix& M) -> void
 {
     pimpl->update(M);
@@ -47,6 +47,17 @@ public:
     /// Assign a Canonicalizer instance to this.
     auto operator=(Canonicalizer other) -> Canonicalizer&;
 
+    /// Assign another Canonicalizer instance to this reusing its memory.
+    /// No memory is allocated if the matrices in both have the same dimensions.
+    auto assign(const Canonicalizer& other) -> void;
+
+    /// Set whether the explicit and implicit stable variables are ordered by their indices.
+    /// Otherwise, they keep their order in the echelon form, which changes with the
+    /// priority weights even if the basic variables do not. Ordering them by index
+    /// makes the canonical form depend only on the partition of the variables, so
+    /// that the decomposition of a constant master matrix can be reused.
+    auto setOrderByIndex(bool enable) -> void;
+
     /// Assemble the canonical form of the master matrix.
     auto update(const MasterMatrix& M) -> void;
 
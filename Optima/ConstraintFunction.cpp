@@ -47,10 +47,7 @@ ConstraintFunction::ConstraintFunction(const Signature4py& func)
 
 auto ConstraintFunction::operator()(ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts) const -> void
 {
-    // Ensure clear state before evaluation
-    res.val.fill(0.0);
-    res.ddx.fill(0.0);
-    res.ddp.fill(0.0);
+    // Reset the flags, but not the vector and matrices, whose entries not written by fn are kept (see MasterProblem)
     res.ddx4basicvars = false;
     res.succeeded = true;
     fn(res, x, p, opts);
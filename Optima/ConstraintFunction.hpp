@@ -41,17 +41,20 @@ struct ConstraintResultBase
     Mat ddp;
 
     /// True if `ddx` is non-zero only on columns corresponding to basic varibles in *x*.
+    /// Set this to true if only the columns of `ddx` corresponding to the
+    /// variables in ConstraintOptions::ibasicvars have been evaluated. The
+    /// remaining columns are then considered zero.
     Bool ddx4basicvars;
 
     /// True if the constraint function evaluation succeeded.
     Bool succeeded;
 
-    /// Construct a ConstraintResultBase object with given dimensions.
+    /// Construct a ConstraintResultBase object with given dimensions (with zero-initialized vector and matrices).
     /// @param nc The number of constraint equations in *c(x, p)*.
     /// @param nx The number of variables in *x*.
     /// @param np The number of variables in *p*.
     ConstraintResultBase(Index nc, Index nx, Index np)
-    : val(nc), ddx(nc, nx), ddp(nc, np), ddx4basicvars(false), succeeded(true) {}
+    : val(Vec::Zero(nc)), ddx(Mat::Zero(nc, nx)), ddp(Mat::Zero(nc, np)), ddx4basicvars(false), succeeded(true) {}
 
     /// Construct an ConstraintResultBase object from another.
     template<typename B, typename V, typename M>
@@ -62,6 +65,14 @@ struct ConstraintResultBase
     /// Construct an ConstraintResultBase object with given data.
     ConstraintResultBase(Vec val, Mat ddx, Mat ddp, Bool ddx4basicvars, Bool succeeded)
     : val(val), ddx(ddx), ddp(ddp), ddx4basicvars(ddx4basicvars), succeeded(succeeded) {}
+
+    /// Set the vector value and the Jacobian matrices to zero.
+    auto setZero() -> void
+    {
+        val.setZero();
+        ddx.setZero();
+        ddp.setZero();
+    }
 };
 
 /// The result of a constraint function evaluation.
@@ -84,6 +95,8 @@ struct ConstraintOptions
     const Eval eval;
 
     /// The indices of the basic variables in *x*.
+    /// Only the columns of `ddx` corresponding to these variables are needed
+    /// if ConstraintResult::ddx4basicvars is set to true in the evaluation.
     IndicesView ibasicvars;
 };
 
@@ -119,6 +132,9 @@ public:
     // : ConstraintFunction(fn) {}
 
     /// Evaluate the constraint function.
+    /// The vector and matrices in *res* are not set to zero before the evaluation, so that the
+    /// entries the function does not write keep their values (see MasterProblem). Call
+    /// ConstraintResultBase::setZero before if the function expects zeroed storage.
     auto operator()(ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts) const -> void;
 
     /// Assign another constraint function to this.
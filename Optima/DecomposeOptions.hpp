@@ -0,0 +1,62 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// Used to organize the options for the decomposition of an optimization problem into independent subproblems.
+struct DecomposeOptions
+{
+    /// True if the optimization problem is decomposed into independent subproblems before it is solved.
+    /// The variables *x* are grouped into connected components, in which two variables are connected
+    /// if they appear together in a row of *Aex*, *Agx*, *Jex* or *Jgx*, or in an off-diagonal
+    /// entry of *fxx*. The structure of the non-linear functions is taken from the sparsity patterns
+    /// @ref fxx, @ref Jex and @ref Jgx, or detected if @ref detect is true. A non-linear function
+    /// with neither is assumed to couple all variables, so that no decomposition is performed.
+    /// Each component is then solved as a separate problem and the solutions are stitched back
+    /// together. The decomposition is not applied when there are parameter variables *p*, since
+    /// these couple all variables.
+    bool active = false;
+
+    /// The sparsity pattern of *fxx* with dimension *nx* by *nx* (non-zero entries denote structural non-zeros).
+    Matrix fxx;
+
+    /// The sparsity pattern of *Jex* with dimension *nhe* by *nx* (non-zero entries denote structural non-zeros).
+    Matrix Jex;
+
+    /// The sparsity pattern of *Jgx* with dimension *nhg* by *nx* (non-zero entries denote structural non-zeros).
+    Matrix Jgx;
+
+    /// True if the sparsity patterns not given are detected from the non-zero derivatives of the functions.
+    /// The derivatives are evaluated at the initial guess and at a point near it, since entries
+    /// such as those of *x0²x1²* vanish at *x = 0*. A coupling may still be missed if it vanishes
+    /// at both points. Thus, the stitched solution is then checked against the original problem,
+    /// whose calculation proceeds from it if its residual does not satisfy the convergence tolerance.
+    bool detect = false;
+
+    /// The number of worker threads used to solve the independent subproblems concurrently.
+    /// The subproblems are solved sequentially if this is less than two. Enable this only if
+    /// the objective and constraint functions can safely be evaluated at the same time.
+    Index threads = 0;
+};
+
+} // namespace Optima
@@ -0,0 +1,476 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Decomposer.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Optima includes
+#include <Optima/ConstraintFunction.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/IndexUtils.hpp>
+#include <Optima/ObjectiveFunction.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+#include <Optima/TaskPool.hpp>
+#include <Optima/Timing.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+namespace {
+
+/// Return the representative of the set containing element *i* (with path halving).
+auto findroot(std::vector<Index>& parent, Index i) -> Index
+{
+    while(parent[i] != i)
+        i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+/// Merge the sets containing the variables with non-zero coefficients in each row of a matrix.
+/// @return The first variable with a non-zero coefficient in each row (or -1 if none).
+auto connectRows(std::vector<Index>& parent, MatrixView M) -> std::vector<Index>
+{
+    std::vector<Index> first(M.rows(), -1);
+    for(auto i = 0; i < M.rows(); ++i)
+    {
+        for(auto j = 0; j < M.cols(); ++j)
+        {
+            if(M(i, j) == 0.0) continue;
+            if(first[i] == -1) first[i] = j;
+            else parent[findroot(parent, j)] = findroot(parent, first[i]);
+        }
+    }
+    return first;
+}
+
+/// The workspace used to evaluate a function of the original problem within a function of a subproblem.
+template<typename Res>
+struct DecomposeWorkspace
+{
+    Res res;            ///< The result of the evaluation of the function of the original problem.
+    Vector x;           ///< The variables *x* of the original problem.
+    Indices ibasicvars; ///< The indices of the basic variables in *x* of the original problem.
+
+    /// Construct a DecomposeWorkspace object.
+    DecomposeWorkspace(const Res& res, Index nx)
+    : res(res), x(zeros(nx)), ibasicvars(nx) {}
+};
+
+/// An independent subproblem in the decomposition of an optimization problem.
+struct Subproblem
+{
+    Indices ix;                                 ///< The indices of the variables in *x* of the original problem.
+    Indices ie;                                 ///< The indices of the linear equality constraints of the original problem.
+    Indices ig;                                 ///< The indices of the linear inequality constraints of the original problem.
+    Indices ihe;                                ///< The indices of the non-linear equality constraints of the original problem.
+    Indices ihg;                                ///< The indices of the non-linear inequality constraints of the original problem.
+    Problem problem;                            ///< The optimization problem of this subproblem.
+    State state;                                ///< The state of the optimization problem of this subproblem.
+    std::unique_ptr<Solver> solver;             ///< The solver for the optimization problem of this subproblem.
+    Result result;                              ///< The result of the last solution of this subproblem.
+    DecomposeWorkspace<ObjectiveResult> fws;    ///< The workspace for the evaluation of f(x, p).
+    DecomposeWorkspace<ConstraintResult> hews;  ///< The workspace for the evaluation of he(x, p).
+    DecomposeWorkspace<ConstraintResult> hgws;  ///< The workspace for the evaluation of hg(x, p).
+
+    /// Construct a Subproblem object with given indices in the original problem of dimensions *dims*.
+    Subproblem(const Dims& dims, const Indices& ix, const Indices& ie, const Indices& ig, const Indices& ihe, const Indices& ihg)
+    : ix(ix), ie(ie), ig(ig), ihe(ihe), ihg(ihg),
+      problem(Dims{ix.size(), 0, ie.size(), ig.size(), ihe.size(), ihg.size()}),
+      state(problem.dims),
+      fws(ObjectiveResult(dims.x, dims.p), dims.x),
+      hews(ConstraintResult(dims.he, dims.x, dims.p), dims.x),
+      hgws(ConstraintResult(dims.hg, dims.x, dims.p), dims.x)
+    {}
+};
+
+} // namespace
+
+struct Decomposer::Impl
+{
+    const Dims dims;                       ///< The dimensions of the original optimization problem.
+    Options options;                       ///< The options for the solution of the subproblems (with decomposition and presolve inactive).
+    DecomposeOptions decompose;            ///< The options of the decomposition.
+    TaskPool pool;                         ///< The worker threads used to solve the subproblems concurrently.
+    Indices labels;                        ///< The subproblem of each variable in *x* and of each row in *be*, *bg*, *he*, *hg*.
+    Indices ibasicvars;                    ///< The indices of all variables in *x*, used to detect the structure of the non-linear functions.
+    ObjectiveResult fres;                  ///< The result of *f(x, p)* used to detect the structure of *fxx*.
+    ConstraintResult heres;                ///< The result of *he(x, p)* used to detect the structure of *Jex*.
+    ConstraintResult hgres;                ///< The result of *hg(x, p)* used to detect the structure of *Jgx*.
+    Matrix fxxpattern;                     ///< The sparsity pattern of *fxx* in the last determined decomposition.
+    Matrix Jexpattern;                     ///< The sparsity pattern of *Jex* in the last determined decomposition.
+    Matrix Jgxpattern;                     ///< The sparsity pattern of *Jgx* in the last determined decomposition.
+    bool detected = false;                 ///< True if a sparsity pattern in the last determined decomposition was detected rather than given.
+    std::vector<std::unique_ptr<Subproblem>> subproblems; ///< The independent subproblems in the last determined decomposition.
+    const Problem* problemptr = nullptr;   ///< The original problem in the current solve call, used in the functions of the subproblems.
+
+    Impl(const Dims& dims)
+    : dims(dims), ibasicvars(indices(dims.x)),
+      fres(dims.x, dims.p),
+      heres(dims.he, dims.x, dims.p),
+      hgres(dims.hg, dims.x, dims.p)
+    {
+    }
+
+    Impl(const Impl& other)
+    : Impl(other.dims)
+    {
+        setOptions(other.options);
+        decompose = other.decompose;
+    }
+
+    auto setOptions(const Options& opts) -> void
+    {
+        decompose = opts.decompose;
+        options = opts;
+        options.decompose.active = false;
+        options.presolve.active = false;
+        const auto nthreads = decompose.threads < 2 ? 0 : decompose.threads;
+        if(pool.size() != nthreads)
+            pool = TaskPool(nthreads);
+        for(auto& sp : subproblems)
+            sp->solver->setOptions(options);
+    }
+
+    /// Determine the sparsity patterns of *fxx*, *Jex* and *Jgx* from those given in the options or detected.
+    /// @return `false` if a pattern is neither given nor detected, or if its detection failed.
+    auto determinePatterns(const Problem& problem, const State& state) -> bool
+    {
+        const auto nx  = dims.x;
+        const auto nhe = dims.he;
+        const auto nhg = dims.hg;
+
+        const auto& fxx = decompose.fxx;
+        const auto& Jex = decompose.Jex;
+        const auto& Jgx = decompose.Jgx;
+
+        error(fxx.size() && (fxx.rows() != nx || fxx.cols() != nx),
+            "Cannot decompose the optimization problem. "
+            "The sparsity pattern of fxx must have dimension ", nx, " by ", nx, ".");
+        error(Jex.size() && (Jex.rows() != nhe || Jex.cols() != nx),
+            "Cannot decompose the optimization problem. "
+            "The sparsity pattern of Jex must have dimension ", nhe, " by ", nx, ".");
+        error(Jgx.size() && (Jgx.rows() != nhg || Jgx.cols() != nx),
+            "Cannot decompose the optimization problem. "
+            "The sparsity pattern of Jgx must have dimension ", nhg, " by ", nx, ".");
+
+        const auto givenfxx = fxx.size() > 0;
+        const auto givenJex = nhe == 0 || Jex.size() > 0;
+        const auto givenJgx = nhg == 0 || Jgx.size() > 0;
+
+        fxxpattern = givenfxx ? fxx : zeros(nx, nx);
+        Jexpattern = Jex.size() ? Jex : zeros(nhe, nx);
+        Jgxpattern = Jgx.size() ? Jgx : zeros(nhg, nx);
+
+        detected = !givenfxx || !givenJex || !givenJgx;
+
+        if(!detected)
+            return true;
+
+        // A non-linear function without a given sparsity pattern couples all variables
+        if(!decompose.detect)
+            return false;
+
+        // Detect the missing patterns from the non-zero derivatives at the initial guess and at a
+        // point near it, so that entries vanishing at the initial guess (e.g., at x = 0) are kept
+        const Vector xp = perturbed(state.x);
+
+        for(auto x : { VectorView(state.x), VectorView(xp) })
+        {
+            if(!givenfxx)
+            {
+                fres.setZero();
+                problem.f(fres, x, state.p, ObjectiveOptions{{true, false}, ibasicvars});
+                if(!fres.succeeded)
+                    return false;
+                if(fres.diagfxx)
+                    fxxpattern.diagonal() += fres.fxx.diagonal().cwiseAbs();
+                else fxxpattern += fres.fxx.cwiseAbs();
+            }
+            if(!givenJex)
+            {
+                heres.setZero();
+                problem.he(heres, x, state.p, ConstraintOptions{{true, false}, ibasicvars});
+                if(!heres.succeeded)
+                    return false;
+                Jexpattern += heres.ddx.cwiseAbs();
+            }
+            if(!givenJgx)
+            {
+                hgres.setZero();
+                problem.hg(hgres, x, state.p, ConstraintOptions{{true, false}, ibasicvars});
+                if(!hgres.succeeded)
+                    return false;
+                Jgxpattern += hgres.ddx.cwiseAbs();
+            }
+        }
+
+        return true;
+    }
+
+    auto decomposeProblem(const Problem& problem, const State& state) -> bool
+    {
+        if(!decompose.active || dims.p > 0 || dims.x < 2)
+            return false;
+
+        const auto nx  = dims.x;
+        const auto nbe = dims.be;
+        const auto nbg = dims.bg;
+        const auto nhe = dims.he;
+        const auto nhg = dims.hg;
+
+        if(!determinePatterns(problem, state))
+            return false;
+
+        // Merge the variables connected by the constraints and the Hessian of the objective function
+        std::vector<Index> parent(nx);
+        for(auto j = 0; j < nx; ++j)
+            parent[j] = j;
+
+        const auto firstbe = connectRows(parent, problem.Aex);
+        const auto firstbg = connectRows(parent, problem.Agx);
+        const auto firsthe = connectRows(parent, Jexpattern);
+        const auto firsthg = connectRows(parent, Jgxpattern);
+
+        connectRows(parent, fxxpattern);
+
+        // Number the subproblems in the order of their first variables, so
+        // that rows without variables are assigned to the subproblem of x[0]
+        std::vector<Index> component(nx, -1);
+        Index count = 0;
+        for(auto j = 0; j < nx; ++j)
+        {
+            const auto root = findroot(parent, j);
+            if(component[root] == -1)
+                component[root] = count++;
+            component[j] = component[root];
+        }
+
+        if(count < 2)
+            return false;
+
+        Indices newlabels(nx + nbe + nbg + nhe + nhg);
+        Index k = 0;
+        for(auto j = 0; j < nx; ++j)
+            newlabels[k++] = component[j];
+        for(const auto& first : { firstbe, firstbg, firsthe, firsthg })
+            for(auto j : first)
+                newlabels[k++] = j == -1 ? 0 : component[j];
+
+        // Reuse the subproblems (and their solvers) if the decomposition has not changed
+        if(labels.size() == newlabels.size() && labels == newlabels)
+            return true;
+
+        labels = newlabels;
+
+        const auto select = [&](Index offset, Index size, Index c) -> Indices
+        {
+            std::vector<Index> selected;
+            for(auto i = 0; i < size; ++i)
+                if(labels[offset + i] == c)
+                    selected.push_back(i);
+            return Eigen::Map<const Indices>(selected.data(), selected.size());
+        };
+
+        subproblems.clear();
+        for(auto c = 0; c < count; ++c)
+        {
+            subproblems.push_back(std::make_unique<Subproblem>(dims,
+                select(0, nx, c),
+                select(nx, nbe, c),
+                select(nx + nbe, nbg, c),
+                select(nx + nbe + nbg, nhe, c),
+                select(nx + nbe + nbg + nhe, nhg, c)));
+            initSubproblem(*subproblems.back());
+        }
+
+        return true;
+    }
+
+    /// Initialize the functions of a subproblem and its solver.
+    auto initSubproblem(Subproblem& sp) -> void
+    {
+        sp.problem.f = [this, &sp](ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions opts)
+        {
+            auto& ws = sp.fws;
+            const auto ibasicvars = expand(sp, x, opts.ibasicvars, ws.x, ws.ibasicvars);
+            ws.res.setZero();
+            problemptr->f(ws.res, ws.x, p, ObjectiveOptions{opts.eval, ibasicvars});
+            res.f = ws.res.f;
+            res.fx = ws.res.fx(sp.ix);
+            if(ws.res.diagfxx) res.fxx.diagonal() = ws.res.fxx.diagonal()(sp.ix);
+            else res.fxx = ws.res.fxx(sp.ix, sp.ix);
+            res.diagfxx = ws.res.diagfxx;
+            res.fxx4basicvars = ws.res.fxx4basicvars;
+            res.succeeded = ws.res.succeeded;
+        };
+
+        sp.problem.he = [this, &sp](ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts)
+        {
+            evalConstraintFunction(problemptr->he, sp, sp.ihe, sp.hews, res, x, p, opts);
+        };
+
+        sp.problem.hg = [this, &sp](ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts)
+        {
+            evalConstraintFunction(problemptr->hg, sp, sp.ihg, sp.hgws, res, x, p, opts);
+        };
+
+        sp.solver = std::make_unique<Solver>(sp.problem);
+        sp.solver->setOptions(options);
+    }
+
+    /// Return the variables and the basic variables of the original problem from those of a subproblem.
+    /// The variables of the other subproblems remain as in the initial guess.
+    auto expand(const Subproblem& sp, VectorView x, IndicesView ibasicvars, VectorRef xfull, IndicesRef ibasicvarsfull) const -> IndicesView
+    {
+        xfull(sp.ix) = x;
+        auto ib = ibasicvarsfull.head(ibasicvars.size());
+        ib = sp.ix(ibasicvars);
+        return ib;
+    }
+
+    /// Evaluate a constraint function of the original problem within a constraint function of a subproblem.
+    auto evalConstraintFunction(const ConstraintFunction& c, const Subproblem& sp, const Indices& irows, DecomposeWorkspace<ConstraintResult>& ws, ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts) -> void
+    {
+        const auto ibasicvars = expand(sp, x, opts.ibasicvars, ws.x, ws.ibasicvars);
+        ws.res.setZero();
+        c(ws.res, ws.x, p, ConstraintOptions{opts.eval, ibasicvars});
+        res.val = ws.res.val(irows);
+        res.ddx = ws.res.ddx(irows, sp.ix);
+        res.ddx4basicvars = ws.res.ddx4basicvars;
+        res.succeeded = ws.res.succeeded;
+    }
+
+    auto solve(const Problem& problem, State& state) -> Result
+    {
+        Timer timer;
+
+        problemptr = &problem;
+
+        // Refresh the data and the initial guess of each subproblem
+        for(auto& ptr : subproblems)
+        {
+            auto& sp = *ptr;
+            auto& p = sp.problem;
+            auto& s = sp.state;
+
+            p.Aex = problem.Aex(sp.ie, sp.ix);
+            p.be = problem.be(sp.ie);
+            p.Agx = problem.Agx(sp.ig, sp.ix);
+            p.bg = problem.bg(sp.ig);
+            p.xlower = problem.xlower(sp.ix);
+            p.xupper = problem.xupper(sp.ix);
+
+            sp.fws.x = state.x;
+            sp.hews.x = state.x;
+            sp.hgws.x = state.x;
+
+            s.x = state.x(sp.ix);
+            s.ye = state.ye(sp.ie);
+            s.yg = state.yg(sp.ig);
+            s.ze = state.ze(sp.ihe);
+            s.zg = state.zg(sp.ihg);
+            s.xbg = state.xbg(sp.ig);
+            s.xhg = state.xhg(sp.ihg);
+        }
+
+        // Solve the subproblems, concurrently if worker threads are available
+        for(auto& ptr : subproblems)
+        {
+            auto& sp = *ptr;
+            pool.enqueue([&sp] { sp.result = sp.solver->solve(sp.problem, sp.state); });
+        }
+
+        pool.wait();
+
+        // Stitch the solutions of the subproblems back into the state of the original problem
+        Result result;
+        result.succeeded = true;
+
+        for(auto& ptr : subproblems)
+        {
+            auto& sp = *ptr;
+            const auto& s = sp.state;
+            const auto& res = sp.result;
+
+            state.x(sp.ix) = s.x;
+            state.ye(sp.ie) = s.ye;
+            state.yg(sp.ig) = s.yg;
+            state.ze(sp.ihe) = s.ze;
+            state.zg(sp.ihg) = s.zg;
+            state.xbg(sp.ig) = s.xbg;
+            state.xhg(sp.ihg) = s.xhg;
+            state.s(sp.ix) = s.s;
+
+            result += res;
+        }
+
+        result.time = timer.elapsed();
+
+        return result;
+    }
+};
+
+Decomposer::Decomposer(const Dims& dims)
+: pimpl(new Impl(dims))
+{}
+
+Decomposer::Decomposer(const Decomposer& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+Decomposer::~Decomposer()
+{}
+
+auto Decomposer::operator=(Decomposer other) -> Decomposer&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto Decomposer::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto Decomposer::decompose(const Problem& problem, const State& state) -> bool
+{
+    return pimpl->decomposeProblem(problem, state);
+}
+
+auto Decomposer::detected() const -> bool
+{
+    return pimpl->detected;
+}
+
+auto Decomposer::numSubproblems() const -> Index
+{
+    return pimpl->subproblems.size();
+}
+
+auto Decomposer::solve(const Problem& problem, State& state) -> Result
+{
+    return pimpl->solve(problem, state);
+}
+
+} // namespace Optima
@@ -0,0 +1,82 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Dims.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Options;
+class Problem;
+class Result;
+class State;
+
+/// Used to decompose an optimization problem into independent subproblems and stitch their solutions back together.
+class Decomposer
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a Decomposer object with given dimensions of the optimization problem.
+    Decomposer(const Dims& dims);
+
+    /// Construct a copy of a Decomposer object.
+    Decomposer(const Decomposer& other);
+
+    /// Destroy this Decomposer object.
+    virtual ~Decomposer();
+
+    /// Assign a Decomposer object to this.
+    auto operator=(Decomposer other) -> Decomposer&;
+
+    /// Set the options of this Decomposer object.
+    auto setOptions(const Options& options) -> void;
+
+    /// Determine the decomposition of the optimization problem into independent subproblems.
+    /// The structure of the non-linear functions is given by the sparsity patterns in
+    /// DecomposeOptions, or detected from their derivatives at the variables *x* in
+    /// *state* and at a point near them. The variables *x* in *state* are also used
+    /// as the initial guess in @ref solve.
+    /// @return `true` if the optimization problem has more than one independent subproblem.
+    auto decompose(const Problem& problem, const State& state) -> bool;
+
+    /// Return `true` if a sparsity pattern in the last determined decomposition was detected rather than given.
+    /// In this case, a coupling among the variables may have been missed, and the
+    /// solution returned by @ref solve should be checked against the original problem.
+    auto detected() const -> bool;
+
+    /// Return the number of independent subproblems in the last determined decomposition.
+    auto numSubproblems() const -> Index;
+
+    /// Solve the optimization problem using its last determined decomposition.
+    /// On exit, the variables *x*, the Lagrange multipliers *y* and *z*, and
+    /// the stability measures *s* in *state* correspond to the original
+    /// optimization problem. The result is successful only if the solution
+    /// of every subproblem is successful.
+    auto solve(const Problem& problem, State& state) -> Result;
+};
+
+} // namespace Optima
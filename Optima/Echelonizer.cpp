@@ -68,6 +68,12 @@ struct Echelonizer::Impl
     /// The matrix M used in the swap operation.
     Vector M;
 
+    /// The auxiliary matrix used to permute the rows and columns of S without memory allocation.
+    Matrix Saux;
+
+    /// The auxiliary matrix used to permute the rows of R without memory allocation.
+    Matrix Raux;
+
     /// The permutation matrix Kb used in the weighted update method.
     PermutationMatrix Kb;
 
@@ -164,6 +170,11 @@ struct Echelonizer::Impl
         Kb.setIdentity(nb);
         Kn.setIdentity(nn);
 
+        // Initialize the workspace used in the swap and weighted update methods
+        M.resize(nb);
+        Saux.resize(nb, nn);
+        Raux.resize(nb, m);
+
         // Initialize the threshold value
         threshold = std::abs(lu.maxPivot()) * lu.threshold() * std::max(A.rows(), A.cols());
 
@@ -234,9 +245,6 @@ struct Echelonizer::Impl
         const auto nb = rankA;
         const auto nn = A.cols() - rankA;
 
-        // The upper part of R corresponding to linearly independent rows of A
-        auto Rb = R.topRows(nb);
-
         // The indices of the basic and non-basic variables
         auto ibasic = Q.head(nb);
         auto inonbasic = Q.tail(nn);
@@ -275,20 +283,34 @@ struct Echelonizer::Impl
         std::sort(Kn.indices().data(), Kn.indices().data() + nn,
             [&](Index l, Index r) { return w[inonbasic[l]] > w[inonbasic[r]]; });
 
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(S);
+        // Rearrange the rows and columns of S, the top `nb` rows of R and
+        // the permutation matrix Q based on the new order of basic and
+        // non-basic variables (note: the permutations are not applied in
+        // place, since Eigen would then allocate memory for a mask array)
+        permute(Kb, Kn);
+    }
 
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.applyThisOnTheRight(S);
+    /// Rearrange S, R and Q based on the given orderings of the basic and non-basic variables.
+    template<typename PermutationB, typename PermutationN>
+    auto permute(const PermutationB& Kb, const PermutationN& Kn) -> void
+    {
+        const auto nb = rankA;
+        const auto nn = A.cols() - rankA;
+
+        auto Rb = R.topRows(nb);
+
+        auto ibasic = Q.head(nb);
+        auto inonbasic = Q.tail(nn);
 
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(Rb);
+        Saux = Kb.transpose() * S;
+        S = Saux * Kn;
 
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(ibasic);
+        Raux = Kb.transpose() * Rb;
+        Rb = Raux;
 
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.transpose().applyThisOnTheLeft(inonbasic);
+        Qaux.head(nb) = Kb.transpose() * ibasic;
+        Qaux.tail(nn) = Kn.transpose() * inonbasic;
+        Q = Qaux;
     }
 
     /// Reset to the canonical matrix form computed initially.
@@ -309,27 +331,8 @@ struct Echelonizer::Impl
         assert(nb == Kb.size());
         assert(nn == Kn.size());
 
-        // The top nb rows of R, since its remaining rows correspond to linearly dependent rows in A
-        auto Rt = R.topRows(nb);
-
-        // The indices of the basic and non-basic variables
-        auto ibasic = Q.head(nb);
-        auto inonbasic = Q.tail(nn);
-
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(S);
-
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.asPermutation().applyThisOnTheRight(S);
-
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Rt);
-
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(ibasic);
-
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.asPermutation().transpose().applyThisOnTheLeft(inonbasic);
+        // Rearrange S, the top `nb` rows of R and Q based on the new order of basic and non-basic variables
+        permute(Kb.asPermutation(), Kn.asPermutation());
     }
 
     /// Perform a cleanup procedure to remove residual round-off errors from the canonical form.
@@ -366,6 +369,11 @@ auto Echelonizer::operator=(Echelonizer other) -> Echelonizer&
     return *this;
 }
 
+auto Echelonizer::assign(const Echelonizer& other) -> void
+{
+    *pimpl = *other.pimpl; // the assignment of Eigen objects with same dimensions reuses their memory
+}
+
 auto Echelonizer::numVariables() const -> Index
 {
     return pimpl->lu.cols();
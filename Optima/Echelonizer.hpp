@@ -57,6 +57,10 @@ public:
     /// Assign a Echelonizer instance to this.
     auto operator=(Echelonizer other) -> Echelonizer&;
 
+    /// Assign another Echelonizer instance to this reusing its memory.
+    /// No memory is allocated if the matrices in both have the same dimensions.
+    auto assign(const Echelonizer& other) -> void;
+
     /// Return the number of variables.
     auto numVariables() const -> Index;
 
@@ -46,6 +46,30 @@ struct EchelonizerExtended::Impl
     /// The permutation matrix `Kn` used in the update method with priority weights.
     PermutationMatrix Kn;
 
+    /// The workspace for the matrix J*QA in the update method with priority weights.
+    Matrix J12;
+
+    /// The workspace for the matrix SA*QJ in the update method with priority weights.
+    Matrix SA12;
+
+    /// The workspace for the matrix J1*RAt in the update method with priority weights.
+    Matrix J1RAt;
+
+    /// The workspace for the matrix RJt*J1*RAt in the update method with priority weights.
+    Matrix RJtJ1RAt;
+
+    /// The workspace for the priority weights of the non-basic variables with respect to A.
+    Vector w;
+
+    /// The auxiliary matrix used to permute the rows and columns of S without memory allocation.
+    Matrix Saux;
+
+    /// The auxiliary matrix used to permute the rows of R without memory allocation.
+    Matrix Raux;
+
+    /// The auxiliary vector used to permute the indices in Q without memory allocation.
+    Indices Qaux;
+
     /// The number used for eliminating round-off errors during cleanup procedure.
     /// This is computed as 10**[1 + ceil(log10(maxAij))], where maxAij is the
     /// inf norm of matrix A. For each entry in R and S, we add sigma and
@@ -71,6 +95,27 @@ struct EchelonizerExtended::Impl
         sigma = A.size() ? std::pow(10, 1 + std::ceil(std::log10(sigma))) : 0.0; // TODO: In the future, consider a contribution from J to determine sigma (or find an alternative approach to remove round-off errors.)
     }
 
+    /// Assign another EchelonizerExtended::Impl object to this reusing its memory.
+    auto assign(const Impl& other) -> void
+    {
+        echelonizerA.assign(other.echelonizerA);
+        echelonizerJ.assign(other.echelonizerJ);
+        R        = other.R;
+        S        = other.S;
+        Q        = other.Q;
+        Kb       = other.Kb;
+        Kn       = other.Kn;
+        J12      = other.J12;
+        SA12     = other.SA12;
+        J1RAt    = other.J1RAt;
+        RJtJ1RAt = other.RJtJ1RAt;
+        w        = other.w;
+        Saux     = other.Saux;
+        Raux     = other.Raux;
+        Qaux     = other.Qaux;
+        sigma    = other.sigma;
+    }
+
     /// Update the canonical form with given variable matrix J in W = [A; J] and priority weights for the variables.
     auto updateWithPriorityWeights(MatrixView J, VectorView weights) -> void
     {
@@ -98,12 +143,12 @@ struct EchelonizerExtended::Impl
         const auto mJ = J.rows();
         const auto m = mA + mJ;
 
-        Matrix J12 = J * QA.asPermutation();
+        J12 = J * QA.asPermutation();
         auto J1 = J12.leftCols(nbA);
         auto J2 = J12.rightCols(nnA);
-        J2 -= J1 * SA;
+        J2.noalias() -= J1 * SA;
 
-        Vector w = weights(QA.tail(nnA));  // w has the weights only for non-basic variables wrt A
+        w = weights(QA.tail(nnA));  // w has the weights only for non-basic variables wrt A
         echelonizerJ.compute(J2);
         echelonizerJ.updateWithPriorityWeights(w);
 
@@ -124,11 +169,10 @@ struct EchelonizerExtended::Impl
         Q.head(nbA) = QA.head(nbA);
         Q.tail(nnA) = QA.tail(nnA)(QJ);
 
-        Matrix SA12 = SA;
-        QJ.asPermutation().applyThisOnTheRight(SA12);
+        SA12 = SA * QJ.asPermutation();
         auto SA1 = SA12.leftCols(nbJ);
         auto SA2 = SA12.rightCols(nnJ);
-        SA2 -= SA1 * SJ;
+        SA2.noalias() -= SA1 * SJ;
 
         S.resize(nbA + nbJ, nnJ);
         S.topRows(nbA) = SA2;
@@ -145,14 +189,19 @@ struct EchelonizerExtended::Impl
         auto Rt = R.topRows(nbA + nbJ);
         auto Rb = R.bottomRows(m - nbA - nbJ);
 
-        Rt.topLeftCorner(nbA, mA) = RAt + SA1*RJt*J1*RAt;
+        J1RAt.noalias() = J1*RAt;
+        RJtJ1RAt.resize(nbJ, mA);
+        RJtJ1RAt.noalias() = RJt*J1RAt;
+
+        Rt.topLeftCorner(nbA, mA) = RAt;
+        Rt.topLeftCorner(nbA, mA).noalias() += SA1*RJtJ1RAt;
         Rb.topLeftCorner(mA - nbA, mA) = RAb;
 
-        Rt.topRightCorner(nbA, mJ) = -SA1*RJt;
+        Rt.topRightCorner(nbA, mJ).noalias() = -SA1*RJt;
         Rb.topRightCorner(mA - nbA, mJ).fill(0.0);
 
-        Rt.bottomLeftCorner(nbJ, mA) = -RJt*J1*RAt;
-        Rb.bottomLeftCorner(mJ - nbJ, mA) = -RJb*J1*RAt;
+        Rt.bottomLeftCorner(nbJ, mA) = -RJtJ1RAt;
+        Rb.bottomLeftCorner(mJ - nbJ, mA).noalias() = -RJb*J1RAt;
 
         Rt.bottomRightCorner(nbJ, mJ) = RJt;
         Rb.bottomRightCorner(mJ - nbJ, mJ) = RJb;
@@ -180,53 +229,45 @@ struct EchelonizerExtended::Impl
         std::sort(Kn.indices().data(), Kn.indices().data() + nn,
             [&](Index l, Index r) { return weights[inonbasic[l]] > weights[inonbasic[r]]; });
 
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(S);
-
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.applyThisOnTheRight(S);
-
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(Rt);
-
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(ibasic);
-
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.transpose().applyThisOnTheLeft(inonbasic);
+        // Rearrange the rows and columns of S, the top `nb` rows of R and
+        // the permutation matrix Q based on the new order of basic and
+        // non-basic variables (note: the permutations are not applied in
+        // place, since Eigen would then allocate memory for a mask array)
+        permute(Kb, Kn);
     }
 
-    /// Update the ordering of the basic and non-basic variables,
-    auto updateOrdering(IndicesView Kb, IndicesView Kn) -> void
+    /// Rearrange S, R and Q based on the given orderings of the basic and non-basic variables.
+    template<typename PermutationB, typename PermutationN>
+    auto permute(const PermutationB& Kb, const PermutationN& Kn) -> void
     {
-        const auto n  = Q.rows();
         const auto nb = S.rows();
-        const auto nn = n - nb;
+        const auto nn = S.cols();
 
-        assert(nb == Kb.size());
-        assert(nn == Kn.size());
-
-        // The top nb rows of R, since its remaining rows correspond to linearly dependent rows in [A; J]
         auto Rt = R.topRows(nb);
 
-        // The indices of the basic and non-basic variables
         auto ibasic = Q.head(nb);
         auto inonbasic = Q.tail(nn);
 
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(S);
+        Saux = Kb.transpose() * S;
+        S = Saux * Kn;
 
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.asPermutation().applyThisOnTheRight(S);
+        Raux = Kb.transpose() * Rt;
+        Rt = Raux;
 
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Rt);
+        Qaux.resize(Q.rows());
+        Qaux.head(nb) = Kb.transpose() * ibasic;
+        Qaux.tail(nn) = Kn.transpose() * inonbasic;
+        Q = Qaux;
+    }
 
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(ibasic);
+    /// Update the ordering of the basic and non-basic variables,
+    auto updateOrdering(IndicesView Kb, IndicesView Kn) -> void
+    {
+        assert(S.rows() == Kb.size());
+        assert(Q.rows() - S.rows() == Kn.size());
 
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.asPermutation().transpose().applyThisOnTheLeft(inonbasic);
+        // Rearrange S, the top `nb` rows of R and Q based on the new order of basic and non-basic variables
+        permute(Kb.asPermutation(), Kn.asPermutation());
     }
 
     /// Perform a cleanup procedure to remove residual round-off errors from the canonical form.
@@ -263,6 +304,11 @@ auto EchelonizerExtended::operator=(EchelonizerExtended other) -> EchelonizerExt
     return *this;
 }
 
+auto EchelonizerExtended::assign(const EchelonizerExtended& other) -> void
+{
+    pimpl->assign(*other.pimpl);
+}
+
 auto EchelonizerExtended::numVariables() const -> Index
 {
     return pimpl->Q.rows();
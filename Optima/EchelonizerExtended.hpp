@@ -62,6 +62,10 @@ public:
     /// Assign a EchelonizerExtended instance to this.
     auto operator=(EchelonizerExtended other) -> EchelonizerExtended&;
 
+    /// Assign another EchelonizerExtended instance to this reusing its memory.
+    /// No memory is allocated if the matrices in both have the same dimensions.
+    auto assign(const EchelonizerExtended& other) -> void;
+
     /// Return the number of variables.
     auto numVariables() const -> Index;
 
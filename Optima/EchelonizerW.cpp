@@ -17,12 +17,39 @@
 
 #include "EchelonizerW.hpp"
 
+// C++ includes
+#include <atomic>
+#include <memory>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/EchelonizerExtended.hpp>
 #include <Optima/Utils.hpp>
 
 namespace Optima {
+namespace {
+
+/// Return a new identifier for an echelon form of *W*, unique in the process.
+auto newRevision() -> Index
+{
+    static std::atomic<Index> counter(0);
+    return counter++;
+}
+
+} // namespace
+
+/// The echelon form of *Ax* together with the matrices *Ax* and *Ap* from which it was computed.
+struct EchelonFormAx
+{
+    /// The matrix Ax of the echelon form.
+    Matrix Ax;
+
+    /// The matrix Ap given with Ax.
+    Matrix Ap;
+
+    /// The echelonizer of matrix Ax alone.
+    EchelonizerExtended echelonizer;
+};
 
 struct EchelonizerW::Impl
 {
@@ -38,11 +65,37 @@ struct EchelonizerW::Impl
     /// The echelonizer of matrix Wx = [Ax; Jx]
     EchelonizerExtended echelonizer;
 
+    /// The echelon form of matrix Ax alone, kept to avoid echelonizing the same Ax again.
+    /// This is never modified after its computation, so that copies of this
+    /// object share it (a new one is computed instead when Ax or Ap changes).
+    std::shared_ptr<const EchelonFormAx> echelonformAx;
+
+    /// The identifier of the current echelon form of W (unique among all
+    /// EchelonizerW objects, so that a copy has the same identifier only
+    /// while its echelon form is the same).
+    Index revision = newRevision();
+
+    /// The order of the variables in the echelon form of W before the last update.
+    Indices Qprev;
+
     Impl(const MasterDims& dims)
     : dims(dims)
     {
         S.resize(dims.nw, dims.nx + dims.np);
         W.resize(dims.nw, dims.nx + dims.np);
+        Qprev.resize(dims.nx);
+    }
+
+    /// Assign another EchelonizerW::Impl object to this reusing its memory.
+    auto assign(const Impl& other) -> void
+    {
+        assert(dims.nx == other.dims.nx && dims.np == other.dims.np && dims.nw == other.dims.nw);
+        W = other.W;
+        S = other.S;
+        echelonizer.assign(other.echelonizer);
+        echelonformAx = other.echelonformAx;
+        revision = other.revision; // the echelon forms of W are now the same
+        Qprev = other.Qprev;
     }
 
     auto initialize(MatrixView Ax, MatrixView Ap) -> void
@@ -57,14 +110,33 @@ struct EchelonizerW::Impl
         assert(Ap.rows() == ny || ny == 0 || np == 0);
         assert(Ap.cols() == np || ny == 0 || np == 0);
 
-        // TODO: Implement a sort of memoization here to avoid echelonization of same Ax.
-        // If same as last time, instead of creating a new echelonizer, we call echelonizer.initialize(Ax)
-        // where EchelonizerExtended::initialize should figure out if same. Careful with echelon form that has
-        // been contaminated with round off errors (because there has been many basic swaps already).
-        echelonizer = EchelonizerExtended(Ax);
+        // If Ax and Ap are the same as in the last call, the echelonizer of
+        // Ax computed then is reused. Note that a copy of the echelonizer
+        // of Ax alone is restored, and not the current one, whose echelon
+        // form may have been contaminated with round-off errors after many
+        // basic swaps in the update calls.
+        revision = newRevision();
+
+        if(!echelonformAx || !isSameAxAp(Ax, Ap))
+            echelonformAx = std::make_shared<const EchelonFormAx>(EchelonFormAx{Ax, Ap, EchelonizerExtended(Ax)});
+
+        echelonizer = echelonformAx->echelonizer;
 
-        if(Ax.size()) W. topLeftCorner(ny, nx) = Ax;
-        if(Ap.size()) W.topRightCorner(ny, np) = Ap;
+        // The echelon form of Ax may have been computed by another
+        // EchelonizerW object (see setEchelonFormAx), so W is set here
+        if(echelonformAx->Ax.size()) W. topLeftCorner(ny, nx) = echelonformAx->Ax;
+        if(echelonformAx->Ap.size()) W.topRightCorner(ny, np) = echelonformAx->Ap;
+    }
+
+    /// Return true if given *Ax* and *Ap* are the same as those of the current echelon form of *Ax*.
+    auto isSameAxAp(MatrixView Ax, MatrixView Ap) const -> bool
+    {
+        const auto [nx, np, ny, nz, nw, nt] = dims;
+        const auto& Axprev = echelonformAx->Ax;
+        const auto& Apprev = echelonformAx->Ap;
+        const auto sameAx = Ax.size() == 0 || (Ax.rows() == ny && Ax.cols() == nx && Axprev.rows() == ny && Axprev.cols() == nx && Axprev == Ax);
+        const auto sameAp = Ap.size() == 0 || (Ap.rows() == ny && Ap.cols() == np && Apprev.rows() == ny && Apprev.cols() == np && Apprev == Ap);
+        return sameAx && sameAp;
     }
 
     auto update(MatrixView Ax, MatrixView Ap, MatrixView Jx, MatrixView Jp, VectorView weights) -> void
@@ -92,9 +164,15 @@ struct EchelonizerW::Impl
         if(Jx.size()) Wx.bottomRows(nz) = Jx;
         if(Jp.size()) Wp.bottomRows(nz) = Jp;
 
+        Qprev = echelonizer.Q();
+
         echelonizer.updateWithPriorityWeights(Jx, weights);
         echelonizer.cleanResidualRoundoffErrors();
 
+        // The echelon form changes only with Jx or with swaps of basic variables
+        if(nz > 0 || echelonizer.Q() != Qprev)
+            revision = newRevision();
+
         const auto nb = echelonizer.numBasicVariables();
         const auto nn = echelonizer.numNonBasicVariables();
 
@@ -137,7 +215,7 @@ struct EchelonizerW::Impl
         const auto jb  = jbn.head(nb);
         const auto jn  = jbn.tail(nn);
 
-        return {Rb, Sbn, Sbp, jb, jn};
+        return {Rb, Sbn, Sbp, jb, jn, revision};
     }
 };
 
@@ -152,6 +230,17 @@ EchelonizerW::EchelonizerW(const EchelonizerW& other)
 EchelonizerW::~EchelonizerW()
 {}
 
+auto EchelonizerW::operator=(EchelonizerW other) -> EchelonizerW&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto EchelonizerW::assign(const EchelonizerW& other) -> void
+{
+    pimpl->assign(*other.pimpl);
+}
+
 auto EchelonizerW::initialize(MatrixView Ax, MatrixView Ap) -> void
 {
     pimpl->initialize(Ax, Ap);
@@ -167,6 +256,16 @@ auto EchelonizerW::update(MatrixView Jx, MatrixView Jp, VectorView weights) -> v
     pimpl->update(Jx, Jp, weights);
 }
 
+auto EchelonizerW::echelonFormAx() const -> std::shared_ptr<const EchelonFormAx>
+{
+    return pimpl->echelonformAx;
+}
+
+auto EchelonizerW::setEchelonFormAx(const std::shared_ptr<const EchelonFormAx>& echelonform) -> void
+{
+    pimpl->echelonformAx = echelonform;
+}
+
 auto EchelonizerW::dims() const -> MasterDims
 {
     return pimpl->dims;
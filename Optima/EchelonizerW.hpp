@@ -27,6 +27,9 @@
 
 namespace Optima {
 
+/// The echelon form of matrix *Ax* computed in EchelonizerW::initialize (immutable).
+struct EchelonFormAx;
+
 /// Used to compute the echelon form of matrix *W = [Ax Ap; Jx Jp]*.
 class EchelonizerW
 {
@@ -47,7 +50,11 @@ public:
     virtual ~EchelonizerW();
 
     /// Assign a EchelonizerW object to this.
-    auto operator=(EchelonizerW other) -> EchelonizerW& = delete;
+    auto operator=(EchelonizerW other) -> EchelonizerW&;
+
+    /// Assign another EchelonizerW object to this reusing its memory.
+    /// No memory is allocated if the matrices in both have the same dimensions.
+    auto assign(const EchelonizerW& other) -> void;
 
     /// Initialize only once the *Ax* and *Ap* matrices in case these seldom change.
     auto initialize(MatrixView Ax, MatrixView Ap) -> void;
@@ -58,6 +65,15 @@ public:
     /// Update the echelon form of matrix *W* where only *Jx* and *Jp* have changed.
     auto update(MatrixView Jx, MatrixView Jp, VectorView weights) -> void;
 
+    /// Return the echelon form of *Ax* computed in the last call to @ref initialize.
+    /// This is immutable and shared by the copies of this object.
+    auto echelonFormAx() const -> std::shared_ptr<const EchelonFormAx>;
+
+    /// Set the echelon form of *Ax* to be reused in the next call to @ref initialize.
+    /// This allows an object that is not a copy of another to share its echelon
+    /// form of *Ax*, which is used if *Ax* and *Ap* are the same as before.
+    auto setEchelonFormAx(const std::shared_ptr<const EchelonFormAx>& echelonform) -> void;
+
     /// Return the dimensions of the master variables.
     auto dims() const -> MasterDims;
 
@@ -17,10 +17,14 @@
 
 #include "ErrorControl.hpp"
 
+// C++ includes
+#include <cmath>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/BacktrackSearch.hpp>
 #include <Optima/LineSearch.hpp>
+#include <Optima/Memory.hpp>
 
 namespace Optima {
 
@@ -32,54 +36,115 @@ struct ErrorControl::Impl
     /// The line-search algorithm to correct steps producing significant large errors.
     LineSearch linesearch;
 
+    /// The options for the line search operation.
+    LineSearchOptions options;
 
-    Impl(const MasterDims& dims)
-    : backtracksearch(dims), linesearch(dims)
-    {
-    }
+    /// The error at the start of the first step subject to error control.
+    double errorinitial = 0.0;
 
-    auto initialize(const MasterProblem& problem) -> void
-    {
-    }
+    /// True if the first step subject to error control has not been executed yet.
+    bool firststep = true;
+
+    /// The state produced by the Newton step before any correction.
+    MasterVector unewton;
+
+    /// The residual function evaluated at the state produced by the Newton step.
+    ResidualFunction Fnewton;
+
+    /// The residual errors evaluated at the state produced by the Newton step.
+    ResidualErrors Enewton;
 
-    auto isBacktrackSearchNeeded(const ResidualErrors& E)
+    Impl(const MasterDims& dims)
+    : backtracksearch(dims), linesearch(dims), unewton(dims), Fnewton(dims), Enewton(dims)
     {
-        return !std::isfinite(E.error);
     }
 
-    auto isLineSearchNeeded(const ResidualErrors& E)
+    auto setOptions(const Options& opts) -> void
     {
-        // return E.errorHasIncreasedSignificantly();
+        options = opts.linesearch;
+        backtracksearch.setOptions(opts);
+        linesearch.setOptions(opts);
+        auto rfoptions = opts.residualfunction;
+        rfoptions.concurrent = false; // Fnewton is only assigned, never evaluated
+        Fnewton.setOptions(rfoptions);
     }
 
-    auto executeBacktrackSearch(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
+    auto initialize(const MasterProblem& problem) -> void
     {
-
+        linesearch.initialize(problem);
+        Fnewton.initialize(problem);
+        Enewton.initialize(problem);
+        firststep = true;
     }
 
-    auto executeLineSearch(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
+    auto isBacktrackSearchNeeded(const ResidualFunction& F, const ResidualErrors& E) -> bool
     {
-
+        return !F.result().succeeded || !std::isfinite(E.error);
     }
 
-    auto isDescentDirection(MasterVectorView uo, MasterVectorView u, const ResidualFunction& F) -> bool
+    auto isLineSearchNeeded(double errorprev, const ResidualErrors& E) -> bool
     {
-        const auto Fm = F.result().Fm;
-        const auto slope = Fm.dot(u - uo);
-        return slope < 0.0;
+        const auto factorinitial = options.trigger_when_current_error_is_greater_than_initial_error_by_factor;
+        const auto factorprev = options.trigger_when_current_error_is_greater_than_previous_error_by_factor;
+        return E.error > factorprev * errorprev && E.error > factorinitial * errorinitial;
     }
 
     auto execute(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
     {
-        // error(!isDescentDirection(uo, u, F), "Currently, Optima cannot handle Newton steps that are not descent directions.");
-
-        // if(isBacktrackSearchNeeded(E)) {
-        //     backtracksearch.start(uo, u, F, E);
-        // }
-
-        // if(isLineSearchNeeded(E)) {
-        //     linesearch.start(uo, u, F, E);
-        // }
+        const auto errorprev = E.error;
+
+        if(firststep)
+        {
+            errorinitial = errorprev;
+            firststep = false;
+        }
+
+        // Save the evaluated state of F and E at uo, whose derivatives are
+        // used in the residual-only evaluations of the trial states below.
+        F.checkpoint();
+        E.checkpoint();
+
+        F.update(u);
+        E.update(u, F);
+
+        const auto backtrack = isBacktrackSearchNeeded(F, E);
+
+        if(!backtrack && !isLineSearchNeeded(errorprev, E))
+            return; // the common case in which the new state u is accepted as is
+
+        // Keep the evaluation at the Newton step in case it is taken as is below.
+        if(!backtrack)
+        {
+            EigenMallocScope malloc(true); // this allocates memory only if the rank of W has changed
+            Fnewton.assign(F);
+            Enewton.assign(E);
+        }
+
+        F.restore();
+        E.restore();
+
+        unewton = u;
+
+        // If the backtrack search finds no trial state with finite error, u is
+        // still the Newton step, along which the line search is then performed.
+        const auto backtracked = backtrack && backtracksearch.start(uo, u, F, E);
+
+        if(!backtracked || isLineSearchNeeded(errorprev, E))
+            linesearch.start(uo, u, F, E);
+
+        // Evaluate F and E at the accepted state, now with Jacobian evaluations.
+        F.update(u);
+        E.update(u, F);
+
+        // Take the Newton step as is if the line search could not decrease
+        // the error. Otherwise, a sequence of negligible steps could follow.
+        if(!backtrack && !(E.error < errorprev))
+        {
+            EigenMallocScope malloc(true); // this allocates memory only if the rank of W has changed
+            u = unewton;
+            F.assign(Fnewton);
+            E.assign(Enewton);
+        }
     }
 };
 
@@ -100,6 +165,11 @@ auto ErrorControl::operator=(ErrorControl other) -> ErrorControl&
     return *this;
 }
 
+auto ErrorControl::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
 auto ErrorControl::initialize(const MasterProblem& problem) -> void
 {
     pimpl->initialize(problem);
@@ -22,6 +22,7 @@
 
 // Optima includes
 #include <Optima/MasterVector.hpp>
+#include <Optima/Options.hpp>
 #include <Optima/ResidualErrors.hpp>
 #include <Optima/ResidualFunction.hpp>
 
@@ -48,10 +49,15 @@ public:
     /// Assign a ErrorControl object to this.
     auto operator=(ErrorControl other) -> ErrorControl&;
 
+    /// Set the options of this ErrorControl object.
+    auto setOptions(const Options& options) -> void;
+
     /// Initialize this ErrorControl object once at the start of the optimization calculation.
     auto initialize(const MasterProblem& problem) -> void;
 
     /// Execute the error control operation to potentially decrease error level.
+    /// On entry, *F* and *E* must be evaluated at *uo*. On exit, *u* is the
+    /// accepted state and *F* and *E* are evaluated at it (with Jacobian).
     auto execute(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void;
 };
 
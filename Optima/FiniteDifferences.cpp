@@ -0,0 +1,363 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "FiniteDifferences.hpp"
+
+// C++ includes
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+namespace {
+
+/// The sparsity pattern of a matrix together with the groups of its structurally orthogonal columns.
+struct ColoredPattern
+{
+    /// The indices of the structurally non-zero rows in each column.
+    std::vector<std::vector<Index>> rows;
+
+    /// The indices of the columns in each color group.
+    std::vector<std::vector<Index>> groups;
+};
+
+/// Return the colored pattern of a matrix whose columns are all dense and perturbed one at a time.
+auto denseColoredPattern(Index m, Index n) -> ColoredPattern
+{
+    ColoredPattern res;
+    res.rows.resize(n);
+    res.groups.resize(n);
+    for(auto j = 0; j < n; ++j)
+    {
+        res.rows[j].resize(m);
+        for(auto i = 0; i < m; ++i)
+            res.rows[j][i] = i;
+        res.groups[j] = { j };
+    }
+    return res;
+}
+
+/// Return the colored pattern of a matrix with given sparsity pattern.
+auto sparseColoredPattern(MatrixView pattern) -> ColoredPattern
+{
+    const Index m = pattern.rows();
+    const Index n = pattern.cols();
+    const auto colors = colorColumns(pattern);
+    const Index ncolors = n ? colors.maxCoeff() + 1 : 0;
+
+    ColoredPattern res;
+    res.rows.resize(n);
+    res.groups.resize(ncolors);
+    for(auto j = 0; j < n; ++j)
+    {
+        for(auto i = 0; i < m; ++i)
+            if(pattern(i, j) != 0.0)
+                res.rows[j].push_back(i);
+        res.groups[colors[j]].push_back(j);
+    }
+    return res;
+}
+
+/// Return the finite difference step for a variable with given value.
+auto step(double x) -> double
+{
+    static const auto sqrteps = std::sqrt(std::numeric_limits<double>::epsilon());
+    const auto xh = x + sqrteps * std::max(1.0, std::abs(x));
+    return xh - x; // ensure the step is exactly representable
+}
+
+/// Compute the columns of a Jacobian matrix with forward differences, perturbing each color group at once.
+/// @param colored The colored pattern of the Jacobian matrix.
+/// @param x The point at which the Jacobian matrix is computed.
+/// @param v0 The value of the differentiated vector function at *x*.
+/// @param eval The function evaluating the differentiated vector function at a perturbed point.
+/// @param[out] J The computed Jacobian matrix (its entries outside the pattern are left untouched).
+/// @return `true` if all evaluations of the vector function succeeded.
+template<typename Eval>
+auto forwardDifferences(const ColoredPattern& colored, VectorView x, VectorView v0, const Eval& eval, MatrixRef J) -> bool
+{
+    Vector xh = x;
+    Vector vh(v0.size());
+    Vector h(x.size());
+    for(const auto& group : colored.groups)
+    {
+        for(auto j : group)
+        {
+            h[j] = step(x[j]);
+            xh[j] = x[j] + h[j];
+        }
+        if(!eval(xh, vh))
+            return false;
+        for(auto j : group)
+        {
+            for(auto i : colored.rows[j])
+                J(i, j) = (vh[i] - v0[i]) / h[j];
+            xh[j] = x[j];
+        }
+    }
+    return true;
+}
+
+/// Used to store the colored pattern of a Jacobian matrix shared among copies of a finite difference function.
+struct SharedPattern
+{
+    /// The sparsity pattern given by the user (empty if it needs to be detected).
+    Matrix pattern;
+
+    /// True if the Jacobian matrix is symmetric (i.e., a Hessian matrix).
+    bool symmetric = false;
+
+    /// The colored pattern of the Jacobian matrix once initialized.
+    ColoredPattern colored;
+
+    /// True if the colored pattern has been initialized.
+    bool initialized = false;
+
+    /// The mutex guarding the initialization of the colored pattern.
+    std::mutex mutex;
+
+    /// Construct a SharedPattern object.
+    SharedPattern(MatrixView pattern, bool symmetric)
+    : pattern(pattern), symmetric(symmetric) {}
+
+    /// Return the colored pattern, initializing it at the first call.
+    /// @param x The point at which the pattern is detected if not given.
+    /// @param v0 The value of the differentiated vector function at *x*.
+    /// @param eval The function evaluating the differentiated vector function at a perturbed point.
+    /// @return A pointer to the colored pattern, or null if its detection failed.
+    template<typename Eval>
+    auto get(VectorView x, VectorView v0, const Eval& eval) -> const ColoredPattern*
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(initialized)
+            return &colored;
+        const auto m = v0.size();
+        const auto n = x.size();
+        Matrix P;
+        if(pattern.size())
+        {
+            error(pattern.rows() != m || pattern.cols() != n, "Could not compute finite difference derivatives. "
+                "The given sparsity pattern has dimensions ", pattern.rows(), " by ", pattern.cols(), " but expected ", m, " by ", n, ".");
+            P = pattern.cwiseAbs();
+        }
+        else
+        {
+            // Entries that happen to be zero at x (e.g., fxx(0, 1) = 4*x0*x1
+            // at x = 0) are also detected at a perturbed point, or all
+            // entries are considered non-zero if the evaluation fails there.
+            const auto dense = denseColoredPattern(m, n);
+            P = zeros(m, n);
+            if(!forwardDifferences(dense, x, v0, eval, P))
+                return nullptr;
+            const Vector xp = perturbed(x);
+            Vector vp(m);
+            Matrix Pp = zeros(m, n);
+            if(eval(xp, vp) && forwardDifferences(dense, xp, vp, eval, Pp))
+                P = P.cwiseAbs() + Pp.cwiseAbs();
+            else P.fill(1.0);
+        }
+        if(symmetric)
+            P += P.transpose().eval();
+        colored = sparseColoredPattern(P);
+        initialized = true;
+        return &colored;
+    }
+};
+
+/// Replace the entries of a square matrix by the average of the matrix and its transpose.
+auto symmetrize(MatrixRef A) -> void
+{
+    const auto n = A.rows();
+    for(auto i = 0; i < n; ++i)
+        for(auto j = i + 1; j < n; ++j)
+            A(i, j) = A(j, i) = 0.5 * (A(i, j) + A(j, i));
+}
+
+auto finiteDifferenceObjectiveFunctionAux(const ObjectiveFunction& f, std::shared_ptr<SharedPattern> shared) -> ObjectiveFunction
+{
+    error(!f.initialized(), "Could not create a finite difference objective function from a non-initialized objective function.");
+
+    return ObjectiveFunction([=](ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions opts)
+    {
+        const ObjectiveOptions gopts{{false, false}, opts.ibasicvars};
+
+        f(res, x, p, gopts);
+
+        if(!res.succeeded || (!opts.eval.fxx && !opts.eval.fxp))
+            return;
+
+        const auto nx = x.size();
+        const auto np = p.size();
+
+        ObjectiveResult aux(nx, np);
+
+        if(opts.eval.fxx)
+        {
+            auto gradient = [&](VectorView xh, VectorRef gh)
+            {
+                aux.fx.setZero(); // only the gradient is used (see ObjectiveFunction::operator())
+                f(aux, xh, p, gopts);
+                gh = aux.fx;
+                return aux.succeeded;
+            };
+
+            const auto colored = shared->get(x, res.fx, gradient);
+
+            if(!colored || !forwardDifferences(*colored, x, res.fx, gradient, res.fxx))
+            {
+                res.succeeded = false;
+                return;
+            }
+
+            symmetrize(res.fxx);
+        }
+
+        if(opts.eval.fxp && np)
+        {
+            auto gradient = [&](VectorView ph, VectorRef gh)
+            {
+                aux.fx.setZero();
+                f(aux, x, ph, gopts);
+                gh = aux.fx;
+                return aux.succeeded;
+            };
+
+            if(!forwardDifferences(denseColoredPattern(nx, np), p, res.fx, gradient, res.fxp))
+                res.succeeded = false;
+        }
+    });
+}
+
+auto finiteDifferenceConstraintFunctionAux(const ConstraintFunction& c, std::shared_ptr<SharedPattern> shared) -> ConstraintFunction
+{
+    error(!c.initialized(), "Could not create a finite difference constraint function from a non-initialized constraint function.");
+
+    return ConstraintFunction([=](ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts)
+    {
+        const ConstraintOptions vopts{{false, false}, opts.ibasicvars};
+
+        c(res, x, p, vopts);
+
+        const auto nc = res.val.size();
+
+        if(!res.succeeded || nc == 0 || (!opts.eval.ddx && !opts.eval.ddp))
+            return;
+
+        const auto nx = x.size();
+        const auto np = p.size();
+
+        ConstraintResult aux(nc, nx, np);
+
+        if(opts.eval.ddx)
+        {
+            auto value = [&](VectorView xh, VectorRef vh)
+            {
+                aux.val.setZero(); // only the value is used (see ConstraintFunction::operator())
+                c(aux, xh, p, vopts);
+                vh = aux.val;
+                return aux.succeeded;
+            };
+
+            const auto colored = shared->get(x, res.val, value);
+
+            if(!colored || !forwardDifferences(*colored, x, res.val, value, res.ddx))
+            {
+                res.succeeded = false;
+                return;
+            }
+        }
+
+        if(opts.eval.ddp && np)
+        {
+            auto value = [&](VectorView ph, VectorRef vh)
+            {
+                aux.val.setZero();
+                c(aux, x, ph, vopts);
+                vh = aux.val;
+                return aux.succeeded;
+            };
+
+            if(!forwardDifferences(denseColoredPattern(nc, np), p, res.val, value, res.ddp))
+                res.succeeded = false;
+        }
+    });
+}
+
+} // namespace
+
+auto colorColumns(MatrixView pattern) -> Indices
+{
+    const Index m = pattern.rows();
+    const Index n = pattern.cols();
+
+    // The columns with a structural non-zero entry in each row
+    std::vector<std::vector<Index>> colsinrow(m);
+    for(auto j = 0; j < n; ++j)
+        for(auto i = 0; i < m; ++i)
+            if(pattern(i, j) != 0.0)
+                colsinrow[i].push_back(j);
+
+    Indices colors = Indices::Constant(n, -1);
+
+    // The column for which each color was last marked as forbidden
+    std::vector<Index> forbidden(n, -1);
+
+    for(auto j = 0; j < n; ++j)
+    {
+        for(auto i = 0; i < m; ++i)
+            if(pattern(i, j) != 0.0)
+                for(auto k : colsinrow[i])
+                    if(colors[k] >= 0)
+                        forbidden[colors[k]] = j;
+        Index color = 0;
+        while(forbidden[color] == j)
+            ++color;
+        colors[j] = color;
+    }
+
+    return colors;
+}
+
+auto finiteDifferenceObjectiveFunction(const ObjectiveFunction& f) -> ObjectiveFunction
+{
+    return finiteDifferenceObjectiveFunctionAux(f, std::make_shared<SharedPattern>(Matrix(), true));
+}
+
+auto finiteDifferenceObjectiveFunction(const ObjectiveFunction& f, MatrixView pattern) -> ObjectiveFunction
+{
+    error(pattern.size() == 0, "Could not create a finite difference objective function with an empty sparsity pattern.");
+    return finiteDifferenceObjectiveFunctionAux(f, std::make_shared<SharedPattern>(pattern, true));
+}
+
+auto finiteDifferenceConstraintFunction(const ConstraintFunction& c) -> ConstraintFunction
+{
+    return finiteDifferenceConstraintFunctionAux(c, std::make_shared<SharedPattern>(Matrix(), false));
+}
+
+auto finiteDifferenceConstraintFunction(const ConstraintFunction& c, MatrixView pattern) -> ConstraintFunction
+{
+    error(pattern.size() == 0, "Could not create a finite difference constraint function with an empty sparsity pattern.");
+    return finiteDifferenceConstraintFunctionAux(c, std::make_shared<SharedPattern>(pattern, false));
+}
+
+} // namespace Optima
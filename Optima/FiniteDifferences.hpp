@@ -0,0 +1,66 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/ConstraintFunction.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/ObjectiveFunction.hpp>
+
+namespace Optima {
+
+/// Return the colors of the columns of a sparse matrix so that columns of the same color share no non-zero row.
+/// Columns of the same color are structurally orthogonal and can therefore be
+/// perturbed simultaneously when computing the matrix with finite differences.
+/// The coloring is computed with a greedy Curtis-Powell-Reid strategy.
+/// @param pattern The sparsity pattern of the matrix (non-zero entries denote structural non-zeros).
+auto colorColumns(MatrixView pattern) -> Indices;
+
+/// Return an objective function whose derivatives *fxx* and *fxp* are computed with finite differences.
+/// The given objective function needs to evaluate only *f* and *fx*. The
+/// Hessian matrix *fxx* is computed with forward differences of *fx*,
+/// perturbing all structurally orthogonal columns of *fxx* at once, so that
+/// the number of gradient evaluations equals the number of colors rather than
+/// the number of variables. The sparsity pattern of *fxx* is detected with
+/// dense finite differences at the first evaluation, at the given point and
+/// at a perturbed point, so that entries that happen to be zero at the given
+/// point are not missed. Entries that are zero at both points are still
+/// missed, and the sparsity pattern must then be given instead.
+/// @param f The objective function evaluating *f* and *fx*.
+auto finiteDifferenceObjectiveFunction(const ObjectiveFunction& f) -> ObjectiveFunction;
+
+/// Return an objective function whose derivatives *fxx* and *fxp* are computed with finite differences.
+/// @param f The objective function evaluating *f* and *fx*.
+/// @param pattern The sparsity pattern of the Hessian matrix *fxx* with dimension *nx* by *nx*.
+auto finiteDifferenceObjectiveFunction(const ObjectiveFunction& f, MatrixView pattern) -> ObjectiveFunction;
+
+/// Return a constraint function whose derivatives *ddx* and *ddp* are computed with finite differences.
+/// The given constraint function needs to evaluate only *c(x, p)*. The
+/// Jacobian matrix *ddx* is computed with colored forward differences as in
+/// @ref finiteDifferenceObjectiveFunction, with its sparsity pattern detected
+/// at the first evaluation (at the given point and at a perturbed point).
+/// @param c The constraint function evaluating *c(x, p)*.
+auto finiteDifferenceConstraintFunction(const ConstraintFunction& c) -> ConstraintFunction;
+
+/// Return a constraint function whose derivatives *ddx* and *ddp* are computed with finite differences.
+/// @param c The constraint function evaluating *c(x, p)*.
+/// @param pattern The sparsity pattern of the Jacobian matrix *ddx* with dimension *nc* by *nx*.
+auto finiteDifferenceConstraintFunction(const ConstraintFunction& c, MatrixView pattern) -> ConstraintFunction;
+
+} // namespace Optima
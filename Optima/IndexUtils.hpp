@@ -46,7 +46,8 @@ inline auto contains(Index i, IndicesView indices) -> bool
 /// @param predicate The predicate function that returns true if an index should be in *group1*.
 /// @return The number of indices in *group1*
 /// @see moveIntersectionRight
-inline auto moveLeftIf(IndicesRef base, const std::function<bool(Index)>& predicate) -> Index
+template<typename Predicate>
+auto moveLeftIf(IndicesRef base, Predicate&& predicate) -> Index
 {
     return std::partition(base.begin(), base.end(), predicate) - base.begin();
 }
@@ -56,7 +57,8 @@ inline auto moveLeftIf(IndicesRef base, const std::function<bool(Index)>& predic
 /// @param predicate The predicate function that returns true if an index should be in *group1*.
 /// @return The number of indices in *group1*
 /// @see moveIntersectionRight
-inline auto stableMoveLeftIf(IndicesRef base, const std::function<bool(Index)>& predicate) -> Index
+template<typename Predicate>
+auto stableMoveLeftIf(IndicesRef base, Predicate&& predicate) -> Index
 {
     return std::stable_partition(base.begin(), base.end(), predicate) - base.begin();
 }
@@ -76,7 +78,8 @@ inline auto moveIntersectionLeft(IndicesRef base, IndicesView p) -> Index
 /// @param predicate The predicate function that returns true if an index should be in *group2*.
 /// @return The number of indices in *group1*
 /// @see moveIntersectionRight
-inline auto moveRightIf(IndicesRef base, const std::function<bool(Index)>& predicate) -> Index
+template<typename Predicate>
+auto moveRightIf(IndicesRef base, Predicate&& predicate) -> Index
 {
     return std::partition(base.begin(), base.end(), [&](Index i) { return !predicate(i); }) - base.begin();
 }
@@ -86,7 +89,8 @@ inline auto moveRightIf(IndicesRef base, const std::function<bool(Index)>& predi
 /// @param predicate The predicate function that returns true if an index should be in *group2*.
 /// @return The number of indices in *group1*
 /// @see moveIntersectionRight
-inline auto stableMoveRightIf(IndicesRef base, const std::function<bool(Index)>& predicate) -> Index
+template<typename Predicate>
+auto stableMoveRightIf(IndicesRef base, Predicate&& predicate) -> Index
 {
     return std::stable_partition(base.begin(), base.end(), [&](Index i) { return !predicate(i); }) - base.begin();
 }
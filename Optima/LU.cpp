@@ -20,9 +20,6 @@
 // C++ includes
 #include <cassert>
 
-// Eigen includes
-#include <Optima/deps/eigen3/Eigen/src/LU/FullPivLU.h>
-
 // Optima includes
 #include <Optima/Macros.hpp>
 
@@ -35,12 +32,25 @@ struct LU::Impl
     // singular matrices. Using a partial pivoting scheme via PartialPivLU
     // would need to be combined with a search for linearly dependent rows in
     // the produced upper triangular matrix U.
+    //----------------------------------------------------------------------
+    // The decomposition below follows the one in Eigen::FullPivLU, but its
+    // storage is reserved for the largest matrix to be decomposed, so that
+    // matrices of varying sizes are decomposed without memory allocation.
     //======================================================================
 
-    /// The base LU solver from Eigen library.
-    Eigen::FullPivLU<Matrix> lu;
+    /// The dimension of the last decomposed matrix.
+    Index n = 0;
+
+    /// The matrix containing the lower and upper triangular factors (only its top-left `n x n` block).
+    Matrix LUw;
+
+    /// The row transpositions in the decomposition (only its first `n` entries).
+    Indices rowtransp;
 
-    /// The workspace for modified matrix U.
+    /// The column transpositions in the decomposition (only its first `n` entries).
+    Indices coltransp;
+
+    /// The workspace for modified matrix U (only its top-left `n x n` block).
     Matrix U;
 
     /// The flags that indicate if an equation is linearly independent (non-zero value).
@@ -53,6 +63,12 @@ struct LU::Impl
     Impl()
     {}
 
+    /// Construct an Impl object with storage for matrices with up to given dimension.
+    Impl(Index nmax)
+    {
+        reserve(nmax);
+    }
+
     /// Construct an Impl object with given matrix.
     Impl(MatrixView A)
     {
@@ -62,16 +78,88 @@ struct LU::Impl
     /// Return true if empty.
     auto empty() const -> bool
     {
-        return lu.matrixLU().size() == 0;
+        return n == 0;
+    }
+
+    /// Ensure the storage is enough for matrices with up to given dimension.
+    auto reserve(Index nmax) -> void
+    {
+        if(LUw.rows() >= nmax)
+            return;
+        LUw.resize(nmax, nmax);
+        U.resize(nmax, nmax);
+        rowtransp.resize(nmax);
+        coltransp.resize(nmax);
+        is_li.resize(nmax);
     }
 
     /// Compute the LU decomposition of the given matrix.
     auto decompose(MatrixView A) -> void
     {
         const auto m = A.rows();
-        const auto n = A.cols();
-        assert(n == m);
-        lu.compute(A);
+        assert(A.cols() == m);
+
+        reserve(m);
+        n = m;
+
+        auto M = LUw.topLeftCorner(n, n);
+        M = A;
+
+        for(Index k = 0; k < n; ++k)
+        {
+            // Find the entry with largest magnitude in the bottom-right corner (as in Eigen::FullPivLU)
+            Index i, j;
+            const auto biggest = M.bottomRightCorner(n - k, n - k).cwiseAbs().maxCoeff(&i, &j);
+
+            // The remaining rows and columns are zero, so stop and do not permute them
+            if(biggest == 0.0)
+            {
+                for(Index l = k; l < n; ++l)
+                    rowtransp[l] = coltransp[l] = l;
+                break;
+            }
+
+            rowtransp[k] = i += k;
+            coltransp[k] = j += k;
+
+            if(k != i) M.row(k).swap(M.row(i));
+            if(k != j) M.col(k).swap(M.col(j));
+
+            if(k < n - 1)
+            {
+                M.col(k).tail(n - k - 1) /= M(k, k);
+                M.bottomRightCorner(n - k - 1, n - k - 1).noalias() -= M.col(k).tail(n - k - 1) * M.row(k).tail(n - k - 1);
+            }
+        }
+    }
+
+    /// Apply the row permutation matrix *P* in *PAQ = LU* on the left of the given vector.
+    template<typename VectorType>
+    auto applyP(VectorType& x) const -> void
+    {
+        for(Index k = 0; k < n; ++k)
+            std::swap(x[k], x[rowtransp[k]]);
+    }
+
+    /// Apply the column permutation matrix *Q* in *PAQ = LU* on the left of the given vector.
+    template<typename VectorType>
+    auto applyQ(VectorType& x) const -> void
+    {
+        for(Index k = n - 1; k >= 0; --k)
+            std::swap(x[k], x[coltransp[k]]);
+    }
+
+    /// Return the permutation matrix corresponding to given transpositions (applied in the given order).
+    auto permutation(IndicesView transp, bool reversed) const -> PermutationMatrix
+    {
+        PermutationMatrix P(n);
+        P.setIdentity();
+        for(Index l = 0; l < n; ++l)
+        {
+            const auto k = reversed ? n - 1 - l : l;
+            P.applyTranspositionOnTheRight(k, transp[k]);
+        }
+        return P;
     }
 
     /// Solve the linear system `Ax = b` using the LU decomposition obtained with @ref decompose.
@@ -84,21 +172,17 @@ struct LU::Impl
     /// Solve the linear system `Ax = b` using the LU decomposition obtained with @ref decompose.
     auto solve(VectorRef x) -> void
     {
-        const auto& n  = lu.rows();
-        const auto& P  = lu.permutationP();
-        const auto& Q  = lu.permutationQ();
-        const auto& M  = lu.matrixLU();
-        const auto& Lv = M.triangularView<Eigen::UnitLower>();
-        const auto& Uv = U.triangularView<Eigen::Upper>();
+        const auto Lv = LUw.topLeftCorner(n, n).triangularView<Eigen::UnitLower>();
+        const auto Uv = U.topLeftCorner(n, n).triangularView<Eigen::Upper>();
 
         assert(n == x.rows());
 
-        P.applyThisOnTheLeft(x);
-        x = Lv.solve(x);
+        applyP(x);
+        Lv.solveInPlace(x);
         assembleU(x);
-        x = Uv.solve(x);
-        Q.applyThisOnTheLeft(x);
-        Q.applyThisOnTheLeft(is_li);
+        Uv.solveInPlace(x);
+        applyQ(x);
+        applyQ(is_li);
 
         // TODO; In LU, x should have +inf or -inf to indicate extremely large steps and their directions. Then a line search would be used to find a reasonable step length/
     }
@@ -106,12 +190,10 @@ struct LU::Impl
     /// Assemble the U matrix with given y, where y is the solution of L*y = P*b.
     auto assembleU(VectorRef y) -> void
     {
-        const auto n = lu.rows();
-
-        U.resize(n, n);
-        U = lu.matrixLU();
+        auto U = this->U.topLeftCorner(n, n);
+        U = LUw.topLeftCorner(n, n);
 
-        is_li.setOnes(n); // set all equations as linearly independent to start with
+        is_li.head(n).fill(1); // set all equations as linearly independent to start with
 
         const auto D = U.diagonal().cwiseAbs();
         const auto eps = std::numeric_limits<double>::epsilon();
@@ -147,6 +229,10 @@ LU::LU()
 : pimpl(new Impl())
 {}
 
+LU::LU(Index nmax)
+: pimpl(new Impl(nmax))
+{}
+
 LU::LU(const LU& other)
 : pimpl(new Impl(*other.pimpl))
 {}
@@ -188,17 +274,17 @@ auto LU::rank() const -> Index
 
 auto LU::matrixLU() const -> MatrixView
 {
-    return pimpl->lu.matrixLU();
+    return pimpl->LUw.topLeftCorner(pimpl->n, pimpl->n);
 }
 
 auto LU::P() const -> PermutationMatrix
 {
-    return pimpl->lu.permutationP();
+    return pimpl->permutation(pimpl->rowtransp, true);
 }
 
 auto LU::Q() const -> PermutationMatrix
 {
-    return pimpl->lu.permutationP();
+    return pimpl->permutation(pimpl->coltransp, false);
 }
 
 } // namespace Optima
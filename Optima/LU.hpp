@@ -32,6 +32,10 @@ struct LU
     /// Construct a default LU object.
     LU();
 
+    /// Construct an LU object with storage for matrices with up to given dimension.
+    /// No memory is then allocated when decomposing these matrices.
+    explicit LU(Index nmax);
+
     /// Construct a copy of an LU object.
     LU(const LU& other);
 
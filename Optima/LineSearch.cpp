@@ -17,38 +17,102 @@
 
 #include "LineSearch.hpp"
 
+// C++ includes
+#include <cmath>
+#include <vector>
+
 // Optima includes
 #include <Optima/Exception.hpp>
+#include <Optima/Memory.hpp>
+#include <Optima/TaskPool.hpp>
 #include <Optima/Utils.hpp>
 
 namespace Optima {
 
 struct LineSearch::Impl
 {
+    /// The dimensions of the master variables.
+    const MasterDims dims;
+
     /// The trial state of u = (x, p, y, z) during the line search minimization.
     MasterVector utrial;
 
     /// The options for the line search minimization.
     LineSearchOptions options;
 
+    /// The token checked before the evaluation of each trial state to stop the line search if the calculation has been cancelled.
+    CancellationToken cancellation;
+
+    /// The options for the residual functions of the trial states in the parallel mode.
+    ResidualFunctionOptions rfoptions;
+
+    /// The trial states of u = (x, p, y, z) in the parallel mode.
+    std::vector<MasterVector> utrials;
+
+    /// The residual functions evaluated at the trial states in the parallel mode.
+    /// These are assigned the state of the residual function at the start of
+    /// each line search, which provides the derivatives and the echelon form of
+    /// *W* used in the residual-only evaluations of the trial states.
+    std::vector<ResidualFunction> Ftrials;
+
+    /// The residual errors evaluated at the trial states in the parallel mode.
+    std::vector<ResidualErrors> Etrials;
+
+    /// The errors at the trial states in the parallel mode.
+    std::vector<double> errors;
+
+    /// The worker threads for the evaluation of the trial states in the parallel mode.
+    TaskPool pool;
+
     Impl(const MasterDims& dims)
-    : utrial(dims)
+    : dims(dims), utrial(dims)
+    {
+    }
+
+    auto setOptions(const Options& opts) -> void
     {
+        options = opts.linesearch;
+        cancellation = opts.cancellation;
+        rfoptions = opts.residualfunction;
+        rfoptions.concurrent = false; // the trial states are already evaluated concurrently
+        const auto parallel = options.parallel > 1 && opts.residualfunction.concurrent; // only if the functions can be evaluated at the same time
+        const Index ntrials = parallel ? options.parallel : 0;
+        const Index nthreads = ntrials > 1 ? ntrials - 1 : 0; // the calling thread evaluates one trial state
+        if(pool.size() != nthreads)
+            pool = TaskPool(nthreads);
+        utrials.resize(ntrials, MasterVector(dims));
+        errors.resize(ntrials);
+        Ftrials.resize(ntrials, ResidualFunction(dims));
+        Etrials.resize(ntrials, ResidualErrors(dims));
+        for(auto& Ftrial : Ftrials)
+            Ftrial.setOptions(rfoptions);
     }
 
-    auto setOptions(const LineSearchOptions opts) -> void
+    auto initialize(const MasterProblem& problem) -> void
     {
-        options = opts;
+        for(auto& Ftrial : Ftrials)
+            Ftrial.initialize(problem);
+        for(auto& Etrial : Etrials)
+            Etrial.initialize(problem);
     }
 
     auto start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
+    {
+        if(!Ftrials.empty())
+            startParallel(uo, u, F, E);
+        else startSequential(uo, u, F, E);
+    }
+
+    auto startSequential(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
     {
         auto phi = [&](auto alpha)
         {
+            if(cancellation.cancelled())
+                return infinity(); // the remaining iterations of the minimization are then cheap
             utrial = uo*(1 - alpha) + alpha*u;
-            F.update(utrial);
+            F.updateSkipJacobian(utrial);
             E.update(utrial, F);
-            return E.error;
+            return F.result().succeeded && std::isfinite(E.error) ? E.error : infinity();
         };
 
         const auto tol = options.tolerance;
@@ -57,8 +121,56 @@ struct LineSearch::Impl
         // Minimize phi(alpha) along the path from uo to u for alpha in [0, 1].
         const auto alphamin = minimizeBrent(phi, 0.0, 1.0, tol, maxiters);
 
+        if(cancellation.cancelled()) // the error at alphamin may not have been evaluated
+            return;
+
         u = uo*(1 - alphamin) + alphamin*u; // using uo + alpha*(u - uo) is sensitive to round-off errors!
     }
+
+    /// Evaluate the errors at the step lengths `alpha = k/n` (k = 1, ..., n)
+    /// simultaneously and select the one with least error. Each trial state is
+    /// evaluated with its own residual function and errors, allocated in
+    /// setOptions and initialize, and so *F* and *E* are not changed here.
+    auto startParallel(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& /*E*/) -> void
+    {
+        const Index ntrials = Ftrials.size();
+
+        assert(ntrials == static_cast<Index>(options.parallel));
+
+        EigenMallocScope malloc(true); // the assignments of F below allocate memory if the rank of W has changed
+
+        auto trial = [&](Index k)
+        {
+            if(cancellation.cancelled())
+            {
+                errors[k] = infinity();
+                return;
+            }
+            const auto alpha = double(k + 1)/ntrials;
+            utrials[k] = uo*(1 - alpha) + alpha*u;
+            Ftrials[k].assign(F);
+            Ftrials[k].updateSkipJacobian(utrials[k]);
+            Etrials[k].update(utrials[k], Ftrials[k]);
+            errors[k] = Ftrials[k].result().succeeded && std::isfinite(Etrials[k].error) ? Etrials[k].error : infinity();
+        };
+
+        for(Index k = 0; k < ntrials - 1; ++k)
+            pool.enqueue([&, k] { trial(k); });
+        try { trial(ntrials - 1); }
+        catch(...)
+        {
+            pool.wait(); // the other trials refer to objects in this scope and must finish before leaving it
+            throw;
+        }
+        pool.wait();
+
+        Index kmin = ntrials - 1; // prefer the full step if no trial state has a finite error (e.g., if the calculation was cancelled)
+        for(Index k = 0; k < ntrials; ++k)
+            if(errors[k] < errors[kmin])
+                kmin = k;
+
+        u = utrials[kmin];
+    }
 };
 
 LineSearch::LineSearch(const MasterDims& dims)
@@ -78,11 +190,16 @@ auto LineSearch::operator=(LineSearch other) -> LineSearch&
     return *this;
 }
 
-auto LineSearch::setOptions(const LineSearchOptions& options) -> void
+auto LineSearch::setOptions(const Options& options) -> void
 {
     pimpl->setOptions(options);
 }
 
+auto LineSearch::initialize(const MasterProblem& problem) -> void
+{
+    pimpl->initialize(problem);
+}
+
 auto LineSearch::start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void
 {
     pimpl->start(uo, u, F, E);
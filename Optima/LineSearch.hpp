@@ -21,8 +21,9 @@
 #include <memory>
 
 // Optima includes
-#include <Optima/LineSearchOptions.hpp>
+#include <Optima/MasterProblem.hpp>
 #include <Optima/MasterVector.hpp>
+#include <Optima/Options.hpp>
 #include <Optima/ResidualErrors.hpp>
 #include <Optima/ResidualFunction.hpp>
 
@@ -50,9 +51,20 @@ public:
     auto operator=(LineSearch other) -> LineSearch&;
 
     /// Set the options of this LineSearch object.
-    auto setOptions(const LineSearchOptions& options) -> void;
+    /// The options for the evaluation of the residual function are used in the
+    /// parallel mode, in which the trial states are evaluated with residual
+    /// functions of their own. The line search stops evaluating trial states once
+    /// Options::cancellation is cancelled, in which case *u* is left unchanged
+    /// (or the full step in the parallel mode).
+    auto setOptions(const Options& options) -> void;
 
-    /// Start the backtrack search until the error is no longer infinity.
+    /// Initialize this LineSearch object once before line search minimization operations.
+    /// In the parallel mode, this initializes the residual functions and errors
+    /// of the trial states, which are thus allocated once.
+    auto initialize(const MasterProblem& problem) -> void;
+
+    /// Start the line search minimization of the error along the step from *uo* to *u*.
+    /// The trial states are evaluated with @ref ResidualFunction::updateSkipJacobian.
     auto start(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> void;
 };
 
@@ -28,6 +28,14 @@ struct LineSearchOptions
     /// The maximum number of iterations during the minimization calculation in the line search operation.
     unsigned maxiterations = 20;
 
+    /// The number of step lengths evaluated simultaneously in the parallel mode of the line search.
+    /// In this mode, the step lengths `alpha = k/parallel` for `k = 1, ..., parallel` are evaluated
+    /// in separate threads (using residual evaluations without Jacobian evaluations) and the one with
+    /// least error is selected. Since the objective and constraint functions are then evaluated at the
+    /// same time, the parallel mode is enabled only if ResidualFunctionOptions::concurrent is also set,
+    /// and it is disabled if this is less than two.
+    unsigned parallel = 0;
+
     /// The parameter that triggers line-search when current error is greater than initial error by a given factor (`Enew > factor*E0`).
     double trigger_when_current_error_is_greater_than_initial_error_by_factor = 1.0;
 
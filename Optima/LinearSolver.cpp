@@ -17,6 +17,9 @@
 
 #include "LinearSolver.hpp"
 
+// C++ includes
+#include <memory>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/LinearSolverFullspace.hpp>
@@ -31,9 +34,14 @@ struct LinearSolver::Impl
 
     LinearSolverOptions options; ///< The options for the linear solver.
 
-    LinearSolverRangespace rangespace; ///< The linear solver based on a rangespace algorithm.
-    LinearSolverNullspace nullspace;   ///< The linear solver based on a nullspace algorithm.
-    LinearSolverFullspace fullspace;   ///< The linear solver based on a fullspace algorithm.
+    // Note: Only the linear solver of the selected method is created, since
+    // each one allocates workspaces of size up to nt x nt. It is created when
+    // the method is selected (not when first used), so that no memory is
+    // allocated in the decompose and solve methods.
+
+    std::unique_ptr<LinearSolverRangespace> rangespace; ///< The linear solver based on a rangespace algorithm (if selected).
+    std::unique_ptr<LinearSolverNullspace> nullspace;   ///< The linear solver based on a nullspace algorithm (if selected).
+    std::unique_ptr<LinearSolverFullspace> fullspace;   ///< The linear solver based on a fullspace algorithm (if selected).
 
     Vector x; ///< The auxiliary solution vector x.
     Vector p; ///< The auxiliary solution vector p.
@@ -45,7 +53,7 @@ struct LinearSolver::Impl
     Vector aw; ///< The auxiliary solution vector aw.
 
     Impl(const MasterDims& dims)
-    : dims(dims), rangespace(dims), nullspace(dims), fullspace(dims)
+    : dims(dims)
     {
         const auto [nx, np, ny, nz, nw, nt] = dims;
 
@@ -55,15 +63,57 @@ struct LinearSolver::Impl
         wbar = zeros(nw);
         ax   = zeros(nx);
         aw   = zeros(nw);
+
+        createSolver();
+    }
+
+    Impl(const Impl& other)
+    : dims(other.dims), options(other.options),
+      rangespace(other.rangespace ? new LinearSolverRangespace(*other.rangespace) : nullptr),
+      nullspace(other.nullspace ? new LinearSolverNullspace(*other.nullspace) : nullptr),
+      fullspace(other.fullspace ? new LinearSolverFullspace(*other.fullspace) : nullptr),
+      x(other.x), p(other.p), w(other.w), wbar(other.wbar), ax(other.ax), aw(other.aw)
+    {}
+
+    auto setOptions(const LinearSolverOptions& opts) -> void
+    {
+        // Release the linear solver of the previous method if a different one is now used
+        if(opts.method != options.method)
+        {
+            rangespace.reset();
+            nullspace.reset();
+            fullspace.reset();
+        }
+        options = opts;
+        createSolver();
+    }
+
+    /// Create the linear solver of the selected method if not yet done.
+    auto createSolver() -> void
+    {
+        switch(options.method)
+        {
+        case LinearSolverMethod::Nullspace: solver(nullspace); break;
+        case LinearSolverMethod::Rangespace: solver(rangespace); break;
+        default: solver(fullspace); break;
+        }
+    }
+
+    /// Return the linear solver of the given type, creating it if not yet done.
+    template<typename Solver>
+    auto solver(std::unique_ptr<Solver>& ptr) -> Solver&
+    {
+        if(!ptr) ptr.reset(new Solver(dims));
+        return *ptr;
     }
 
     auto solveCanonical(CanonicalMatrix Mc, CanonicalVectorView ac, CanonicalVectorRef uc) -> void
     {
         switch(options.method)
         {
-        case LinearSolverMethod::Nullspace: nullspace.solve(Mc, ac, uc); break;
-        case LinearSolverMethod::Rangespace: rangespace.solve(Mc, ac, uc); break;
-        default: fullspace.solve(Mc, ac, uc); break;
+        case LinearSolverMethod::Nullspace: solver(nullspace).solve(Mc, ac, uc); break;
+        case LinearSolverMethod::Rangespace: solver(rangespace).solve(Mc, ac, uc); break;
+        default: solver(fullspace).solve(Mc, ac, uc); break;
         }
     }
 
@@ -71,9 +121,9 @@ struct LinearSolver::Impl
     {
         switch(options.method)
         {
-        case LinearSolverMethod::Nullspace: nullspace.decompose(Mc); break;
-        case LinearSolverMethod::Rangespace: rangespace.decompose(Mc); break;
-        default: fullspace.decompose(Mc); break;
+        case LinearSolverMethod::Nullspace: solver(nullspace).decompose(Mc); break;
+        case LinearSolverMethod::Rangespace: solver(rangespace).decompose(Mc); break;
+        default: solver(fullspace).decompose(Mc); break;
         }
     }
 
@@ -155,7 +205,7 @@ auto LinearSolver::operator=(LinearSolver other) -> LinearSolver&
 
 auto LinearSolver::setOptions(const LinearSolverOptions& options) -> void
 {
-    pimpl->options = options;
+    pimpl->setOptions(options);
 }
 
 auto LinearSolver::options() const -> const LinearSolverOptions&
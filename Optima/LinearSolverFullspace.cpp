@@ -36,7 +36,8 @@ struct LinearSolverFullspace::Impl
 
     Impl(const MasterDims& dims)
     : mat(dims.nt, dims.nt),
-      vec(dims.nt)
+      vec(dims.nt),
+      lu(dims.nt)
     {
     }
 
@@ -54,6 +54,7 @@ struct LinearSolverNullspace::Impl
         Vpp.resize(np, np);
         Mw.resize(nt, nt);
         rw.resize(nt);
+        lu = LU(nt);
     }
 
     auto decompose(CanonicalMatrix J) -> void
@@ -129,19 +130,51 @@ struct LinearSolverNullspace::Impl
         auto M3 = M.middleRows(nbe + nns, np);
         auto M4 = M.bottomRows(nbe);
 
-        Hbins.noalias() -= Hbibi * Sbins;
-        Hbens.noalias() -= Hbebi * Sbins;
-        Hnsns.noalias() -= Hnsbi * Sbins;
-        Vpns.noalias()  -= Vpbi * Sbins;
-
-        Hbip.noalias() -= Hbibi * Sbip;
-        Hbep.noalias() -= Hbebi * Sbip;
-        Hnsp.noalias() -= Hnsbi * Sbip;
-        Vpp.noalias()  -= Vpbi * Sbip;
-
-        Hnsbe.noalias() -= tr(Sbins) * Hbibe;
-        Hnsns.noalias() -= tr(Sbins) * Hbins;
-        Hnsp.noalias()  -= tr(Sbins) * Hbip;
+        // The structure of the blocks in J, used to skip products with zero
+        // blocks and to replace products with diagonal Hss by row scalings.
+        const auto densHss = J.structure.Hss == MatrixStructure::Dense;
+        const auto zeroHss = J.structure.Hss == MatrixStructure::Zero;
+        const auto zeroVps = J.structure.Vps == MatrixStructure::Zero;
+        const auto zeroSbsns = J.structure.Sbsns == MatrixStructure::Zero;
+        const auto zeroSbsp = J.structure.Sbsp == MatrixStructure::Zero;
+
+        if(!zeroSbsns)
+        {
+            if(densHss)
+            {
+                Hbins.noalias() -= Hbibi * Sbins;
+                Hbens.noalias() -= Hbebi * Sbins;
+                Hnsns.noalias() -= Hnsbi * Sbins;
+            }
+            else if(!zeroHss)
+                Hbins.noalias() -= Hbibi.diagonal().asDiagonal() * Sbins;
+
+            if(!zeroVps)
+                Vpns.noalias() -= Vpbi * Sbins;
+        }
+
+        if(!zeroSbsp)
+        {
+            if(densHss)
+            {
+                Hbip.noalias() -= Hbibi * Sbip;
+                Hbep.noalias() -= Hbebi * Sbip;
+                Hnsp.noalias() -= Hnsbi * Sbip;
+            }
+            else if(!zeroHss)
+                Hbip.noalias() -= Hbibi.diagonal().asDiagonal() * Sbip;
+
+            if(!zeroVps)
+                Vpp.noalias() -= Vpbi * Sbip;
+        }
+
+        if(!zeroSbsns)
+        {
+            if(densHss)
+                Hnsbe.noalias() -= tr(Sbins) * Hbibe;
+            Hnsns.noalias() -= tr(Sbins) * Hbins;
+            Hnsp.noalias()  -= tr(Sbins) * Hbip;
+        }
 
         if(nbe) M1 << Hbebe, Hbens, Hbep, Ibebe;
         if(nns) M2 << Hnsbe, Hnsns, Hnsp, tr(Sbens);
@@ -209,12 +242,26 @@ struct LinearSolverNullspace::Impl
         ap = a.p;
         awbs = a.wbs;
 
-        abi.noalias() -= Hbibi * awbi;
-        abe.noalias() -= Hbebi * awbi;
-        ans.noalias() -= Hnsbi * awbi;
-        ap.noalias()  -= Vpbi * awbi;
+        const auto densHss = J.structure.Hss == MatrixStructure::Dense;
+        const auto zeroHss = J.structure.Hss == MatrixStructure::Zero;
+        const auto zeroVps = J.structure.Vps == MatrixStructure::Zero;
+        const auto zeroSbsns = J.structure.Sbsns == MatrixStructure::Zero;
+        const auto zeroSbsp = J.structure.Sbsp == MatrixStructure::Zero;
+
+        if(densHss)
+        {
+            abi.noalias() -= Hbibi * awbi;
+            abe.noalias() -= Hbebi * awbi;
+            ans.noalias() -= Hnsbi * awbi;
+        }
+        else if(!zeroHss)
+            abi -= Hbibi.diagonal().cwiseProduct(awbi);
 
-        ans -= tr(Sbins) * abi;
+        if(!zeroVps)
+            ap.noalias() -= Vpbi * awbi;
+
+        if(!zeroSbsns)
+            ans.noalias() -= tr(Sbins) * abi;
 
         const auto t = nbe + nns + np + nbe;
 
@@ -232,8 +279,13 @@ struct LinearSolverNullspace::Impl
         auto dxbi = awbi;
         auto dwbi = abi;
 
-        dxbi.noalias() = awbi - Sbins*dxns - Sbip*dp;
-        dwbi.noalias() = abi - Hbibe*dxbe - Hbins*dxns - Hbip*dp;
+        // Note: dxbi and dwbi alias awbi and abi, so they are updated in place.
+        if(!zeroSbsns) dxbi.noalias() -= Sbins*dxns;
+        if(!zeroSbsp)  dxbi.noalias() -= Sbip*dp;
+
+        if(densHss) dwbi.noalias() -= Hbibe*dxbe;
+        dwbi.noalias() -= Hbins*dxns;
+        dwbi.noalias() -= Hbip*dp;
 
         u.xs << dxbe, dxbi, dxns;
         u.p = dp;
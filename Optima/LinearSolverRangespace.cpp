@@ -36,6 +36,7 @@ struct LinearSolverRangespace::Impl
     Vector Hd;        ///< The workspace for the diagonal entries in the Hss matrix.
     Matrix Bw;        ///< The workspace for the Bnb = inv(Hnn)*tr(Sbn) matrix.
     Matrix Tw;        ///< The workspace for the Tbb = Sbn*inv(Hnn)*tr(Sbn) matrix.
+    Matrix Pw;        ///< The workspace for the Ppbi = bar(Vpne)*tr(Sbine) matrix.
     Matrix Mw;        ///< The workspace for the M matrix in decompose and solve methods.
     Vector rw;        ///< The workspace for the r vector in solve method.
     Vector sw;        ///< The workspace for the s vector in solve method.
@@ -54,8 +55,10 @@ struct LinearSolverRangespace::Impl
         Hd.resize(nx);
         Bw.resize(nx, nw);
         Tw.resize(nw, nw);
+        Pw.resize(np, nw);
         Mw.resize(nt, nt);
         rw.resize(nt);
+        lu = LU(nt);
         sw.resize(nt);
         barHsp.resize(nx, np);
         barVps.resize(np, nx);
@@ -143,6 +146,10 @@ struct LinearSolverRangespace::Impl
         const auto Tbebi = Tbsbs.topRightCorner(nbe, nbi);
         const auto Tbebe = Tbsbs.topLeftCorner(nbe, nbe);
 
+        auto Ppbi = Pw.leftCols(nbi);
+
+        Ppbi.noalias() = barVpne * tr(Sbine);
+
         const auto t = np + nbi + nbe + nni;
 
         auto M = Mw.topLeftCorner(t, t);
@@ -181,8 +188,8 @@ struct LinearSolverRangespace::Impl
         auto M43 = M4.middleCols(np + nbi, nbe);
         auto M44 = M4.rightCols(nni);
 
-        M11.noalias() = Vpp - Vpbe*barHbep - Vpne*barHnep + barVpne*tr(Sbine)*Hbip;
-        M12.noalias() = Vpbi + barVpne*tr(Sbine)*diag(Hbibi);
+        M11.noalias() = Vpp - Vpbe*barHbep - Vpne*barHnep + Ppbi*Hbip;
+        M12.noalias() = Vpbi + Ppbi*diag(Hbibi);
         M13.noalias() = -barVpbe - barVpne*tr(Sbene);
         M14.noalias() = Vpni;
 
@@ -253,7 +260,7 @@ struct LinearSolverRangespace::Impl
         const auto Hnene = Hnsns.head(nne);
         const auto Hnini = Hnsns.tail(nni);
 
-        const auto barVpne = barVps.rightCols(nne);
+        const auto Ppbi = Pw.leftCols(nbi); // computed in decompose
 
         const auto Tbsbs = Tw.topLeftCorner(nbs, nbs);
         const auto Tbibi = Tbsbs.bottomRightCorner(nbi, nbi);
@@ -280,7 +287,7 @@ struct LinearSolverRangespace::Impl
         abe.noalias() = abe/Hbebe;
         ane.noalias() = ane/Hnene;
 
-        ap.noalias()   = ap - Vpbe*abe - Vpne*ane + barVpne*tr(Sbine)*abi;
+        ap.noalias()   = ap - Vpbe*abe - Vpne*ane + Ppbi*abi;
         awbi.noalias() = awbi - Sbine*ane + Tbibi*abi;
         awbe.noalias() = awbe - abe - Sbene*ane + Tbebi*abi;
         ani.noalias()  = ani - tr(Sbini)*abi;
@@ -303,9 +310,18 @@ struct LinearSolverRangespace::Impl
         auto xbe = abe;
         auto xne = ane;
 
-        wbi.noalias() = abi - Hbip*p - diag(Hbibi)*xbi;
-        xbe.noalias() = abe - (Hbep*p + wbe) / Hbebe;
-        xne.noalias() = ane - (Hnep*p + tr(Sbene)*wbe + tr(Sbine)*wbi) / Hnene;
+        auto qbe = sw.head(nbe); // the products below are divided by Hbebe and Hnene only after
+        auto qne = sw.tail(nne); // their evaluation in workspaces (otherwise, in temporary vectors)
+
+        wbi.noalias() = abi - Hbip*p;
+        wbi -= Hbibi.cwiseProduct(xbi);
+        qbe.noalias() = Hbep*p;
+        qbe += wbe;
+        xbe.noalias() = abe - qbe / Hbebe;
+        qne.noalias() = Hnep*p;
+        qne.noalias() += tr(Sbene)*wbe;
+        qne.noalias() += tr(Sbine)*wbi;
+        xne.noalias() = ane - qne / Hnene;
 
         u.xs << xbe, xbi, xne, xni;
         u.p = p;
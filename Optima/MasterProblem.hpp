@@ -27,6 +27,11 @@
 namespace Optima {
 
 /// Used to represent a master optimization problem.
+/// The functions *f*, *h* and *v* may write only the entries of their results
+/// that are not constant zeros (e.g., Solver never writes the derivatives with
+/// respect to its slack variables). Callers must thus evaluate them on storage
+/// that is zero-initialized (as by the constructors of ObjectiveResult and
+/// ConstraintResult) and whose other entries are not modified between calls.
 struct MasterProblem
 {
     ObjectiveFunction f;   ///< The objective function *f(x, p)*.
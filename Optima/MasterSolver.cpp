@@ -17,26 +17,35 @@
 
 #include "MasterSolver.hpp"
 
+// C++ includes
+#include <cmath>
+#include <string>
+
 // Optima includes
 #include <Optima/Convergence.hpp>
 #include <Optima/ErrorControl.hpp>
 #include <Optima/Exception.hpp>
 #include <Optima/MasterProblem.hpp>
 #include <Optima/MasterVector.hpp>
+#include <Optima/Memory.hpp>
 #include <Optima/NewtonStep.hpp>
 #include <Optima/Options.hpp>
 #include <Optima/Outputter.hpp>
 #include <Optima/ResidualErrors.hpp>
 #include <Optima/ResidualFunction.hpp>
 #include <Optima/Result.hpp>
+#include <Optima/SolutionCache.hpp>
+#include <Optima/Timing.hpp>
 #include <Optima/TransformStep.hpp>
+#include <Optima/Utils.hpp>
 
 namespace Optima {
 
 const auto CONTINUE = true;
 const auto STOP     = false;
 
-struct MasterSolver::Impl
+/// The state and workspace of the calculations of a MasterSolver object.
+struct MasterCalculation
 {
     const MasterDims dims;
     ResidualFunction F;
@@ -46,16 +55,25 @@ struct MasterSolver::Impl
     TransformStep transformstep;
     ErrorControl errorcontrol;
     Convergence convergence;
+    SolutionCache& solutioncache; ///< The cache of converged solutions of the master solver.
     Outputter outputter; ///< The object used to output the current state of the computation.
     Result result;
     Options options;
+    bool evaluated = false; ///< True if F and E have already been evaluated at the initial state of the iterations.
+    Time begin;             ///< The time at which the current calculation started.
+    MasterVector ubest;     ///< The iterate with least error in the current calculation, returned if it is interrupted.
+    double errorbest = 0.0; ///< The error of the iterate with least error in the current calculation.
+    bool bestevaluated = false; ///< True if F and E are evaluated at the iterate with least error.
+    std::string basicvars;  ///< The basic variables in the output of the current state (its capacity is reused in all iterations).
 
-    Impl(const MasterDims& dims)
+    MasterCalculation(const MasterDims& dims, SolutionCache& solutioncache)
     : dims(dims), F(dims), E(dims), uo(dims),
       newtonstep(dims),
       transformstep(dims),
       errorcontrol(dims),
-      convergence()
+      convergence(),
+      solutioncache(solutioncache),
+      ubest(dims)
     {
     }
 
@@ -109,81 +127,187 @@ struct MasterSolver::Impl
         outputter.addValues(E.ep);
         outputter.addValues(E.ew.head(dims.ny));
         outputter.addValues(E.ew.tail(dims.nz));
-        std::stringstream ss;
-        if(xnames.empty()) for(auto i : jb) ss << i << " ";
-        else for(auto i : jb) ss << xnames[i] << " ";
-        outputter.addValue(ss.str());
+        basicvars.clear();
+        if(xnames.empty()) for(auto i : jb) basicvars.append(std::to_string(i)).append(1, ' ');
+        else for(auto i : jb) basicvars.append(xnames[i]).append(1, ' ');
+        outputter.addValue(basicvars);
         outputter.outputState();
     };
 
     auto solve(const MasterProblem& problem, MasterVectorRef u) -> Result
     {
         initialize(problem, u);
-        while(stepping(u))
-            step(u);
+        {
+            // All Eigen memory needed in the calculation is allocated in
+            // initialize, with workspaces sized for every possible partition
+            // of the variables in the canonical form (e.g., into stable and
+            // unstable ones), so that the iterations are Eigen-allocation-free.
+            // This is asserted when compiled with EIGEN_RUNTIME_NO_MALLOC. Note
+            // that the output of the iterations (if active) still allocates
+            // its strings (see Outputter).
+            EigenMallocScope nomalloc(false);
+            if(predict(problem, u))
+                return result;
+            while(!result.interrupted && stepping(u))
+                step(u);
+        }
         finalize();
+        if(result.succeeded)
+            solutioncache.store(problem.b, u, F);
         return result;
     }
 
-    auto setOptions(const Options& opts) -> bool
+    auto setOptions(const Options& opts) -> void
     {
         options = opts;
+        F.setOptions(opts.residualfunction);
         newtonstep.setOptions(opts.newtonstep);
+        errorcontrol.setOptions(opts);
         convergence.setOptions(opts.convergence);
         outputter.setOptions(opts.output);
     }
 
-    auto initialize(const MasterProblem& problem, MasterVectorRef u) -> bool
+    auto initialize(const MasterProblem& problem, MasterVectorRef u) -> void
     {
         sanitycheck(problem, u);
         result = {};
         u.x.noalias() = min(max(u.x, problem.xlower), problem.xupper);
         u.p.noalias() = min(max(u.p, problem.plower), problem.pupper);
         uo = u;
+        const auto echelonformAx = F.echelonFormAx();
         F.initialize(problem);
+        result.num_echelonizations = F.echelonFormAx() != echelonformAx; // otherwise, the echelon form of the same Ax in a previous solve is reused
         E.initialize(problem);
         transformstep.initialize(problem);
         newtonstep.initialize(problem);
         errorcontrol.initialize(problem);
         convergence.initialize(problem);
+        evaluated = false;
+        begin = timenow();
+        ubest = u;
+        errorbest = infinity();
+        bestevaluated = false;
         outputter.clear();
         outputHeaderTop();
     }
 
+    /// Accept the prediction of the solution cache if it satisfies the convergence criteria.
+    /// Otherwise, `false` is returned and the calculation is warm-started from
+    /// the prediction (or from the initial guess if the prediction is unusable).
+    auto predict(const MasterProblem& problem, MasterVectorRef u) -> bool
+    {
+        if(!solutioncache.predict(problem.b, u))
+            return false;
+
+        u.x.noalias() = min(max(u.x, problem.xlower), problem.xupper);
+        u.p.noalias() = min(max(u.p, problem.plower), problem.pupper);
+
+        F.update(u);
+        E.update(u, F);
+
+        convergence.update(E);
+
+        if(convergence.converged())
+        {
+            result.predicted = true;
+            finalize();
+            return true;
+        }
+
+        // Continue from the prediction unless its residual could not be evaluated
+        if(F.result().succeeded && std::isfinite(E.error))
+        {
+            uo = u;
+            evaluated = true;
+        }
+        else u = uo; // uo is the initial guess at this point
+
+        return false;
+    }
+
     auto stepping(MasterVectorRef u) -> bool
     {
         if(result.iterations > options.maxiterations)
             return STOP;
 
-        // At the beginning of each new iteration, evaluate the residual
-        // function and the error. Stop if the error is already low enough.
-        // Note that this always produce a final state with update residual
-        // function and its derivatives should they be needed for calculation
-        // of the sensitity derivatives of the solution.
+        // The residual function and the error are evaluated at the initial
+        // guess here, and at every new state in the steps below. Stop if the
+        // error is already low enough. Note that this always produce a final
+        // state with update residual function and its derivatives should they
+        // be needed for calculation of the sensitity derivatives of the solution.
+
+        if(result.iterations == 0 && !evaluated)
+        {
+            F.update(u);
+            E.update(u, F);
+        }
 
-        F.update(u);
-        E.update(u, F);
         convergence.update(E);
 
         if(convergence.converged())
             return STOP;
 
+        if(E.error < errorbest)
+        {
+            ubest = u;
+            errorbest = E.error;
+            bestevaluated = true;
+        }
+
+        if(interrupted())
+        {
+            restoreBestIterate(u);
+            return STOP;
+        }
+
         return CONTINUE;
     }
 
+    /// Return true if the time limit of the calculation has been exceeded or its cancellation requested.
+    auto interrupted() const -> bool
+    {
+        return options.cancellation.cancelled() ||
+            (options.timelimit > 0.0 && elapsed(begin) > options.timelimit);
+    }
+
+    /// Set *u* to the iterate with least error and mark the calculation as interrupted.
+    /// F and E are evaluated again at this iterate unless they were last evaluated there,
+    /// so that the final state (e.g., in the output) is consistent with the returned one.
+    auto restoreBestIterate(MasterVectorRef u) -> void
+    {
+        u = ubest;
+        if(!bestevaluated)
+        {
+            F.update(u);
+            E.update(u, F);
+        }
+        result.interrupted = true;
+        result.failure_reason = options.cancellation.cancelled() ?
+            "The calculation was cancelled." :
+            "The calculation exceeded its time limit.";
+    }
+
     auto step(MasterVectorRef u) -> void
     {
         outputCurrentState();
         newtonstep.apply(F, uo, u);
-        transformstep.execute(uo, u, F, E);
-        errorcontrol.execute(uo, u, F, E);
+        if(interrupted()) // the best iterate is among those already evaluated (uo included)
+        {
+            restoreBestIterate(u);
+            return;
+        }
+        if(transformstep.execute(uo, u, F, E) == FAILED) // otherwise, F and E are already evaluated at the transformed u
+            errorcontrol.execute(uo, u, F, E);
         uo = u;
+        bestevaluated = false; // until the new iterate is checked in stepping
         result.iterations += 1;
     }
 
     auto finalize() -> void
     {
-        result.succeeded = convergence.converged();
+        result.succeeded = convergence.converged() && !result.interrupted;
+        result.error = E.error;
+        result.num_linear_decompositions = newtonstep.numDecompositions();
         outputCurrentState();
         outputHeaderBottom();
     }
@@ -203,6 +327,54 @@ struct MasterSolver::Impl
     }
 };
 
+struct MasterSolver::Impl
+{
+    const MasterDims dims;        ///< The dimensions of the master variables.
+    Options options;              ///< The options of the master solver.
+    SolutionCache solutioncache;  ///< The cache of converged solutions (shared by copies until changed).
+
+    /// The state and workspace of the calculations. This is not copied, but
+    /// created in the first solve call of a copy, so that cloning a master
+    /// solver (e.g., for many threads) costs little. All Eigen memory needed
+    /// during the iterations is still allocated before these start (see solve).
+    std::unique_ptr<MasterCalculation> calculation;
+
+    /// The echelon form of *Ax* of the master solver this is a copy of, shared
+    /// with the calculation once it is created (see EchelonizerW::echelonFormAx).
+    std::shared_ptr<const EchelonFormAx> echelonformAx;
+
+    Impl(const MasterDims& dims)
+    : dims(dims), solutioncache(dims), calculation(new MasterCalculation(dims, solutioncache))
+    {
+    }
+
+    Impl(const Impl& other)
+    : dims(other.dims), options(other.options), solutioncache(other.solutioncache),
+      echelonformAx(other.calculation ? other.calculation->F.echelonFormAx() : other.echelonformAx)
+    {
+    }
+
+    auto setOptions(const Options& opts) -> void
+    {
+        solutioncache.setOptions(opts);
+        if(calculation)
+            calculation->setOptions(opts);
+        options = opts;
+    }
+
+    auto solve(const MasterProblem& problem, MasterVectorRef u) -> Result
+    {
+        if(!calculation)
+        {
+            calculation.reset(new MasterCalculation(dims, solutioncache));
+            calculation->setOptions(options);
+            calculation->F.setEchelonFormAx(echelonformAx);
+            echelonformAx.reset();
+        }
+        return calculation->solve(problem, u);
+    }
+};
+
 MasterSolver::MasterSolver(const MasterDims& dims)
 : pimpl(new Impl(dims))
 {}
@@ -230,4 +402,9 @@ auto MasterSolver::solve(const MasterProblem& problem, MasterVectorRef u) -> Res
     return pimpl->solve(problem, u);
 }
 
+auto MasterSolver::solveAsync(const MasterProblem& problem, MasterVectorRef u) -> std::future<Result>
+{
+    return std::async(std::launch::async, [this, &problem, u]() mutable { return solve(problem, u); });
+}
+
 } // namespace Optima
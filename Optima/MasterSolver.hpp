@@ -18,6 +18,7 @@
 #pragma once
 
 // C++ includes
+#include <future>
 #include <memory>
 
 // Optima includes
@@ -41,6 +42,10 @@ public:
     MasterSolver(const MasterDims& dims);
 
     /// Construct a copy of a MasterSolver object.
+    /// The copy has the options and cached solutions of @p other. It shares
+    /// with @p other the immutable echelon form of *Ax* and the cached solutions
+    /// (until one of them stores a new one), and allocates its own workspace
+    /// only in its first call to @ref solve, so that copies are cheap to make.
     MasterSolver(const MasterSolver& other);
 
     /// Destroy this MasterSolver object.
@@ -54,6 +59,14 @@ public:
 
     /// Solve the given master optimization problem.
     auto solve(const MasterProblem& problem, MasterVectorRef u) -> Result;
+
+    /// Solve the given master optimization problem asynchronously in a new thread.
+    /// The returned future captures this solver, *problem* and the vectors
+    /// referenced by *u* by reference, so that these must not be used nor
+    /// destroyed until it is ready. The calculation can be interrupted with
+    /// Options::cancellation or Options::timelimit, in which case the result is
+    /// flagged with Result::interrupted.
+    auto solveAsync(const MasterProblem& problem, MasterVectorRef u) -> std::future<Result>;
 };
 
 } // namespace Optima
@@ -24,6 +24,19 @@ namespace Optima {
 
 #include <Optima/deps/eigenx/Eigen/Typedefs>
 
+/// The matrix type used to store a quantity of many problems advanced in lockstep, with one column (lane) per problem.
+/// Its storage is row-major, so that the values of an entry in all lanes are contiguous (structure-of-arrays).
+using LaneMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/// The mutable reference type of LaneMatrix.
+using LaneMatrixRef = Eigen::Ref<LaneMatrix>;
+
+/// The immutable reference type of LaneMatrix.
+using LaneMatrixView = Eigen::Ref<const LaneMatrix>;
+
+/// The type used to flag the lanes of many problems advanced in lockstep (e.g., those still active).
+using LaneMask = Eigen::Array<bool, 1, Eigen::Dynamic>;
+
 /// An Eigen matrix type to be used with numpy, which expects row-major order.
 /// See this discussion [here](https://pybind11.readthedocs.io/en/stable/advanced/cast/eigen.html#storage-orders).
 using Matrix4py = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor, Eigen::Dynamic, Eigen::Dynamic>;
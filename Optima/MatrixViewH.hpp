@@ -28,6 +28,7 @@ struct MatrixViewH
     MatrixView Hxx;       ///< The matrix *Hxx* in *H = [Hxx Hxp]*.
     MatrixView Hxp;       ///< The matrix *Hxp* in *H = [Hxx Hxp]*.
     const bool isHxxDiag; ///< The flag that indicates wether *Hxx* is diagonal.
+    const bool isHxx4basicvars = false; ///< The flag that indicates wether *Hxx* is non-zero only on columns corresponding to basic variables.
 };
 
 } // namespace Optima
@@ -31,6 +31,7 @@ struct MatrixViewRWQ
     MatrixView Sbp; ///< The matrix *Sbp* in the echelon form of *W*.
     IndicesView jb; ///< The indices of the basic variables in the echelon form of *W*.
     IndicesView jn; ///< The indices of the non-basic variables in the echelon form of *W*.
+    Index revision = -1; ///< The identifier of the current echelon form of *W*, which changes whenever *R*, *Sbn* or *Sbp* change (or -1 if unknown).
 };
 
 } // namespace Optima
@@ -27,6 +27,7 @@ struct MatrixViewV
 {
     MatrixView Vpx; ///< The matrix *Vpx* in *V = [Vpx Vpp]*.
     MatrixView Vpp; ///< The matrix *Vpp* in *V = [Vpx Vpp]*.
+    const bool isVpx4basicvars = false; ///< The flag that indicates wether *Vpx* is non-zero only on columns corresponding to basic variables.
 };
 
 } // namespace Optima
@@ -0,0 +1,64 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// Used to allow or forbid heap allocations by Eigen within a scope.
+/// This has effect only if Optima is compiled with `EIGEN_RUNTIME_NO_MALLOC`
+/// (see the CMake option with same name). In this case, any heap allocation
+/// by Eigen in a scope where allocations are forbidden triggers an assertion
+/// failure (in builds with assertions enabled). The previous permission is
+/// restored when the object is destroyed. Note that this permission is shared
+/// by all threads in the process, which is why Optima executes its concurrent
+/// tasks sequentially in these builds (see @ref TaskPool). Thus, allocation
+/// checks are only reliable while no other thread in the process uses Eigen
+/// (e.g., the calling thread while an asynchronous solve is running).
+class EigenMallocScope
+{
+public:
+    /// Construct an EigenMallocScope object that allows or forbids heap allocations by Eigen.
+    explicit EigenMallocScope(bool allowed)
+    {
+        (void)allowed;
+        #ifdef EIGEN_RUNTIME_NO_MALLOC
+        previous = Eigen::internal::is_malloc_allowed();
+        Eigen::internal::set_is_malloc_allowed(allowed);
+        #endif
+    }
+
+    /// Destroy this EigenMallocScope object, restoring the previous permission.
+    ~EigenMallocScope()
+    {
+        #ifdef EIGEN_RUNTIME_NO_MALLOC
+        Eigen::internal::set_is_malloc_allowed(previous);
+        #endif
+    }
+
+    EigenMallocScope(const EigenMallocScope&) = delete;
+    auto operator=(const EigenMallocScope&) -> EigenMallocScope& = delete;
+
+private:
+    /// The permission for heap allocations before the construction of this object.
+    bool previous = true;
+};
+
+} // namespace Optima
@@ -32,9 +32,15 @@ struct NewtonStep::Impl
     Vector xupper;             ///< The upper bounds for variables *x*.
     Vector plower;             ///< The lower bounds for variables *p*.
     Vector pupper;             ///< The upper bounds for variables *p*.
+    Indices jb;                ///< The basic variables in the last decomposed Jacobian matrix (in its first *nb* entries).
+    Indices js;                ///< The stable variables in the last decomposed Jacobian matrix (in its first *ns* entries).
+    Index nb = 0;              ///< The number of basic variables in the last decomposed Jacobian matrix.
+    Index ns = 0;              ///< The number of stable variables in the last decomposed Jacobian matrix.
+    bool decomposed = false;   ///< True if the linear solver holds a decomposition of a constant Jacobian matrix.
+    Index decompositions = 0;  ///< The number of decompositions of the Jacobian matrix since the last initialization.
 
     Impl(const MasterDims& dims)
-    : dims(dims), linearsolver(dims), du(dims)
+    : dims(dims), linearsolver(dims), du(dims), jb(dims.nx), js(dims.nx)
     {
     }
 
@@ -49,6 +55,8 @@ struct NewtonStep::Impl
         xupper = problem.xupper;
         plower = problem.plower;
         pupper = problem.pupper;
+        decomposed = false; // the Jacobian matrix may differ in a new problem
+        decompositions = 0;
     }
 
     auto apply(const ResidualFunction& F, MasterVectorView uo, MasterVectorRef u) -> void
@@ -57,7 +65,7 @@ struct NewtonStep::Impl
         const auto res = F.result();
         const auto Jc = res.Jc;
         const auto Fc = res.Fc;
-        linearsolver.decompose(Jc);
+        decompose(Jc, res.constant);
         linearsolver.solve(Jc, Fc, du);
         u.x.noalias() = uo.x + du.x;
         u.p.noalias() = uo.p + du.p;
@@ -66,6 +74,26 @@ struct NewtonStep::Impl
         u.p.noalias() = min(max(u.p, plower), pupper);
     }
 
+    /// Decompose the Jacobian matrix, unless it is constant and its basic
+    /// and stable variables are the same as in the last decomposition.
+    auto decompose(CanonicalMatrix Jc, bool constant) -> void
+    {
+        const auto samejb = Jc.jb.size() == nb && Jc.jb == jb.head(nb);
+        const auto samejs = Jc.js.size() == ns && Jc.js == js.head(ns);
+
+        if(constant && decomposed && samejb && samejs)
+            return;
+
+        linearsolver.decompose(Jc);
+        decompositions += 1;
+
+        nb = Jc.jb.size();
+        ns = Jc.js.size();
+        jb.head(nb) = Jc.jb;
+        js.head(ns) = Jc.js;
+        decomposed = constant;
+    }
+
     auto sanitycheck() const -> void
     {
         assert(xlower.size() == dims.nx);
@@ -107,4 +135,9 @@ auto NewtonStep::apply(const ResidualFunction& F, MasterVectorView uo, MasterVec
     pimpl->apply(F, uo, u);
 }
 
+auto NewtonStep::numDecompositions() const -> Index
+{
+    return pimpl->decompositions;
+}
+
 } // namespace Optima
@@ -56,6 +56,9 @@ public:
 
     /// Apply Newton step to compute the next state of master variables.
     auto apply(const ResidualFunction& F, MasterVectorView uo, MasterVectorRef u) -> void;
+
+    /// Return the number of decompositions of the Jacobian matrix since the last call to @ref initialize.
+    auto numDecompositions() const -> Index;
 };
 
 } // namespace Optima
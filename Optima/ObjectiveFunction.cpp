@@ -47,11 +47,8 @@ ObjectiveFunction::ObjectiveFunction(const Signature4py& func)
 
 auto ObjectiveFunction::operator()(ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions opts) const -> void
 {
-    // Ensure clear state before evaluation
+    // Reset the flags, but not the vector and matrices, whose entries not written by fn are kept (see MasterProblem)
     res.f = 0.0;
-    res.fx.fill(0.0);
-    res.fxx.fill(0.0);
-    res.fxp.fill(0.0);
     res.diagfxx = false;
     res.fxx4basicvars = false;
     res.succeeded = true;
@@ -47,16 +47,19 @@ struct ObjectiveResultBase
     Bool diagfxx;
 
     /// True if `fxx` is non-zero only on columns corresponding to basic varibles in *x*.
+    /// Set this to true if only the columns of `fxx` corresponding to the
+    /// variables in ObjectiveOptions::ibasicvars have been evaluated. The
+    /// remaining columns are then considered zero.
     Bool fxx4basicvars;
 
     /// True if the objective function evaluation succeeded.
     Bool succeeded;
 
-    /// Construct an ObjectiveResultBase object with given dimensions.
+    /// Construct an ObjectiveResultBase object with given dimensions (with zero-initialized vector and matrices).
     /// @param nx The number of variables in *x*.
     /// @param np The number of variables in *p*.
     ObjectiveResultBase(Index nx, Index np)
-    : f(0.0), fx(nx), fxx(nx, nx), fxp(nx, np),
+    : f(0.0), fx(Vec::Zero(nx)), fxx(Mat::Zero(nx, nx)), fxp(Mat::Zero(nx, np)),
       diagfxx(false), fxx4basicvars(false), succeeded(true) {}
 
     /// Construct an ObjectiveResultBase object from another.
@@ -70,6 +73,14 @@ struct ObjectiveResultBase
     ObjectiveResultBase(Real f, Vec fx, Mat fxx, Mat fxp, Bool diagfxx, Bool fxx4basicvars, Bool succeeded)
     : f(f), fx(fx), fxx(fxx), fxp(fxp), diagfxx(diagfxx),
       fxx4basicvars(fxx4basicvars), succeeded(succeeded) {}
+
+    /// Set the gradient vector and the Jacobian matrices to zero.
+    auto setZero() -> void
+    {
+        fx.setZero();
+        fxx.setZero();
+        fxp.setZero();
+    }
 };
 
 /// The result of an objective function evaluation.
@@ -93,6 +104,8 @@ struct ObjectiveOptions
     const Eval eval;
 
     /// The indices of the basic variables in *x*.
+    /// Only the columns of `fxx` corresponding to these variables are needed
+    /// if ObjectiveResult::fxx4basicvars is set to true in the evaluation.
     IndicesView ibasicvars;
 };
 
@@ -129,6 +142,9 @@ public:
     // : ObjectiveFunction(fn) {}
 
     /// Evaluate the objective function.
+    /// The vector and matrices in *res* are not set to zero before the evaluation, so that the
+    /// entries the function does not write keep their values (see MasterProblem). Call
+    /// ObjectiveResultBase::setZero before if the function expects zeroed storage.
     auto operator()(ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions opts) const -> void;
 
     /// Assign another objective function to this.
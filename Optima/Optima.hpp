@@ -18,6 +18,10 @@
 #pragma once
 
 // Optima includes
+#include <Optima/AutoDiff.hpp>
+#include <Optima/BatchLockstepSolver.hpp>
+#include <Optima/BatchLU.hpp>
+#include <Optima/BatchSolver.hpp>
 #include <Optima/CanonicalDims.hpp>
 #include <Optima/Canonicalizer.hpp>
 #include <Optima/CanonicalMatrix.hpp>
@@ -28,6 +32,7 @@
 #include <Optima/Echelonizer.hpp>
 #include <Optima/Eigen.hpp>
 #include <Optima/Exception.hpp>
+#include <Optima/FiniteDifferences.hpp>
 #include <Optima/Index.hpp>
 #include <Optima/LinearSolver.hpp>
 #include <Optima/LU.hpp>
@@ -40,3 +45,4 @@
 #include <Optima/Stability.hpp>
 #include <Optima/State.hpp>
 #include <Optima/Timing.hpp>
+#include <Optima/TinySolver.hpp>
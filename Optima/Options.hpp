@@ -22,11 +22,17 @@
 #include <vector>
 
 // Optima includes
+#include <Optima/BatchOptions.hpp>
+#include <Optima/CancellationToken.hpp>
 #include <Optima/ConvergenceOptions.hpp>
+#include <Optima/DecomposeOptions.hpp>
 #include <Optima/LineSearchOptions.hpp>
 #include <Optima/LinearSolverOptions.hpp>
 #include <Optima/NewtonStepOptions.hpp>
 #include <Optima/OutputterOptions.hpp>
+#include <Optima/PresolveOptions.hpp>
+#include <Optima/ResidualFunctionOptions.hpp>
+#include <Optima/SolutionCacheOptions.hpp>
 #include <Optima/TransformFunction.hpp>
 
 namespace Optima {
@@ -108,6 +114,15 @@ public:
     /// The maximum number of iterations in the optimization calculations.
     unsigned maxiterations = 200;
 
+    /// The maximum wall time of each optimization calculation (in unit of s), with no limit if zero.
+    /// The limit is checked before each iteration and after each Newton step. If it is exceeded,
+    /// the calculation stops and returns the iterate with least error (see Result::interrupted).
+    double timelimit = 0.0;
+
+    /// The token used to interrupt the optimization calculations from another thread.
+    /// The interruption is checked as the time limit above, with the same outcome.
+    CancellationToken cancellation;
+
     /// The options for the linear search minimization operation.
     LineSearchOptions linesearch;
 
@@ -122,6 +137,21 @@ public:
 
     /// The options used for convergence analysis.
     ConvergenceOptions convergence;
+
+    /// The options used for the evaluation of the residual function.
+    ResidualFunctionOptions residualfunction;
+
+    /// The options used for the cache of converged solutions.
+    SolutionCacheOptions solutioncache;
+
+    /// The options used for the presolve stage of the optimization calculations.
+    PresolveOptions presolve;
+
+    /// The options used for the decomposition of the optimization problem into independent subproblems.
+    DecomposeOptions decompose;
+
+    /// The options used for the solution of batches of optimization problems with BatchSolver and BatchLockstepSolver.
+    BatchOptions batch;
 };
 
 } // namespace Optima
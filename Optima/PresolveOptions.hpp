@@ -0,0 +1,38 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace Optima {
+
+/// Used to organize the options for the presolve stage of an optimization calculation.
+struct PresolveOptions
+{
+    /// True if the optimization problem is reduced before it is solved.
+    /// The presolve stage eliminates variables with equal lower and upper
+    /// bounds, variables determined by singleton rows in the linear equality
+    /// constraints, and linearly dependent rows in these constraints. The
+    /// reduced problem is then solved and its solution is mapped back to the
+    /// original problem.
+    bool active = false;
+
+    /// The relative tolerance used to accept the value of a variable determined by a singleton row
+    /// outside its bounds, and to detect rows of linear equality constraints that are consistent but redundant.
+    double tolerance = 1.0e-10;
+};
+
+} // namespace Optima
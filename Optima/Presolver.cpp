@@ -0,0 +1,430 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "Presolver.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Optima includes
+#include <Optima/ConstraintFunction.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/IndexUtils.hpp>
+#include <Optima/ObjectiveFunction.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+using Eigen::all;
+
+/// The workspace used to evaluate a function of the original problem within a function of the reduced problem.
+template<typename Res>
+struct PresolveWorkspace
+{
+    Res res;            ///< The result of the evaluation of the function of the original problem.
+    Vector x;           ///< The variables *x* of the original problem.
+    Indices ibasicvars; ///< The indices of the basic variables in *x* of the original problem.
+    std::mutex mutex;   ///< The mutex serializing evaluations that use this workspace.
+
+    /// Construct a PresolveWorkspace object.
+    PresolveWorkspace(const Res& res, Index nx)
+    : res(res), x(zeros(nx)), ibasicvars(nx) {}
+};
+
+struct Presolver::Impl
+{
+    const Dims dims;                       ///< The dimensions of the original optimization problem.
+    Options options;                       ///< The options for the solution of the reduced problem (with presolve inactive).
+    PresolveOptions presolve;              ///< The options of the presolve stage.
+    Indices ifree;                         ///< The indices of the variables in *x* kept in the reduced problem.
+    Indices ifixed;                        ///< The indices of the variables in *x* eliminated from the reduced problem.
+    Indices ikept;                         ///< The indices of the linear equality constraints kept in the reduced problem.
+    std::vector<std::pair<Index, Index>> singletons; ///< The eliminated singleton rows and their variables in elimination order.
+    Vector xfix;                           ///< The values of the eliminated variables in *x* (zero for the others).
+    std::unique_ptr<Problem> rproblem;     ///< The reduced optimization problem.
+    std::unique_ptr<Solver> rsolver;       ///< The solver for the reduced optimization problem.
+    const Problem* problemptr = nullptr;   ///< The original problem in the current solve call, used in the functions of the reduced problem.
+    PresolveWorkspace<ObjectiveResult> fws;  ///< The workspace for the evaluation of f(x, p).
+    PresolveWorkspace<ConstraintResult> hews; ///< The workspace for the evaluation of he(x, p).
+    PresolveWorkspace<ConstraintResult> hgws; ///< The workspace for the evaluation of hg(x, p).
+    PresolveWorkspace<ConstraintResult> vws;  ///< The workspace for the evaluation of v(x, p).
+
+    Impl(const Dims& dims)
+    : dims(dims),
+      fws(ObjectiveResult(dims.x, dims.p), dims.x),
+      hews(ConstraintResult(dims.he, dims.x, dims.p), dims.x),
+      hgws(ConstraintResult(dims.hg, dims.x, dims.p), dims.x),
+      vws(ConstraintResult(dims.p, dims.x, dims.p), dims.x)
+    {
+    }
+
+    Impl(const Impl& other)
+    : Impl(other.dims)
+    {
+        options = other.options;
+        presolve = other.presolve;
+    }
+
+    auto setOptions(const Options& opts) -> void
+    {
+        presolve = opts.presolve;
+        options = opts;
+        options.presolve.active = false;
+        if(rsolver)
+            rsolver->setOptions(options);
+    }
+
+    auto reduce(const Problem& problem) -> bool
+    {
+        if(!presolve.active)
+            return false;
+
+        const auto nx  = dims.x;
+        const auto nbe = dims.be;
+        const auto tol = presolve.tolerance;
+
+        const auto Aex = problem.Aex;
+        const auto Aep = problem.Aep;
+        const auto be  = problem.be;
+
+        std::vector<bool> fixed(nx, false);
+        std::vector<bool> dropped(nbe, false);
+
+        xfix = zeros(nx);
+        singletons.clear();
+
+        // Eliminate the variables whose lower and upper bounds are equal
+        for(auto j = 0; j < nx; ++j)
+        {
+            if(problem.xlower[j] == problem.xupper[j])
+            {
+                fixed[j] = true;
+                xfix[j] = problem.xlower[j];
+            }
+        }
+
+        // Eliminate the rows in Aex with a single non-zero coefficient on the
+        // remaining variables (and none in Aep), which determine the value of
+        // that variable. Repeat until no more such rows are found, since each
+        // eliminated variable may produce new singleton rows. The singleton
+        // rows in Agx are not eliminated, since these are inequality
+        // constraints that bound their variable rather than determine it.
+        for(auto changed = true; changed; )
+        {
+            changed = false;
+            for(auto i = 0; i < nbe; ++i)
+            {
+                if(dropped[i] || (dims.p && !Aep.row(i).isZero(0.0)))
+                    continue;
+
+                auto count = 0;
+                auto jfree = -1;
+                auto residual = be[i];
+                for(auto j = 0; j < nx; ++j)
+                {
+                    if(Aex(i, j) == 0.0) continue;
+                    if(fixed[j]) residual -= Aex(i, j) * xfix[j];
+                    else { ++count; jfree = j; }
+                }
+
+                if(count == 0) // a consistent row without variables is redundant
+                {
+                    dropped[i] = std::abs(residual) <= tol * (1.0 + std::abs(be[i]));
+                    continue;
+                }
+
+                if(count > 1)
+                    continue;
+
+                const auto j = jfree;
+                const auto xj = residual / Aex(i, j);
+                const auto xlower = problem.xlower[j];
+                const auto xupper = problem.xupper[j];
+                const auto eps = tol * (1.0 + std::abs(xj));
+
+                if(xj < xlower - eps || xj > xupper + eps) // infeasible row, which is left to the solver
+                    continue;
+
+                fixed[j] = true;
+                xfix[j] = std::min(std::max(xj, xlower), xupper);
+                dropped[i] = true;
+                singletons.push_back({ i, j });
+                changed = true;
+            }
+        }
+
+        std::vector<Index> jfree, jfixed, irows;
+        for(auto j = 0; j < nx; ++j)
+            (fixed[j] ? jfixed : jfree).push_back(j);
+        for(auto i = 0; i < nbe; ++i)
+            if(!dropped[i]) irows.push_back(i);
+
+        ifree  = Eigen::Map<const Indices>(jfree.data(), jfree.size());
+        ifixed = Eigen::Map<const Indices>(jfixed.data(), jfixed.size());
+        ikept  = Eigen::Map<const Indices>(irows.data(), irows.size());
+
+        eliminateLinearlyDependentRows(problem);
+
+        const auto reduced = ifree.size() < nx || ikept.size() < nbe;
+
+        if(!reduced)
+            return false;
+
+        if(!rproblem || rproblem->dims.x != ifree.size() || rproblem->dims.be != ikept.size())
+            initReducedProblem();
+
+        return true;
+    }
+
+    /// Eliminate the remaining linear equality constraints that are linearly dependent on others (if consistent).
+    auto eliminateLinearlyDependentRows(const Problem& problem) -> void
+    {
+        const Index m = ikept.size();
+
+        if(m < 2)
+            return;
+
+        Matrix M(m, ifree.size() + dims.p);
+        M << problem.Aex(ikept, ifree), problem.Aep(ikept, all);
+
+        Eigen::FullPivLU<Matrix> lu(tr(M));
+
+        const Index rank = lu.rank();
+
+        if(rank == m)
+            return;
+
+        Indices independent = lu.permutationQ().indices().head(rank).cast<Index>();
+        std::sort(independent.begin(), independent.end());
+
+        // Ensure the dependent rows are consistent with the independent ones,
+        // otherwise the problem is infeasible and it is left to the solver.
+        const Vector b = problem.be(ikept) - problem.Aex(ikept, all) * xfix;
+        const Matrix Mk = M(independent, all);
+        const Vector xk = Mk.fullPivLu().solve(b(independent));
+        const Vector r = M * xk - b;
+
+        if(r.lpNorm<Eigen::Infinity>() > presolve.tolerance * (1.0 + b.lpNorm<Eigen::Infinity>()))
+            return;
+
+        ikept = ikept(independent).eval();
+    }
+
+    /// Initialize the reduced problem and its solver.
+    auto initReducedProblem() -> void
+    {
+        Dims rdims;
+        rdims.x  = ifree.size();
+        rdims.p  = dims.p;
+        rdims.be = ikept.size();
+        rdims.bg = dims.bg;
+        rdims.he = dims.he;
+        rdims.hg = dims.hg;
+
+        rproblem = std::make_unique<Problem>(rdims);
+
+        rproblem->f = [this](ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions opts)
+        {
+            auto& ws = fws;
+            std::lock_guard<std::mutex> lock(ws.mutex);
+            const auto ibasicvars = expand(x, opts.ibasicvars, ws.x, ws.ibasicvars);
+            ws.res.setZero();
+            problemptr->f(ws.res, ws.x, p, ObjectiveOptions{opts.eval, ibasicvars});
+            res.f = ws.res.f;
+            res.fx = ws.res.fx(ifree);
+            if(ws.res.diagfxx) res.fxx.diagonal() = ws.res.fxx.diagonal()(ifree);
+            else res.fxx = ws.res.fxx(ifree, ifree);
+            res.fxp = ws.res.fxp(ifree, all);
+            res.diagfxx = ws.res.diagfxx;
+            res.fxx4basicvars = ws.res.fxx4basicvars;
+            res.succeeded = ws.res.succeeded;
+        };
+
+        rproblem->he = [this](ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts)
+        {
+            evalConstraintFunction(problemptr->he, hews, res, x, p, opts);
+        };
+
+        rproblem->hg = [this](ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts)
+        {
+            evalConstraintFunction(problemptr->hg, hgws, res, x, p, opts);
+        };
+
+        rproblem->v = [this](ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts)
+        {
+            evalConstraintFunction(problemptr->v, vws, res, x, p, opts);
+        };
+
+        rsolver = std::make_unique<Solver>(*rproblem);
+        rsolver->setOptions(options);
+    }
+
+    /// Return the variables and the basic variables of the original problem from those of the reduced problem.
+    auto expand(VectorView x, IndicesView ibasicvars, VectorRef xfull, IndicesRef ibasicvarsfull) const -> IndicesView
+    {
+        xfull = xfix;
+        xfull(ifree) = x;
+        auto ib = ibasicvarsfull.head(ibasicvars.size());
+        ib = ifree(ibasicvars);
+        return ib;
+    }
+
+    /// Evaluate a constraint function of the original problem within a constraint function of the reduced problem.
+    auto evalConstraintFunction(const ConstraintFunction& c, PresolveWorkspace<ConstraintResult>& ws, ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions opts) -> void
+    {
+        std::lock_guard<std::mutex> lock(ws.mutex);
+        const auto ibasicvars = expand(x, opts.ibasicvars, ws.x, ws.ibasicvars);
+        ws.res.setZero();
+        c(ws.res, ws.x, p, ConstraintOptions{opts.eval, ibasicvars});
+        res.val = ws.res.val;
+        res.ddx = ws.res.ddx(all, ifree);
+        res.ddp = ws.res.ddp;
+        res.ddx4basicvars = ws.res.ddx4basicvars;
+        res.succeeded = ws.res.succeeded;
+    }
+
+    auto solve(const Problem& problem, State& state) -> Result
+    {
+        problemptr = &problem;
+
+        auto& rp = *rproblem;
+
+        // Refresh the data of the reduced problem
+        rp.Aex = problem.Aex(ikept, ifree);
+        rp.Aep = problem.Aep(ikept, all);
+        rp.be = problem.be(ikept) - problem.Aex(ikept, all) * xfix;
+        rp.Agx = problem.Agx(all, ifree);
+        rp.Agp = problem.Agp;
+        rp.bg = problem.bg - problem.Agx * xfix;
+        rp.xlower = problem.xlower(ifree);
+        rp.xupper = problem.xupper(ifree);
+        rp.plower = problem.plower;
+        rp.pupper = problem.pupper;
+
+        // Initialize the state of the reduced problem from the given one
+        State rstate(rp.dims);
+        rstate.x = state.x(ifree);
+        rstate.p = state.p;
+        rstate.ye = state.ye(ikept);
+        rstate.yg = state.yg;
+        rstate.z = state.z;
+        rstate.xbg = state.xbg;
+        rstate.xhg = state.xhg;
+
+        const auto result = rsolver->solve(rp, rstate);
+
+        // Map the state of the reduced problem back to the original problem
+        state.x = xfix;
+        state.x(ifree) = rstate.x;
+        state.p = rstate.p;
+        state.ye.fill(0.0); // zero for the redundant rows
+        state.ye(ikept) = rstate.ye;
+        state.yg = rstate.yg;
+        state.z = rstate.z;
+        state.xbg = rstate.xbg;
+        state.xhg = rstate.xhg;
+        state.s(ifree) = rstate.s;
+
+        recover(problem, state);
+
+        return result;
+    }
+
+    /// Compute the Lagrange multipliers of the singleton rows and the stability measures of the eliminated variables.
+    auto recover(const Problem& problem, State& state) -> void
+    {
+        if(ifixed.size() == 0)
+            return;
+
+        const auto nx = dims.x;
+        const auto np = dims.p;
+
+        const Indices ibasicvars = indices(nx);
+
+        ObjectiveResult fres(nx, np);
+        ConstraintResult heres(dims.he, nx, np);
+        ConstraintResult hgres(dims.hg, nx, np);
+
+        problem.f(fres, state.x, state.p, ObjectiveOptions{{false, false}, ibasicvars});
+        problem.he(heres, state.x, state.p, ConstraintOptions{{true, false}, ibasicvars});
+        problem.hg(hgres, state.x, state.p, ConstraintOptions{{true, false}, ibasicvars});
+
+        // The stability measures s = g + tr(Aex)*ye + tr(Agx)*yg + tr(Jex)*ze + tr(Jgx)*zg
+        Vector s = fres.fx;
+        s.noalias() += tr(problem.Aex) * state.ye;
+        s.noalias() += tr(problem.Agx) * state.yg;
+        s.noalias() += tr(heres.ddx) * state.ze;
+        s.noalias() += tr(hgres.ddx) * state.zg;
+
+        // The Lagrange multiplier of each singleton row is such that the
+        // stability measure of its variable is zero. These are computed in
+        // reverse order of elimination, since the column of a variable may
+        // only contain singleton rows eliminated after it.
+        for(auto k = singletons.size(); k-- > 0; )
+        {
+            const auto [i, j] = singletons[k];
+            const auto yi = -s[j] / problem.Aex(i, j);
+            state.ye[i] = yi;
+            s.noalias() += tr(problem.Aex.row(i)) * yi;
+        }
+
+        state.s(ifixed) = s(ifixed);
+    }
+};
+
+Presolver::Presolver(const Dims& dims)
+: pimpl(new Impl(dims))
+{}
+
+Presolver::Presolver(const Presolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+Presolver::~Presolver()
+{}
+
+auto Presolver::operator=(Presolver other) -> Presolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto Presolver::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto Presolver::reduce(const Problem& problem) -> bool
+{
+    return pimpl->reduce(problem);
+}
+
+auto Presolver::solve(const Problem& problem, State& state) -> Result
+{
+    return pimpl->solve(problem, state);
+}
+
+} // namespace Optima
@@ -0,0 +1,69 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Dims.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Options;
+class Problem;
+class Result;
+class State;
+
+/// Used to reduce an optimization problem before its solution and map the solution of the reduced problem back.
+class Presolver
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a Presolver object with given dimensions of the optimization problem.
+    Presolver(const Dims& dims);
+
+    /// Construct a copy of a Presolver object.
+    Presolver(const Presolver& other);
+
+    /// Destroy this Presolver object.
+    virtual ~Presolver();
+
+    /// Assign a Presolver object to this.
+    auto operator=(Presolver other) -> Presolver&;
+
+    /// Set the options of this Presolver object.
+    auto setOptions(const Options& options) -> void;
+
+    /// Determine the reduction of the optimization problem.
+    /// @return `true` if the optimization problem can be reduced.
+    auto reduce(const Problem& problem) -> bool;
+
+    /// Solve the optimization problem using its last determined reduction.
+    /// On exit, the variables *x* and *p* and the Lagrange multipliers *y*
+    /// and *z* in *state* correspond to the original optimization problem,
+    /// as well as the stability measures *s* of the eliminated variables.
+    auto solve(const Problem& problem, State& state) -> Result;
+};
+
+} // namespace Optima
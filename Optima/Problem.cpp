@@ -73,10 +73,18 @@ Problem::Problem(const Problem& other)
   Agp(pimpl->Agp),
   be(pimpl->be),
   bg(pimpl->bg),
+  he(other.he),
+  hg(other.hg),
+  v(other.v),
+  f(other.f),
   xlower(pimpl->xlower),
   xupper(pimpl->xupper),
   plower(pimpl->plower),
-  pupper(pimpl->pupper)
+  pupper(pimpl->pupper),
+  fxw(other.fxw),
+  bw(other.bw),
+  hw(other.hw),
+  vw(other.vw)
 {}
 
 Problem::~Problem()
@@ -30,6 +30,9 @@
 namespace Optima {
 
 /// The class used to define an optimization problem.
+/// The functions *f*, *he*, *hg* and *v* are always evaluated on results whose
+/// vector and matrices have been set to zero, so that they may write only their
+/// non-zero entries (unlike the functions of MasterProblem).
 class Problem
 {
 private:
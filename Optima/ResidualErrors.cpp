@@ -39,12 +39,23 @@ struct ResidualErrors::Impl
     double errorw; ///< The maximum residual error associated with the linear and non-linear constraint equations.
     double error;  ///< The error norm sqrt(||ex||^2 + ||ep||^2 + ||ew||^2).
 
+    Vector exbkp;     ///< The saved residual errors ex in the last checkpoint.
+    Vector epbkp;     ///< The saved residual errors ep in the last checkpoint.
+    Vector ewbkp;     ///< The saved residual errors ew in the last checkpoint.
+    double errorxbkp; ///< The saved error norm errorx in the last checkpoint.
+    double errorpbkp; ///< The saved error norm errorp in the last checkpoint.
+    double errorwbkp; ///< The saved error norm errorw in the last checkpoint.
+    double errorbkp;  ///< The saved error norm error in the last checkpoint.
+
     Impl(const MasterDims& dims)
     : dims(dims)
     {
         ex = zeros(dims.nx);
         ep = zeros(dims.np);
         ew = zeros(dims.nw);
+        exbkp = zeros(dims.nx);
+        epbkp = zeros(dims.np);
+        ewbkp = zeros(dims.nw);
     }
 
     auto initialize(const MasterProblem& problem) -> void
@@ -112,6 +123,39 @@ struct ResidualErrors::Impl
         error = std::sqrt(ex.squaredNorm() + rp.squaredNorm() + ewbs.squaredNorm());
     }
 
+    auto assign(const Impl& other) -> void
+    {
+        ex = other.ex;
+        ep = other.ep;
+        ew = other.ew;
+        errorx = other.errorx;
+        errorp = other.errorp;
+        errorw = other.errorw;
+        error = other.error;
+    }
+
+    auto checkpoint() -> void
+    {
+        exbkp = ex;
+        epbkp = ep;
+        ewbkp = ew;
+        errorxbkp = errorx;
+        errorpbkp = errorp;
+        errorwbkp = errorw;
+        errorbkp = error;
+    }
+
+    auto restore() -> void
+    {
+        ex = exbkp;
+        ep = epbkp;
+        ew = ewbkp;
+        errorx = errorxbkp;
+        errorp = errorpbkp;
+        errorw = errorwbkp;
+        error = errorbkp;
+    }
+
     auto sanitycheck() const -> void
     {
         assert(dims.nx > 0);
@@ -156,6 +200,11 @@ auto ResidualErrors::operator=(ResidualErrors other) -> ResidualErrors&
     return *this;
 }
 
+auto ResidualErrors::assign(const ResidualErrors& other) -> void
+{
+    pimpl->assign(*other.pimpl);
+}
+
 auto ResidualErrors::initialize(const MasterProblem& problem) -> void
 {
     return pimpl->initialize(problem);
@@ -166,4 +215,14 @@ auto ResidualErrors::update(MasterVectorView u, const ResidualFunction& F) -> vo
     pimpl->update(u, F);
 }
 
+auto ResidualErrors::checkpoint() -> void
+{
+    pimpl->checkpoint();
+}
+
+auto ResidualErrors::restore() -> void
+{
+    pimpl->restore();
+}
+
 } // namespace Optima
@@ -56,11 +56,20 @@ public:
     /// Assign a ResidualErrors instance to this.
     auto operator=(ResidualErrors other) -> ResidualErrors&;
 
+    /// Assign the residual errors of another ResidualErrors instance to this reusing its memory.
+    auto assign(const ResidualErrors& other) -> void;
+
     /// Initialize the residual errors once before update computations.
     auto initialize(const MasterProblem& problem) -> void;
 
     /// Update the residual errors.
     auto update(MasterVectorView u, const ResidualFunction& F) -> void;
+
+    /// Save the current residual errors.
+    auto checkpoint() -> void;
+
+    /// Restore the residual errors saved in the last call to @ref checkpoint.
+    auto restore() -> void;
 };
 
 } // namespace Optima
@@ -18,10 +18,14 @@
 #include "ResidualFunction.hpp"
 
 // Optima includes
+#include <Optima/BFGS.hpp>
 #include <Optima/Canonicalizer.hpp>
 #include <Optima/EchelonizerW.hpp>
 #include <Optima/Exception.hpp>
+#include <Optima/IndexUtils.hpp>
+#include <Optima/Memory.hpp>
 #include <Optima/ResidualVector.hpp>
+#include <Optima/TaskPool.hpp>
 #include <Optima/Timing.hpp>
 #include <Optima/Utils.hpp>
 
@@ -47,6 +51,18 @@ struct ResidualFunction::Impl
     /// The priority weights for selection of basic variables in x.
     Vector wx;
 
+    /// The indices of the basic variables in x used in the last evaluation of *f*, *h* and *v* (its first *nbeval* entries).
+    Indices jbeval;
+
+    /// The number of basic variables in x used in the last evaluation of *f*, *h* and *v*.
+    Index nbeval = 0;
+
+    /// The structure of matrix *Jx* in the last evaluation of *h*.
+    MatrixStructure structureJx = MatrixStructure::Dense;
+
+    /// The structure of matrix *Wp = [Ap; Jp]* in the last evaluation of *h*.
+    MatrixStructure structureWp = MatrixStructure::Dense;
+
     /// The current stability status of the x variables.
     Stability stability;
 
@@ -77,35 +93,126 @@ struct ResidualFunction::Impl
     /// True if the last update call succeeded.
     bool succeeded = false;
 
+    /// The options for the evaluation of the residual function.
+    ResidualFunctionOptions options;
+
+    /// The worker threads for the concurrent evaluation of *h* and *v* (if enabled).
+    TaskPool pool;
+
+    /// The quasi-Newton approximation of *fxx* (if enabled).
+    BFGS bfgs;
+
+    /// The workspace for the gradient used in the updates of the quasi-Newton approximation of *fxx*.
+    Vector gx;
+
+    /// The constant Hessian matrix *fxx* evaluated in the first full evaluation of *f* (if enabled).
+    Matrix fxxconst;
+
+    /// True if the constant Hessian matrix *fxx* is diagonal.
+    bool diagfxxconst = false;
+
+    /// True if the constant Hessian matrix *fxx* has been evaluated since the last initialization.
+    bool hasfxxconst = false;
+
     Impl(const MasterDims& dims)
     : dims(dims),
       fres(dims.nx, dims.np),
       hres(dims.nz, dims.nx, dims.np),
       vres(dims.np, dims.nx, dims.np),
       echelonizerW(dims), stability(dims.nx),
-      canonicalizer(dims), residual(dims)
+      canonicalizer(dims), residual(dims), bfgs(dims.nx)
     {
         wx.resize(dims.nx);
+        gx.resize(dims.nx);
+        jbeval.resize(dims.nx);
+
+        // Note: The storage of the function evaluations (zero-initialized by
+        // their constructors) is reused in all updates, and so functions with
+        // constant zero entries in their results (e.g., derivatives with
+        // respect to slack variables) do not need to write them again (see
+        // MasterProblem).
+    }
+
+    auto setOptions(const ResidualFunctionOptions& opts) -> void
+    {
+        if(opts.hessian != options.hessian)
+            fres.fxx.setZero(); // the approximations of fxx (e.g., BFGS) overwrite all its entries, including those the functions never write
+        options = opts;
+        const auto nthreads = options.concurrent ? 2 : 0; // one worker thread for f and another for v, while h is evaluated in the calling thread
+        if(pool.size() != nthreads)
+            pool = TaskPool(nthreads);
+        if(options.hessian == HessianMethod::Constant && fxxconst.size() == 0)
+            fxxconst = zeros(dims.nx, dims.nx);
+        // Keep the canonical form fixed for a fixed partition only when the Jacobian matrix can be constant (see method result)
+        canonicalizer.setOrderByIndex(options.hessian == HessianMethod::Constant && dims.nz == 0 && dims.np == 0);
     }
 
     auto initialize(const MasterProblem& problem) -> void
     {
         echelonizerW.initialize(problem.Ax, problem.Ap);
+        structureJx = MatrixStructure::Zero; // updated in each evaluation of h if nz > 0
+        structureWp = detectMatrixStructure(echelonizerW.W().Wp);
         f      = problem.f;
         h      = problem.h;
         v      = problem.v;
         b      = problem.b;
         xlower = problem.xlower;
         xupper = problem.xupper;
+        bfgs.reset();
+        hasfxxconst = false;
+    }
+
+    /// Assign the evaluated state of another residual function to this one
+    /// reusing its memory. The functions, the problem data given in
+    /// initialize and the options are not assigned, since both residual
+    /// functions are expected to share them.
+    auto assign(const Impl& other) -> void
+    {
+        fres = other.fres;
+        hres = other.hres;
+        vres = other.vres;
+        echelonizerW.assign(other.echelonizerW);
+        wx = other.wx;
+        jbeval = other.jbeval;
+        nbeval = other.nbeval;
+        structureJx = other.structureJx;
+        structureWp = other.structureWp;
+        stability = other.stability;
+        canonicalizer.assign(other.canonicalizer);
+        residual.assign(other.residual);
+        succeeded = other.succeeded;
+        bfgs = other.bfgs;
+        fxxconst = other.fxxconst;
+        diagfxxconst = other.diagfxxconst;
+        hasfxxconst = other.hasfxxconst;
+    }
+
+    /// Copy from another residual function the state on which its next update depends.
+    /// This is the quasi-Newton approximation of *fxx* (if enabled) and the
+    /// constant Hessian matrix (if already evaluated). Note that the echelon
+    /// form of *W* is not copied, since the update of any echelon form of *W*
+    /// produces a valid one. The same holds for the storage of the function
+    /// evaluations, whose entries not written by the functions are constant.
+    auto assignUpdateState(const Impl& other) -> void
+    {
+        if(options.hessian == HessianMethod::BFGS)
+            bfgs = other.bfgs;
+        if(other.hasfxxconst && !hasfxxconst) // the constant Hessian matrix is the same in both otherwise
+        {
+            fxxconst     = other.fxxconst;
+            diagfxxconst = other.diagfxxconst;
+            hasfxxconst  = true;
+        }
     }
 
     auto update(MasterVectorView u) -> void
     {
         sanitycheck(u);
-        const auto status = updateFunctionEvals(u);
+        const auto status = updateFunctionEvals(u); // this also updates the echelon form of W
         if(status == FAILED)
             return;
-        updateEchelonFormMatrixW(u);
+        if(updateFunctionEvalsForNewBasicVariables(u) == FAILED)
+            return;
         updateIndicesStableVariables(u);
         updateCanonicalFormJacobianMatrix(u);
         updateResidualVector(u);
@@ -114,29 +221,150 @@ struct ResidualFunction::Impl
     auto updateSkipJacobian(MasterVectorView u) -> void
     {
         sanitycheck(u);
-        const auto status = updateFunctionEvalsSkippingJacobianEvals(u);
+        const auto status = updateFunctionEvalsSkippingJacobianEvals(u); // this also updates the echelon form of W
         if(status == FAILED)
             return;
-        updateEchelonFormMatrixW(u);
         updateIndicesStableVariables(u);
         updateCanonicalFormJacobianMatrix(u);
         updateResidualVector(u);
     }
 
+    /// Evaluate *f*, *h* and *v* at *x* and *p* in *u* and update the echelon form of *W*.
     template<bool evaljac>
     auto updateFunctionEvalsAux(MasterVectorView u) -> bool
     {
         const auto x = u.x;
         const auto p = u.p;
-        const auto RWQ = echelonizerW.RWQ();
-        const auto ibasicvars = RWQ.jb;
-        ObjectiveOptions  fopts{{evaljac, evaljac}, ibasicvars};
+        const auto jb = echelonizerW.RWQ().jb;
+        nbeval = jb.size();
+        jbeval.head(nbeval) = jb; // copy because the echelon form of W changes after the evaluations below
+        const auto evalh = dims.nz > 0; // skip functions without outputs (e.g., no p variables)
+        const auto evalv = dims.np > 0;
+        evalFunctions(x, p, true, evalh, evalv, evaljac, [&] { updateEchelonFormMatrixW(u); });
+        if(fres.succeeded && options.hessian == HessianMethod::BFGS)
+            updateHessianApproximation(x, p, evaljac);
+        if(fres.succeeded && options.hessian == HessianMethod::Constant)
+            updateConstantHessian(evaljac);
+        return succeeded = fres.succeeded && hres.succeeded && vres.succeeded;
+    }
+
+    /// Set *fxx* to its quasi-Newton approximation, first updated with the
+    /// gradient *fx* just evaluated at *(x, p)* if this is a full evaluation
+    /// (residual-only evaluations at trial states do not change it). The
+    /// change in *fx* caused by a change in *p* is removed using *fxp*, so
+    /// that only the curvature with respect to *x* is captured.
+    auto updateHessianApproximation(VectorView x, VectorView p, bool evaljac) -> void
+    {
+        if(evaljac)
+        {
+            gx.noalias() = fres.fx;
+            gx.noalias() -= fres.fxp * p;
+            bfgs.update(x, gx);
+        }
+        fres.fxx = bfgs.hessian();
+        fres.diagfxx = false;
+        fres.fxx4basicvars = false;
+    }
+
+    /// Set *fxx* to the constant Hessian matrix, which is first stored if
+    /// just evaluated in full (i.e., not only for basic variables).
+    auto updateConstantHessian(bool evaljac) -> void
+    {
+        if(hasfxxconst)
+        {
+            fres.fxx = fxxconst;
+            fres.diagfxx = diagfxxconst;
+            fres.fxx4basicvars = false;
+        }
+        else if(evaljac && !fres.fxx4basicvars)
+        {
+            fxxconst = fres.fxx;
+            diagfxxconst = fres.diagfxx;
+            hasfxxconst = true;
+        }
+    }
+
+    /// Evaluate the selected functions among *f*, *h* and *v* at *(x, p)*
+    /// and then execute `afterh`, which may depend only on the evaluation
+    /// of *h*. If concurrency is enabled in the options, *f* and *v* are
+    /// evaluated in worker threads, while *h* and then `afterh` (e.g., the
+    /// echelonization of *W*, which depends on *Jx* and *Jp* but not on
+    /// *fxx* or *v*) are executed in the calling thread. Otherwise, all
+    /// evaluations happen sequentially. In both cases, `afterh` is executed
+    /// if *h* succeeded (whether *f* and *v* did or not), so that both produce
+    /// the same state, and all evaluations have finished on return.
+    template<typename AfterH>
+    auto evalFunctions(VectorView x, VectorView p, bool evalf, bool evalh, bool evalv, bool evaljac, const AfterH& afterh) -> void
+    {
+        const auto evalfxx = evaljac && (options.hessian == HessianMethod::Exact || (options.hessian == HessianMethod::Constant && !hasfxxconst));
+        const auto ibasicvars = jbeval.head(nbeval);
+        ObjectiveOptions  fopts{{evalfxx, evaljac}, ibasicvars};
         ConstraintOptions hopts{{evaljac, evaljac}, ibasicvars};
         ConstraintOptions vopts{{evaljac, evaljac}, ibasicvars};
-        f(fres, x, p, fopts);
-        h(hres, x, p, hopts);
-        v(vres, x, p, vopts);
-        return succeeded = fres.succeeded && hres.succeeded && vres.succeeded;
+        EigenMallocScope malloc(true); // user functions are allowed to allocate memory
+        if(options.concurrent)
+        {
+            if(evalf) pool.enqueue([&] { f(fres, x, p, fopts); });
+            if(evalv) pool.enqueue([&] { v(vres, x, p, vopts); });
+            try
+            {
+                if(evalh) h(hres, x, p, hopts);
+                if(hres.succeeded) afterh();
+            }
+            catch(...)
+            {
+                pool.wait(); // f and v refer to objects in this scope and must finish before leaving it
+                throw;
+            }
+            pool.wait(); // ensure f and v have been evaluated before their results are used
+        }
+        else
+        {
+            if(evalf) f(fres, x, p, fopts);
+            if(evalh) h(hres, x, p, hopts);
+            if(evalv) v(vres, x, p, vopts);
+            if(hres.succeeded) afterh();
+        }
+    }
+
+    /// Re-evaluate the functions whose derivatives were computed only for
+    /// basic variables if the echelonization of W produced new basic
+    /// variables. This ensures that columns in *fxx*, *ddx* of *h* and
+    /// *ddx* of *v* are available for all current basic variables. Since
+    /// re-evaluating *h* changes *Jx* and thus possibly the basic variables
+    /// again, this is repeated until no new basic variables are produced.
+    /// The requested columns accumulate over the repetitions (those already
+    /// evaluated remain valid at the same *x*), which guarantees termination
+    /// after at most *nx* repetitions.
+    auto updateFunctionEvalsForNewBasicVariables(MasterVectorView u) -> bool
+    {
+        const auto any4basicvars = fres.fxx4basicvars || hres.ddx4basicvars || vres.ddx4basicvars;
+        if(!any4basicvars)
+            return SUCCEEDED;
+
+        const auto x = u.x;
+        const auto p = u.p;
+
+        while(true)
+        {
+            const auto jb = echelonizerW.RWQ().jb; // a view that changes after the evaluations below
+            const auto nprev = nbeval;
+            for(auto i : jb)
+                if(!contains(i, jbeval.head(nprev)))
+                    jbeval[nbeval++] = i;
+            if(nbeval == nprev)
+                return SUCCEEDED;
+
+            const auto evalf = fres.fxx4basicvars;
+            const auto evalh = hres.ddx4basicvars;
+            const auto evalv = vres.ddx4basicvars;
+            evalFunctions(x, p, evalf, evalh, evalv, true, [&] { if(evalh) updateEchelonFormMatrixW(u); });
+            succeeded = fres.succeeded && hres.succeeded && vres.succeeded;
+            if(!succeeded)
+                return FAILED;
+            if(!evalh) // the basic variables have not changed, since W has not changed
+                return SUCCEEDED;
+        }
     }
 
     auto updateFunctionEvals(MasterVectorView u) -> bool
@@ -159,6 +387,11 @@ struct ResidualFunction::Impl
         wx.noalias() = (x.array() != xlower.array()).select(wx, -1.0); // Enforce weak priority for variables on the bounds.
         wx.noalias() = (x.array() != xupper.array()).select(wx, -1.0); // Enforce weak priority for variables on the bounds.
         echelonizerW.update(Jx, Jp, wx);
+        if(dims.nz > 0) // otherwise, Wp = Ap is constant and its structure is detected in initialize
+        {
+            structureJx = detectMatrixStructure(Jx);
+            structureWp = detectMatrixStructure(echelonizerW.W().Wp);
+        }
     }
 
     auto updateIndicesStableVariables(MasterVectorView u) -> void
@@ -168,7 +401,10 @@ struct ResidualFunction::Impl
         const auto& w = u.w;
         const auto& Wx = echelonizerW.W().Wx;
         const auto& jb = echelonizerW.RWQ().jb;
-        stability.update({Wx, fx, x, w, xlower, xupper, jb});
+        const auto ny = dims.ny;
+        if(structureJx == MatrixStructure::Zero) // skip the zero rows Jx in Wx = [Ax; Jx]
+            stability.update({Wx.topRows(ny), fx, x, w.head(ny), xlower, xupper, jb});
+        else stability.update({Wx, fx, x, w, xlower, xupper, jb});
     }
 
     auto updateCanonicalFormJacobianMatrix(MasterVectorView u) -> void
@@ -190,7 +426,7 @@ struct ResidualFunction::Impl
         const auto& y = w.head(dims.ny);
         const auto& z = w.tail(dims.nz);
         const auto& Jc = jacobianMatrixCanonicalForm();
-        residual.update({Jc, Wx, Wp, x, p, y, z, fx, v, b, h});
+        residual.update({Jc, Wx, Wp, x, p, y, z, fx, v, b, h, hres.ddx4basicvars, structureJx, structureWp});
     }
 
     auto jacobianMatrixMasterForm() const -> MasterMatrix
@@ -198,8 +434,8 @@ struct ResidualFunction::Impl
         const auto& stabilitystatus = stability.status();
         const auto& js = stabilitystatus.js;
         const auto& ju = stabilitystatus.ju;
-        const auto& H = MatrixViewH{fres.fxx, fres.fxp, fres.diagfxx};
-        const auto& V = MatrixViewV{vres.ddx, vres.ddp};
+        const auto& H = MatrixViewH{fres.fxx, fres.fxp, fres.diagfxx, fres.fxx4basicvars};
+        const auto& V = MatrixViewV{vres.ddx, vres.ddp, vres.ddx4basicvars};
         const auto& W = echelonizerW.W();
         const auto& RWQ = echelonizerW.RWQ();
         return {dims, H, V, W, RWQ, js, ju};
@@ -228,7 +464,9 @@ struct ResidualFunction::Impl
         const auto Fc = residualVectorCanonicalForm();
         const auto stabilitystatus = stability.status();
 
-        return { fres, hres, vres, Jm, Jc, Fm, Fc, stabilitystatus, succeeded };
+        const auto constant = options.hessian == HessianMethod::Constant && hasfxxconst && dims.nz == 0 && dims.np == 0;
+
+        return { fres, hres, vres, Jm, Jc, Fm, Fc, stabilitystatus, succeeded, constant };
     }
 
     auto sanitycheck(MasterVectorView u) const -> void
@@ -256,21 +494,42 @@ ResidualFunction::~ResidualFunction()
 auto ResidualFunction::operator=(ResidualFunction other) -> ResidualFunction&
 {
     pimpl = std::move(other.pimpl);
+    pimplbkp.reset();
+    checkpointed = false;
+    saved = false;
     return *this;
 }
 
+auto ResidualFunction::assign(const ResidualFunction& other) -> void
+{
+    pimpl->assign(*other.pimpl);
+    checkpointed = false;
+    saved = false;
+}
+
+auto ResidualFunction::setOptions(const ResidualFunctionOptions& options) -> void
+{
+    pimpl->setOptions(options);
+    if(pimplbkp) pimplbkp->setOptions(options);
+}
+
 auto ResidualFunction::initialize(const MasterProblem& problem) -> void
 {
-    return pimpl->initialize(problem);
+    pimpl->initialize(problem);
+    pimplbkp.reset(new Impl(*pimpl)); // the spare state for checkpoints, allocated here so that these do not allocate memory
+    checkpointed = false;
+    saved = false;
 }
 
 auto ResidualFunction::update(MasterVectorView u) -> void
 {
+    keepCheckpoint();
     pimpl->update(u);
 }
 
 auto ResidualFunction::updateSkipJacobian(MasterVectorView u) -> void
 {
+    keepCheckpoint();
     pimpl->updateSkipJacobian(u);
 }
 
@@ -279,4 +538,40 @@ auto ResidualFunction::result() const -> ResidualFunctionResult
     return pimpl->result();
 }
 
+auto ResidualFunction::echelonFormAx() const -> std::shared_ptr<const EchelonFormAx>
+{
+    return pimpl->echelonizerW.echelonFormAx();
+}
+
+auto ResidualFunction::setEchelonFormAx(const std::shared_ptr<const EchelonFormAx>& echelonform) -> void
+{
+    pimpl->echelonizerW.setEchelonFormAx(echelonform);
+}
+
+auto ResidualFunction::checkpoint() -> void
+{
+    checkpointed = true;
+    saved = false; // the current state is moved aside only if an update follows (see keepCheckpoint)
+}
+
+auto ResidualFunction::restore() -> void
+{
+    error(!checkpointed, "ResidualFunction::restore failed because there is no saved state. "
+        "Ensure method ResidualFunction::checkpoint has been called before.");
+    if(saved)
+        std::swap(pimpl, pimplbkp); // the current state becomes the spare state for the next checkpoint
+    checkpointed = false;
+    saved = false;
+}
+
+auto ResidualFunction::keepCheckpoint() -> void
+{
+    if(!checkpointed || saved)
+        return;
+    if(pimplbkp) pimplbkp->assignUpdateState(*pimpl);
+    else pimplbkp.reset(new Impl(*pimpl)); // e.g., in a copy of an initialized residual function
+    std::swap(pimpl, pimplbkp); // the checkpointed state is kept aside and the spare state is updated instead
+    saved = true;
+}
+
 } // namespace Optima
@@ -25,10 +25,12 @@
 #include <Optima/CanonicalVector.hpp>
 #include <Optima/Constants.hpp>
 #include <Optima/ConstraintFunction.hpp>
+#include <Optima/EchelonizerW.hpp>
 #include <Optima/MasterMatrix.hpp>
 #include <Optima/MasterProblem.hpp>
 #include <Optima/MasterVector.hpp>
 #include <Optima/ObjectiveFunction.hpp>
+#include <Optima/ResidualFunctionOptions.hpp>
 #include <Optima/Stability.hpp>
 
 namespace Optima {
@@ -71,6 +73,12 @@ struct ResidualFunctionResult
 
     /// True if all functions *f*, *h* and *v* were successfully evaluated.
     bool succeeded;
+
+    /// True if the Jacobian matrix is constant for given basic and stable variables.
+    /// This is the case for a constant Hessian matrix *fxx* (see HessianMethod::Constant)
+    /// without functions *h* and *v*, and so a decomposition of the Jacobian matrix can be
+    /// reused while its basic and stable variables do not change.
+    bool constant;
 };
 
 /// Used to represent the residual function *F(u)* in the Newton step problem.
@@ -89,6 +97,17 @@ public:
     /// Assign a ResidualFunction object to this.
     auto operator=(ResidualFunction other) -> ResidualFunction&;
 
+    /// Assign the evaluated state of another residual function to this one.
+    /// Contrary to the assignment operator, the memory of this object is
+    /// reused, and so no memory is allocated if both have been initialized
+    /// with the same problem and their echelon forms of *W* have the same
+    /// rank. The options and the problem of this object are not changed, and
+    /// its last checkpoint is discarded.
+    auto assign(const ResidualFunction& other) -> void;
+
+    /// Set the options for the evaluation of the residual function.
+    auto setOptions(const ResidualFunctionOptions& options) -> void;
+
     /// Initialize the residual function once before update computations.
     auto initialize(const MasterProblem& problem) -> void;
 
@@ -101,10 +120,40 @@ public:
     /// Return the result of the evaluation of the residual function.
     auto result() const -> ResidualFunctionResult;
 
+    /// Return the echelon form of *Ax* computed in the last call to @ref initialize (see EchelonizerW::echelonFormAx).
+    auto echelonFormAx() const -> std::shared_ptr<const EchelonFormAx>;
+
+    /// Set the echelon form of *Ax* to be reused in the next call to @ref initialize (see EchelonizerW::setEchelonFormAx).
+    auto setEchelonFormAx(const std::shared_ptr<const EchelonFormAx>& echelonform) -> void;
+
+    /// Save the current evaluated state of the residual function.
+    /// The saved state can be recovered with @ref restore without any
+    /// re-evaluation of the objective and constraint functions. The state is
+    /// not copied: the next update is performed in a spare state instead.
+    auto checkpoint() -> void;
+
+    /// Restore the evaluated state of the residual function saved in the last call to @ref checkpoint.
+    /// A saved state can be restored only once. Views obtained from @ref
+    /// result before this call should not be used afterwards.
+    auto restore() -> void;
+
 private:
     struct Impl;
 
+    /// The current evaluated state of the residual function.
     std::unique_ptr<Impl> pimpl;
+
+    /// The evaluated state saved in the last checkpoint if `saved` is true, otherwise a spare state.
+    std::unique_ptr<Impl> pimplbkp;
+
+    /// True if a checkpoint has been made and not yet restored.
+    bool checkpointed = false;
+
+    /// True if the state of the last checkpoint has been moved to `pimplbkp` (i.e., updates followed it).
+    bool saved = false;
+
+    /// Keep the state of the last checkpoint aside before it is changed by an update.
+    auto keepCheckpoint() -> void;
 };
 
 } // namespace Optima
@@ -0,0 +1,72 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace Optima {
+
+/// Used to describe the possible methods for obtaining the Hessian matrix *fxx* of the objective function.
+enum class HessianMethod
+{
+    /// The Hessian matrix *fxx* is evaluated by the objective function.
+    Exact,
+
+    /// The Hessian matrix *fxx* is approximated with damped BFGS updates.
+    /// The approximation is updated from the gradients *fx* at successive
+    /// iterates and the objective function is always evaluated with
+    /// ObjectiveOptions::Eval::fxx set to false. This is suitable when the
+    /// Hessian matrix is much more expensive to evaluate than the gradient.
+    /// Expect more iterations than with exact Hessian matrices, since the
+    /// approximation captures the curvature of the objective function only
+    /// gradually, but cheaper ones if the Hessian matrix is expensive to
+    /// evaluate. The approximation is a dense matrix, since the update of a
+    /// diagonal one would not capture the curvature along the steps. Thus, ObjectiveResult::diagfxx is always
+    /// false in this mode, the fast paths for diagonal Hessian matrices (e.g.,
+    /// in the canonical form of the Jacobian matrix) are not used, and
+    /// LinearSolverMethod::Rangespace, which requires diagonal Hessian
+    /// matrices, should not be used.
+    BFGS,
+
+    /// The Hessian matrix *fxx* is constant, as in linear and quadratic programs.
+    /// The Hessian matrix is evaluated only in the first full evaluation of the
+    /// objective function in each calculation, and the objective function is
+    /// evaluated afterwards with ObjectiveOptions::Eval::fxx set to false. If in
+    /// addition there are no functions *h* and *v*, the Jacobian matrix changes
+    /// only with the basic and stable variables, and its decomposition is reused
+    /// while these do not change. If the Hessian matrix is evaluated only for
+    /// basic variables (ObjectiveResult::fxx4basicvars), it is evaluated every time.
+    Constant,
+};
+
+/// Used to organize the options for the evaluation of the residual function.
+struct ResidualFunctionOptions
+{
+    /// The flag that enables the concurrent evaluation of *f(x, p)*, *h(x, p)* and *v(x, p)*.
+    /// When enabled, *f* and *v* are evaluated in worker threads while *h* and
+    /// then the echelonization of *W* happen in the calling thread. Enable this
+    /// only if these functions are expensive and can safely be evaluated at the
+    /// same time (e.g., they do not modify shared state). Exceptions thrown by
+    /// them are rethrown in the calling thread once all evaluations finish.
+    /// Python callbacks hold the GIL while executed, so they only overlap
+    /// with each other where they release it (e.g., in numpy operations).
+    bool concurrent = false;
+
+    /// The method for obtaining the Hessian matrix *fxx* of the objective function.
+    HessianMethod hessian = HessianMethod::Exact;
+};
+
+} // namespace Optima
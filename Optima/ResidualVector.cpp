@@ -57,9 +57,25 @@ struct ResidualVector::Impl
         xsu.resize(nx);
     }
 
+    /// Assign another ResidualVector::Impl object to this reusing its memory.
+    auto assign(const Impl& other) -> void
+    {
+        assert(dims.nx == other.dims.nx && dims.np == other.dims.np && dims.nw == other.dims.nw);
+        ns     = other.ns;
+        nu     = other.nu;
+        nbs    = other.nbs;
+        ax     = other.ax;
+        aw     = other.aw;
+        ap     = other.ap;
+        asu    = other.asu;
+        awbs   = other.awbs;
+        awstar = other.awstar;
+        xsu    = other.xsu;
+    }
+
     auto update(ResidualVectorUpdateArgs args) -> void
     {
-        const auto [Mc, Wx, Wp, x, p, y, z, g, v, b, h] = args;
+        const auto [Mc, Wx, Wp, x, p, y, z, g, v, b, h, isJx4basicvars, structureJx, structureWp] = args;
         const auto [nx, np, ny, nz, nw, nt] = dims;
 
         assert(x.size() == nx);
@@ -85,17 +101,12 @@ struct ResidualVector::Impl
         const auto Jx = Wx.bottomRows(nz);
         const auto Jp = Wp.bottomRows(nz);
 
-        const auto As = Ax(all, js);
-        const auto Au = Ax(all, ju);
-
-        const auto Js = Jx(all, js);
+        const auto jbs = js.head(nbs);
 
         const auto Rbs   = Mc.Rbs;
         const auto Sbsns = Mc.Sbsns;
         const auto Sbsp  = Mc.Sbsp;
 
-        const auto gs = g(js);
-
         auto as = asu.head(ns);
         auto au = asu.tail(nu);
 
@@ -111,22 +122,55 @@ struct ResidualVector::Impl
         xs = x(js);
         xu = x(ju);
 
-        ax(js).noalias() = -(gs + tr(As)*y + tr(Js)*z);
+        const auto zeroJx = structureJx == MatrixStructure::Zero;
+        const auto zeroWp = structureWp == MatrixStructure::Zero;
+        const auto zeroSbsns = Mc.structure.Sbsns == MatrixStructure::Zero;
+        const auto zeroSbsp = Mc.structure.Sbsp == MatrixStructure::Zero;
+
+        // Note: The products below are performed either with the full
+        // matrices Ax, Jx or column by column, and never with indexed views
+        // such as Ax(all, js), which Eigen would evaluate into temporaries.
+        ax = -g;
+        ax.noalias() -= tr(Ax)*y;
+        if(zeroJx) {}
+        else if(isJx4basicvars)
+            for(auto i : jbs) ax[i] -= Jx.col(i).dot(z); // skip the zero columns of Jx corresponding to non-basic variables
+        else ax.noalias() -= tr(Jx)*z;
+
         ax(ju).fill(0.0);
 
         as = ax(js);
         au.fill(0.0);
 
-        ay.noalias() = -(Ax*x + Ap*p - b);
-        az.noalias() = -h;
+        ay = b;
+        ay.noalias() -= Ax*x;
+        if(!zeroWp) ay.noalias() -= Ap*p;
+        az = -h;
 
         ap = -v;
 
-        awstar.head(ny) = b - Au*xu;
-        awstar.tail(nz) = Js*xs + Jp*p - h;
+        auto awstary = awstar.head(ny);
+        auto awstarz = awstar.tail(nz);
 
-        awbs = multiplyMatrixVectorWithoutResidualRoundOffError(Rbs, awstar);
-        awbs.noalias() -= xbs + Sbsns*xns + Sbsp*args.p;
+        awstary = b;
+        for(auto k = 0; k < nu; ++k)
+            awstary -= Ax.col(ju[k]) * xu[k];
+
+        awstarz = -h;
+        if(!zeroWp) awstarz.noalias() += Jp*p;
+        if(zeroJx) {}
+        else if(isJx4basicvars)
+            for(auto k = 0; k < nbs; ++k)
+                awstarz += Jx.col(jbs[k]) * xbs[k];
+        else for(auto k = 0; k < ns; ++k)
+            awstarz += Jx.col(js[k]) * xs[k];
+
+        auto awbs = this->awbs.head(nbs);
+
+        multiplyMatrixVectorWithoutResidualRoundOffError(Rbs, awstar, awbs);
+        awbs -= xbs;
+        if(!zeroSbsns) awbs.noalias() -= Sbsns*xns;
+        if(!zeroSbsp) awbs.noalias() -= Sbsp*args.p;
     }
 
     auto masterVector() const -> MasterVectorView
@@ -138,6 +182,7 @@ struct ResidualVector::Impl
     {
         const auto as = asu.head(ns);
         const auto au = asu.tail(nu);
+        const auto awbs = this->awbs.head(nbs);
         return {as, au, ap, awbs};
     }
 };
@@ -159,6 +204,11 @@ auto ResidualVector::operator=(ResidualVector other) -> ResidualVector&
     return *this;
 }
 
+auto ResidualVector::assign(const ResidualVector& other) -> void
+{
+    pimpl->assign(*other.pimpl);
+}
+
 auto ResidualVector::update(ResidualVectorUpdateArgs args) -> void
 {
     pimpl->update(args);
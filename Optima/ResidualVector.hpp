@@ -42,6 +42,9 @@ struct ResidualVectorUpdateArgs
     VectorView v;
     VectorView b;
     VectorView h;
+    bool isJx4basicvars = false; ///< True if *Jx* is non-zero only on columns corresponding to basic variables.
+    MatrixStructure structureJx = MatrixStructure::Dense; ///< The structure of matrix *Jx* (zero blocks are skipped in the computation).
+    MatrixStructure structureWp = MatrixStructure::Dense; ///< The structure of matrix *Wp = [Ap; Jp]* (zero blocks are skipped in the computation).
 };
 
 /// Used to represent the residual vector in the optimization problem.
@@ -65,6 +68,10 @@ public:
     /// Assign a ResidualVector instance to this.
     auto operator=(ResidualVector other) -> ResidualVector&;
 
+    /// Assign another ResidualVector instance to this reusing its memory.
+    /// No memory is allocated if the matrices in both have the same dimensions.
+    auto assign(const ResidualVector& other) -> void;
+
     /// Update the residual vector.
     auto update(ResidualVectorUpdateArgs args) -> void;
 
@@ -17,14 +17,24 @@
 
 #include "Result.hpp"
 
+// C++ includes
+#include <algorithm>
+
 namespace Optima {
 
 auto Result::operator+=(const Result& other) -> Result&
 {
-    succeeded              = other.succeeded;
+    if(succeeded && !other.succeeded)
+        failure_reason     = other.failure_reason;
+    succeeded              = succeeded && other.succeeded;
+    interrupted            = interrupted || other.interrupted;
     iterations            += other.iterations;
     num_objective_evals   += other.num_objective_evals;
-    error                  = other.error;
+    num_linear_decompositions += other.num_linear_decompositions;
+    num_echelonizations   += other.num_echelonizations;
+    error                  = std::max(error, other.error);
+    error_optimality       = std::max(error_optimality, other.error_optimality);
+    error_feasibility      = std::max(error_feasibility, other.error_feasibility);
     time                  += other.time;
     time_objective_evals  += other.time_objective_evals;
     time_constraint_evals += other.time_constraint_evals;
@@ -35,6 +35,13 @@ public:
     /// The number of iterations in the optimization calculation.
     Index iterations = 0;
 
+    /// The flag that indicates if the solution was accepted from a prediction of the solution cache.
+    bool predicted = false;
+
+    /// The flag that indicates if the optimization calculation was interrupted by its time limit or cancellation.
+    /// In this case, the returned state is the iterate with least error found before the interruption.
+    bool interrupted = false;
+
     /// The final residual error of the optimization calculation.
     double error = 0;
 
@@ -59,6 +66,12 @@ public:
     /// The number of evaluations of *fxp(x, p)* in the optimization calculation.
     Index num_objective_evals_fxp = 0;
 
+    /// The number of decompositions of the Jacobian matrix in the optimization calculation.
+    Index num_linear_decompositions = 0;
+
+    /// The number of echelonizations of the matrix *Ax* in the optimization calculation (zero if reused from a previous one with the same *Ax*).
+    Index num_echelonizations = 0;
+
     /// The wall time spent for the optimization calculation (in unit of s).
     double time = 0;
 
@@ -87,6 +100,11 @@ public:
     double time_sensitivities = 0;
 
     /// Update this Result instance with another by addition.
+    /// The combined calculation succeeds only if both succeed (with the
+    /// failure reason of the first that fails), and its errors are the
+    /// largest ones of both. The numbers and times are added, so the
+    /// combined result of calculations performed concurrently should have
+    /// its time set afterwards to the wall time spent for them.
     auto operator+=(const Result& other) -> Result&;
 };
 
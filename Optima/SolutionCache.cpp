@@ -0,0 +1,206 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "SolutionCache.hpp"
+
+// C++ includes
+#include <algorithm>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/LinearSolver.hpp>
+
+namespace Optima {
+
+/// The cached solutions of a SolutionCache object.
+struct SolutionCacheEntries
+{
+    Matrix B;       ///< The vectors *b* of the cached solutions (column-wise).
+    Matrix U;       ///< The cached solutions *u = (x, p, w)* (column-wise).
+    Matrix S;       ///< The sensitivity derivatives *du/db* of the cached solutions (in consecutive blocks of *ny* columns).
+    Index count = 0; ///< The number of cached solutions.
+    Index next = 0;  ///< The index of the cache slot to be used by the next stored solution.
+};
+
+struct SolutionCache::Impl
+{
+    const MasterDims dims;          ///< The dimensions of the master variables.
+    SolutionCacheOptions options;   ///< The options of the solution cache.
+    LinearSolverOptions lsoptions;  ///< The options of the linear solver for the sensitivity derivatives.
+    std::unique_ptr<LinearSolver> linearsolver; ///< The linear solver for the sensitivity derivatives, created when first needed (not copied).
+    MasterVector a;                 ///< The right-hand side vector in the calculation of the sensitivity derivatives.
+    MasterVector du;                ///< The sensitivity derivatives of *u* with respect to a component of *b*.
+    Vector db;                      ///< The workspace for the difference between the new and the nearest cached *b*.
+    Vector unew;                    ///< The workspace for the predicted solution.
+
+    /// The cached solutions, shared by the copies of this object until one of them changes them (copy-on-write).
+    std::shared_ptr<SolutionCacheEntries> entries = std::make_shared<SolutionCacheEntries>();
+
+    Impl(const MasterDims& dims)
+    : dims(dims), a(dims), du(dims), db(dims.ny), unew(dims.nt)
+    {
+    }
+
+    Impl(const Impl& other)
+    : dims(other.dims), options(other.options), lsoptions(other.lsoptions),
+      a(other.dims), du(other.dims), db(other.dims.ny), unew(other.dims.nt),
+      entries(other.entries)
+    {
+    }
+
+    auto setOptions(const Options& opts) -> void
+    {
+        error(opts.solutioncache.capacity < 0, "The capacity of the solution cache cannot be negative.");
+        const auto resized = opts.solutioncache.capacity != options.capacity;
+        options = opts.solutioncache;
+        lsoptions = opts.newtonstep.linearsolver;
+        if(linearsolver)
+            linearsolver->setOptions(lsoptions);
+        if(resized || !options.active)
+            clear();
+    }
+
+    auto clear() -> void
+    {
+        entries = std::make_shared<SolutionCacheEntries>();
+    }
+
+    auto predict(VectorView b, MasterVectorRef u) -> bool
+    {
+        const auto& [B, U, S, count, next] = *entries;
+
+        if(!options.active || count == 0)
+            return false;
+
+        const auto nx = dims.nx;
+        const auto np = dims.np;
+        const auto ny = dims.ny;
+        const auto nw = dims.nw;
+
+        Index k = 0;
+        (B.leftCols(count).colwise() - b).colwise().squaredNorm().minCoeff(&k);
+
+        db.noalias() = b - B.col(k);
+        unew.noalias() = U.col(k);
+        unew.noalias() += S.middleCols(k*ny, ny) * db;
+
+        u.x = unew.head(nx);
+        u.p = unew.segment(nx, np);
+        u.w = unew.tail(nw);
+
+        return true;
+    }
+
+    auto store(VectorView b, MasterVectorView u, const ResidualFunction& F) -> void
+    {
+        if(!options.active || options.capacity == 0)
+            return;
+
+        const auto ny = dims.ny;
+        const auto nu = dims.nt;
+
+        if(entries.use_count() > 1) // the cached solutions are shared with a copy of this object
+            entries = std::make_shared<SolutionCacheEntries>(*entries);
+
+        auto& [B, U, S, count, next] = *entries;
+
+        if(B.cols() != options.capacity)
+        {
+            B.resize(ny, options.capacity);
+            U.resize(nu, options.capacity);
+            S.resize(nu, options.capacity * ny);
+            count = 0;
+            next = 0;
+        }
+
+        // The solution u(b) satisfies F(u, b) = 0, where b enters only in the
+        // residual of the linear equality constraints, which is (b - Ax*x - Ap*p)
+        // in the master residual vector. Thus, the sensitivity derivatives
+        // du/db[i] are the solutions of J*du = a with a = (0, 0, e[i]).
+        const auto Jc = F.result().Jc;
+
+        if(!linearsolver)
+        {
+            linearsolver.reset(new LinearSolver(dims));
+            linearsolver->setOptions(lsoptions);
+        }
+
+        linearsolver->decompose(Jc);
+
+        a.x.fill(0.0);
+        a.p.fill(0.0);
+        a.w.fill(0.0);
+
+        for(auto i = 0; i < ny; ++i)
+        {
+            a.w[i] = 1.0;
+            linearsolver->solve(Jc, a, du);
+            a.w[i] = 0.0;
+            S.col(next*ny + i) << du.x, du.p, du.w;
+        }
+
+        B.col(next) = b;
+        U.col(next) << u.x, u.p, u.w;
+
+        next = (next + 1) % options.capacity;
+        count = std::min(count + 1, options.capacity);
+    }
+};
+
+SolutionCache::SolutionCache(const MasterDims& dims)
+: pimpl(new Impl(dims))
+{}
+
+SolutionCache::SolutionCache(const SolutionCache& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+SolutionCache::~SolutionCache()
+{}
+
+auto SolutionCache::operator=(SolutionCache other) -> SolutionCache&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto SolutionCache::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto SolutionCache::clear() -> void
+{
+    pimpl->clear();
+}
+
+auto SolutionCache::size() const -> Index
+{
+    return pimpl->entries->count;
+}
+
+auto SolutionCache::predict(VectorView b, MasterVectorRef u) -> bool
+{
+    return pimpl->predict(b, u);
+}
+
+auto SolutionCache::store(VectorView b, MasterVectorView u, const ResidualFunction& F) -> void
+{
+    pimpl->store(b, u, F);
+}
+
+} // namespace Optima
@@ -0,0 +1,73 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/MasterVector.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/ResidualFunction.hpp>
+
+namespace Optima {
+
+/// Used to store converged solutions and predict new ones with first-order Taylor expansions.
+class SolutionCache
+{
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+
+public:
+    /// Construct a SolutionCache object.
+    SolutionCache(const MasterDims& dims);
+
+    /// Construct a copy of a SolutionCache object.
+    SolutionCache(const SolutionCache& other);
+
+    /// Destroy this SolutionCache object.
+    virtual ~SolutionCache();
+
+    /// Assign a SolutionCache object to this.
+    auto operator=(SolutionCache other) -> SolutionCache&;
+
+    /// Set the options of this SolutionCache object.
+    auto setOptions(const Options& options) -> void;
+
+    /// Remove all cached solutions.
+    auto clear() -> void;
+
+    /// Return the number of cached solutions.
+    auto size() const -> Index;
+
+    /// Predict the solution for given *b* from the cached solution whose *b* is nearest.
+    /// @param b The right-hand side vector *b* of the linear equality constraints.
+    /// @param[out] u The predicted solution *u = (x, p, w)*, unchanged if no prediction is possible.
+    /// @return `true` if a prediction was made.
+    auto predict(VectorView b, MasterVectorRef u) -> bool;
+
+    /// Store a converged solution together with its sensitivity derivatives with respect to *b*.
+    /// @param b The right-hand side vector *b* of the linear equality constraints.
+    /// @param u The converged solution *u = (x, p, w)*.
+    /// @param F The residual function evaluated at *u* (with Jacobian).
+    auto store(VectorView b, MasterVectorView u, const ResidualFunction& F) -> void;
+};
+
+} // namespace Optima
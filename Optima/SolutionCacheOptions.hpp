@@ -0,0 +1,42 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/Index.hpp>
+
+namespace Optima {
+
+/// Used to organize the options for the cache of converged solutions.
+struct SolutionCacheOptions
+{
+    /// True if converged solutions are cached and used to predict the solutions of subsequent calculations.
+    /// When active, each converged solution is stored together with its
+    /// sensitivity derivatives with respect to *b*. A new calculation then
+    /// starts with a first-order prediction from the cached solution whose *b*
+    /// is nearest. The prediction is accepted if it satisfies the convergence
+    /// tolerance, in which case no Newton iteration is performed. Otherwise,
+    /// the calculation is warm-started from the prediction, or from the given
+    /// initial guess if the residual could not be evaluated at the prediction.
+    bool active = false;
+
+    /// The maximum number of cached solutions (the oldest one is replaced when this is reached).
+    Index capacity = 100;
+};
+
+} // namespace Optima
@@ -19,10 +19,12 @@
 
 // Optima includes
 #include <Optima/Constants.hpp>
+#include <Optima/Decomposer.hpp>
 #include <Optima/Exception.hpp>
 #include <Optima/IndexUtils.hpp>
 #include <Optima/MasterSolver.hpp>
 #include <Optima/Options.hpp>
+#include <Optima/Presolver.hpp>
 #include <Optima/Problem.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/State.hpp>
@@ -45,13 +47,33 @@ auto initMasterSolver(const Problem& problem) -> MasterSolver
     return MasterSolver(MasterDims{nxrs, np, ny, nz});
 }
 
+/// Return the basic variables in *x* among the given ones in xrs = (x, r, s), stored in *jbx*.
+auto basicVariablesInX(IndicesView jbxrs, Index nx, IndicesRef jbx) -> IndicesView
+{
+    Index k = 0;
+    for(auto i : jbxrs)
+        if(i < nx)
+            jbx[k++] = i;
+    return jbx.head(k);
+}
+
+/// Copy a block of the optimization problem into its block in the master problem only if they differ.
+template<typename Block, typename Source>
+auto refresh(Block&& block, const Source& source) -> void
+{
+    if(block != source)
+        block = source;
+}
+
 } // namespace detail
 
 struct Solver::Impl
 {
     const Dims dims;           ///< The dimensions of variables and constraints in the optimization problem.
     MasterSolver msolver;      ///< The master optimization solver.
-    MasterProblem mproblem;    ///< The master optimization problem.
+    MasterProblem mproblem;    ///< The master optimization problem (assembled once and refreshed in place in each solve call).
+    Presolver presolver;       ///< The presolver used to reduce the optimization problem before its solution.
+    Decomposer decomposer;     ///< The decomposer used to split the optimization problem into independent subproblems.
     Index nx   = 0;            ///< The number of variables x in xrs = (x, r, s) = (x, xbg, xhg) = xbar.
     Index nr   = 0;            ///< The number of variables r in xrs = (x, r, s) = (x, xbg, xhg) = xbar.
     Index ns   = 0;            ///< The number of variables s in xrs = (x, r, s) = (x, xbg, xhg) = xbar.
@@ -59,13 +81,13 @@ struct Solver::Impl
     Index np   = 0;            ///< The number of parameter variables p.
     Index ny   = 0;            ///< The number of Lagrange multipliers y (i.e., the dimension of vector b = (be, bg)).
     Index nz   = 0;            ///< The number of Lagrange multipliers z (i.e., the dimension of vector h = (he, hg)).
-    Vector xrslower;           ///< The lower bounds of vector xrs = (x, xbg, xhg) in the master optimization problem.
-    Vector xrsupper;           ///< The upper bounds of vector xrs = (x, xbg, xhg) in the master optimization problem.
     Indices iordering;         ///< The ordering of the variables xrs = (x, xbg, xhg) as (*stable*, *lower unstable*, *upper unstable*).
+    Indices jbf, jbh, jbv;     ///< The basic variables in x given to f, h and v (separate, since these may be evaluated concurrently).
+    const Problem* problemptr = nullptr; ///< The optimization problem in the current solve call, used in the functions of the master problem.
 
     /// Construct a Solver instance with given optimization problem.
     Impl(const Problem& problem)
-    : dims(problem.dims), msolver(detail::initMasterSolver(problem))
+    : dims(problem.dims), msolver(detail::initMasterSolver(problem)), presolver(problem.dims), decomposer(problem.dims)
     {
         // Initialize dimension variables
         nx   = dims.x;
@@ -76,189 +98,245 @@ struct Solver::Impl
         ny   = dims.be + dims.bg;
         nz   = dims.he + dims.hg;
 
-        // Initialize vectors
-        xrslower.resize(nxrs);
-        xrsupper.resize(nxrs);
-
         // Initialize the ordering of the variables.
         iordering = indices(nxrs);
+
+        // Initialize the storage of the basic variables in x given to f, h and v
+        jbf.resize(nx);
+        jbh.resize(nx);
+        jbv.resize(nx);
+
+        // Initialize the constant parts of the master problem once. The
+        // remaining parts are refreshed in place in each solve call.
+
+        // Initialize matrix Ax = [ [Aex, 0, 0], [Agx, I, 0] ] with its constant blocks
+        mproblem.Ax = zeros(ny, nxrs);
+        mproblem.Ax.middleCols(nx, nr).bottomRows(nr).diagonal().fill(1.0);
+
+        // Initialize matrix Ap = [ [Aep], [Agp] ]
+        mproblem.Ap = zeros(ny, np);
+
+        // Initialize vector b = (be, bg)
+        mproblem.b = zeros(ny);
+
+        // Initialize the bounds of xrs = (x, xbg, xhg), with xbg and xhg non-positive
+        mproblem.xlower = constants(nxrs, -infinity());
+        mproblem.xupper = constants(nxrs, infinity());
+        mproblem.xupper.tail(nr + ns).fill(0.0);
+
+        // Initialize the bounds of p
+        mproblem.plower = constants(np, -infinity());
+        mproblem.pupper = constants(np, infinity());
+
+        initMasterFunctions();
+    }
+
+    /// Construct a copy of a Solver instance.
+    Impl(const Impl& other)
+    : dims(other.dims), msolver(other.msolver), mproblem(other.mproblem), presolver(other.presolver), decomposer(other.decomposer),
+      nx(other.nx), nr(other.nr), ns(other.ns), nxrs(other.nxrs),
+      np(other.np), ny(other.ny), nz(other.nz), iordering(other.iordering),
+      jbf(other.jbf), jbh(other.jbh), jbv(other.jbv)
+    {
+        initMasterFunctions(); // the functions in other.mproblem refer to other
     }
 
     /// Set the options for the optimization calculation.
     auto setOptions(const Options& options) -> void
     {
         msolver.setOptions(options);
+        presolver.setOptions(options);
+        decomposer.setOptions(options);
     }
 
-    /// Solve the optimization problem.
-    auto solve(const Problem& problem, State& state) -> Result
+    /// Initialize the functions f, h, v of the master optimization problem.
+    auto initMasterFunctions() -> void
     {
-        error(!problem.f.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the objective function. "
-            "Ensure Problem::f is properly initialized.");
-
-        error(dims.he > 0 && !problem.he.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the constraint function he(x, p). "
-            "Ensure Problem::he is properly initialized.");
-
-        error(dims.hg > 0 && !problem.hg.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the constraint function hg(x, p). "
-            "Ensure Problem::hg is properly initialized.");
-
-        error(dims.p > 0 && !problem.v.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the complementary constraint function v(x, p). "
-            "Ensure Problem::v is properly initialized.");
+        // Note: The functions below are evaluated in place on zero-initialized
+        // storage that is not zeroed again between calls (see MasterProblem).
+        // Thus, the blocks of the derivatives with respect to the slack
+        // variables r and s, which are constant, are never written here,
+        // except the identity block in hg_s (only its diagonal). Only the
+        // blocks written by the functions of Problem are set to zero before
+        // their evaluation (see Problem), instead of all the
+        // O((nx + nr + ns)^2) entries of the results in each call. The basic
+        // variables given to the functions of Problem are those in x only.
 
         // Create the objective function for the master optimization problem
-        mproblem.f = [&](ObjectiveResultRef res, VectorView xrs, VectorView p, ObjectiveOptions opts)
+        mproblem.f = [this](ObjectiveResultRef res, VectorView xrs, VectorView p, ObjectiveOptions opts)
         {
             // Views to sub-vectors in xrs = (x, r, s)
             const auto x = xrs.head(nx);
-            const auto r = xrs.segment(nx, nr);
-            const auto s = xrs.tail(ns);
 
-            // Views to sub-vectors in fxrs = (fx, fr, fs)
+            // Views to sub-vectors in fxrs = (fx, fr, fs), with fr = 0 and fs = 0
             auto fx = res.fx.head(nx);
-            auto fr = res.fx.segment(nx, nr);
-            auto fs = res.fx.tail(ns);
 
-            // Views to sub-matrices in fxrsxrs = [ [fxx fxr fxs], [frx frr frs], [fsx fsr fss] ]
+            // Views to sub-matrices in fxrsxrs = [ [fxx 0 0], [0 0 0], [0 0 0] ]
             auto fxx = res.fxx.topRows(nx).leftCols(nx);
-            auto fxr = res.fxx.topRows(nx).middleCols(nx, nr);
-            auto fxs = res.fxx.topRows(nx).rightCols(ns);
-
-            auto frx = res.fxx.middleRows(nx, nr).leftCols(nx);
-            auto frr = res.fxx.middleRows(nx, nr).middleCols(nx, nr);
-            auto frs = res.fxx.middleRows(nx, nr).rightCols(ns);
 
-            auto fsx = res.fxx.bottomRows(ns).leftCols(nx);
-            auto fsr = res.fxx.bottomRows(ns).middleCols(nx, nr);
-            auto fss = res.fxx.bottomRows(ns).rightCols(ns);
-
-            // Views to sub-matrices in fxrsp = [ [fxp], [frp], [fsp] ]
+            // Views to sub-matrices in fxrsp = [ [fxp], [0], [0] ]
             auto fxp = res.fxp.topRows(nx);
-            auto frp = res.fxp.middleRows(nx, nr);
-            auto fsp = res.fxp.bottomRows(ns);
-
-            // Set blocks to zero, except fx, fxx, fxp (computed via the objective function next)
-            fr.fill(0.0);
-            fs.fill(0.0);
-            fxr.fill(0.0);
-            fxs.fill(0.0);
-            frx.fill(0.0);
-            frr.fill(0.0);
-            frs.fill(0.0);
-            fsx.fill(0.0);
-            fsr.fill(0.0);
-            fss.fill(0.0);
-            frp.fill(0.0);
-            fsp.fill(0.0);
 
             // Use the objective function to compute f, fx, fxx, fxp
             ObjectiveResultRef fres(res.f, fx, fxx, fxp, res.diagfxx, res.fxx4basicvars, res.succeeded);
 
-            problem.f(fres, x, p, opts);
+            fres.setZero();
+
+            problemptr->f(fres, x, p, ObjectiveOptions{opts.eval, detail::basicVariablesInX(opts.ibasicvars, nx, jbf)});
         };
 
         // Create the non-linear equality constraint for the master optimization problem
-        mproblem.h = [&](ConstraintResultRef res, VectorView xrs, VectorView p, ConstraintOptions opts)
+        mproblem.h = [this](ConstraintResultRef res, VectorView xrs, VectorView p, ConstraintOptions opts)
         {
             // Views to sub-vectors in xrs = (x, r, s)
             const auto x = xrs.head(nx);
-            const auto r = xrs.segment(nx, nr);
             const auto s = xrs.tail(ns);
 
             // Views to sub-vectors in h = (he, hg)
             auto he = res.val.topRows(dims.he);
             auto hg = res.val.bottomRows(dims.hg);
 
-            // Views to sub-matrices in dh/d(xrs) = [ [he_x he_r he_s], [hg_x hg_r hg_s] ]
+            // Views to sub-matrices in dh/d(xrs) = [ [he_x 0 0], [hg_x 0 I] ]
             auto he_x = res.ddx.topRows(dims.he).leftCols(nx);
-            auto he_r = res.ddx.topRows(dims.he).middleCols(nx, nr);
-            auto he_s = res.ddx.topRows(dims.he).rightCols(ns);
-
             auto hg_x = res.ddx.bottomRows(dims.hg).leftCols(nx);
-            auto hg_r = res.ddx.bottomRows(dims.hg).middleCols(nx, nr);
             auto hg_s = res.ddx.bottomRows(dims.hg).rightCols(ns);
 
             // Views to sub-matrices in dh/dp = [he_p; hg_p]
             auto he_p = res.ddp.topRows(dims.he);
             auto hg_p = res.ddp.bottomRows(dims.hg);
 
-            // Set all blocks to zero, except hg_s which is I and he_x and hg_x computed next via he and hg functions
-            he_r.fill(0.0);
-            he_s.fill(0.0);
-            hg_r.fill(0.0);
-            hg_s.fill(0.0);
+            // Set the diagonal of hg_s = I (its off-diagonal entries are zero)
             hg_s.diagonal().fill(1.0);
 
-            ConstraintResultRef re(he, he_x, he_p, res.ddx4basicvars, res.succeeded);
+            const ConstraintOptions xopts{opts.eval, detail::basicVariablesInX(opts.ibasicvars, nx, jbh)};
 
-            problem.he(re, x, p, opts);
+            // The flags of he and hg are combined below, since each function resets them
+            auto he4basicvars = false, hesucceeded = true;
+            auto hg4basicvars = false, hgsucceeded = true;
 
-            ConstraintResultRef rg(hg, hg_x, hg_p, res.ddx4basicvars, res.succeeded);
+            ConstraintResultRef re(he, he_x, he_p, he4basicvars, hesucceeded);
 
-            problem.hg(rg, x, p, opts);
+            re.setZero();
+
+            problemptr->he(re, x, p, xopts);
+
+            ConstraintResultRef rg(hg, hg_x, hg_p, hg4basicvars, hgsucceeded);
+
+            rg.setZero();
+
+            problemptr->hg(rg, x, p, xopts);
 
             hg.noalias() += s;
+
+            res.ddx4basicvars = he4basicvars || hg4basicvars;
+            res.succeeded = hesucceeded && hgsucceeded;
         };
 
         // Create the external non-linear constraint for the master optimization problem
-        mproblem.v = [&](ConstraintResultRef res, VectorView xrs, VectorView p, ConstraintOptions opts)
+        mproblem.v = [this](ConstraintResultRef res, VectorView xrs, VectorView p, ConstraintOptions opts)
         {
             // Views to sub-vectors in xrs = (x, r, s)
             const auto x = xrs.head(nx);
-            const auto r = xrs.segment(nx, nr);
-            const auto s = xrs.tail(ns);
 
-            // Views to sub-matrices in dv/d(xrs) = [ vx vr vs ]
+            // Views to sub-matrices in dv/d(xrs) = [ vx 0 0 ]
             auto vx = res.ddx.leftCols(nx);
-            auto vr = res.ddx.middleCols(nx, nr);
-            auto vs = res.ddx.rightCols(ns);
 
             // Auxiliary references to v and vp = dv/dp
             auto v  = res.val;
             auto vp = res.ddp;
 
-            // Set vr = dv/dr = 0 and vs = dv/ds = 0
-            vr.fill(0.0);
-            vs.fill(0.0);
-
             // Compute v, vx, vp using the given external constraint function v(x, p)
-            ConstraintResult vres(v, vx, vp, res.ddx4basicvars, res.succeeded);
+            ConstraintResultRef vres(v, vx, vp, res.ddx4basicvars, res.succeeded);
+
+            vres.setZero();
 
-            problem.v(vres, x, p, opts);
+            problemptr->v(vres, x, p, ConstraintOptions{opts.eval, detail::basicVariablesInX(opts.ibasicvars, nx, jbv)});
         };
+    }
 
-        // Initialize vector with lower bounds for bar(x) = (x, xbg, xhg)
-        xrslower.head(nx) = problem.xlower;
-        xrslower.tail(nr + ns).fill(-infinity());
+    /// Check that the functions of the optimization problem are initialized.
+    auto checkProblem(const Problem& problem) -> void
+    {
+        error(!problem.f.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the objective function. "
+            "Ensure Problem::f is properly initialized.");
 
-        // Initialize vector with upper bounds for bar(x) = (x, xbg, xhg)
-        xrsupper.head(nx) = problem.xupper;
-        xrslower.tail(nr + ns).fill(0.0);
+        error(dims.he > 0 && !problem.he.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the constraint function he(x, p). "
+            "Ensure Problem::he is properly initialized.");
 
-        // Initialize vector b = (be, bg)
-        mproblem.b.resize(ny);
-        mproblem.b << problem.be, problem.bg;
+        error(dims.hg > 0 && !problem.hg.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the constraint function hg(x, p). "
+            "Ensure Problem::hg is properly initialized.");
 
-        mproblem.xlower = xrslower;
-        mproblem.xupper = xrsupper;
-        mproblem.plower = problem.plower;
-        mproblem.pupper = problem.pupper;
+        error(dims.p > 0 && !problem.v.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the complementary constraint function v(x, p). "
+            "Ensure Problem::v is properly initialized.");
+    }
 
-        // Create matrix Ax = [ [Aex, 0, 0], [Agx, I, 0] ]
-        mproblem.Ax = zeros(ny, nxrs);
-        mproblem.Ax.leftCols(nx) << problem.Aex, problem.Agx;
-        mproblem.Ax.middleCols(nx, nr).bottomRows(nr).diagonal().fill(1.0);
+    /// Solve the optimization problem.
+    auto solve(const Problem& problem, State& state) -> Result
+    {
+        checkProblem(problem);
 
-        // Create matrix Ap = [ [Aep], [Agp] ]
-        mproblem.Ap = zeros(ny, np);
-        if(np > 0) mproblem.Ap << problem.Aep, problem.Agp;
+        // Solve instead the reduced problem if the presolve stage reduces it
+        if(presolver.reduce(problem))
+            return presolver.solve(problem, state);
+
+        // Solve instead the independent subproblems if the problem can be decomposed
+        if(decomposer.decompose(problem, state))
+            return solveDecomposed(problem, state);
+
+        return solveMaster(problem, state);
+    }
+
+    /// Solve the optimization problem asynchronously (see Solver::solveAsync).
+    auto solveAsync(const Problem& problem, State& state) -> std::future<Result>
+    {
+        checkProblem(problem);
+
+        if(presolver.reduce(problem))
+            return std::async(std::launch::async, [this, &problem, &state] { return presolver.solve(problem, state); });
+
+        if(decomposer.decompose(problem, state))
+            return std::async(std::launch::async, [this, &problem, &state] { return solveDecomposed(problem, state); });
+
+        updateMasterProblem(problem);
+
+        return msolver.solveAsync(mproblem, { state.xbar, state.p, state.w });
+    }
+
+    /// Solve the independent subproblems of the decomposed optimization problem.
+    auto solveDecomposed(const Problem& problem, State& state) -> Result
+    {
+        auto result = decomposer.solve(problem, state);
+
+        if(!decomposer.detected())
+            return result;
+
+        // Check the stitched solution against the original problem, since the
+        // detected structure may miss couplings. The calculation below stops at
+        // once if the residual at the stitched solution is small enough.
+        const auto checked = solveMaster(problem, state);
+
+        result += checked;
+        result.succeeded = checked.succeeded;
+        result.failure_reason = checked.failure_reason;
+        result.error = checked.error;
+        result.error_optimality = checked.error_optimality;
+        result.error_feasibility = checked.error_feasibility;
+
+        return result;
+    }
+
+    /// Solve the optimization problem using the master optimization solver.
+    auto solveMaster(const Problem& problem, State& state) -> Result
+    {
+        updateMasterProblem(problem);
 
         // Create references to state members
         auto xbar       = state.xbar;
@@ -271,6 +349,40 @@ struct Solver::Impl
 
         return result;
     }
+
+    /// Update the master optimization problem with the given optimization problem.
+    auto updateMasterProblem(const Problem& problem) -> void
+    {
+        // Set the problem used in the functions f, h, v of the master problem
+        problemptr = &problem;
+
+        // Refresh in place the non-constant parts of the master problem,
+        // copying only the blocks that have changed since the last solve
+        // call (no reallocation and no re-assembly of its constant blocks).
+        // If Ax and Ap are unchanged, their echelon form computed in a
+        // previous solve call is also reused (see EchelonizerW::initialize
+        // and Result::num_echelonizations).
+
+        // Update the bounds of x in xrs = (x, xbg, xhg)
+        detail::refresh(mproblem.xlower.head(nx), problem.xlower);
+        detail::refresh(mproblem.xupper.head(nx), problem.xupper);
+
+        // Update the bounds of p
+        detail::refresh(mproblem.plower, problem.plower);
+        detail::refresh(mproblem.pupper, problem.pupper);
+
+        // Update vector b = (be, bg)
+        detail::refresh(mproblem.b.head(dims.be), problem.be);
+        detail::refresh(mproblem.b.tail(dims.bg), problem.bg);
+
+        // Update blocks Aex and Agx in Ax = [ [Aex, 0, 0], [Agx, I, 0] ]
+        detail::refresh(mproblem.Ax.topLeftCorner(dims.be, nx), problem.Aex);
+        detail::refresh(mproblem.Ax.bottomLeftCorner(dims.bg, nx), problem.Agx);
+
+        // Update matrix Ap = [ [Aep], [Agp] ]
+        detail::refresh(mproblem.Ap.topRows(dims.be), problem.Aep);
+        detail::refresh(mproblem.Ap.bottomRows(dims.bg), problem.Agp);
+    }
 };
 
 Solver::Solver(const Problem& problem)
@@ -300,4 +412,9 @@ auto Solver::solve(const Problem& problem, State& state) -> Result
     return pimpl->solve(problem, state);
 }
 
+auto Solver::solveAsync(const Problem& problem, State& state) -> std::future<Result>
+{
+    return pimpl->solveAsync(problem, state);
+}
+
 } // namespace Optima
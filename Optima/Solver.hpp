@@ -18,6 +18,7 @@
 #pragma once
 
 // C++ includes
+#include <future>
 #include <memory>
 
 // Optima includes
@@ -53,6 +54,16 @@ public:
     /// Solve the optimization problem.
     auto solve(const Problem& problem, State& state) -> Result;
 
+    /// Solve the optimization problem asynchronously in a new thread.
+    /// The problem is checked and prepared in the calling thread, and then
+    /// solved with MasterSolver::solveAsync (or, if it is reduced by the
+    /// presolve stage or decomposed, with these in the new thread). The
+    /// returned future captures this solver, *problem* and *state* by
+    /// reference, so that these must not be used nor destroyed until it is
+    /// ready. The calculation can be interrupted with Options::cancellation or
+    /// Options::timelimit, in which case the result is flagged with Result::interrupted.
+    auto solveAsync(const Problem& problem, State& state) -> std::future<Result>;
+
 private:
     struct Impl;
 
@@ -0,0 +1,177 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "TaskPool.hpp"
+
+// C++ includes
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+
+namespace Optima {
+
+struct TaskPool::Impl
+{
+    /// The number of worker threads in the task pool.
+    const Index nthreads;
+
+    /// The worker threads executing the submitted tasks (started with the first submitted task).
+    std::vector<std::thread> workers;
+
+    /// The submitted tasks not yet picked by a worker thread.
+    std::deque<std::function<void()>> tasks;
+
+    /// The number of submitted tasks not yet finished.
+    Index unfinished = 0;
+
+    /// The first exception thrown by a task since the last call to wait.
+    std::exception_ptr exception;
+
+    /// True if the worker threads should stop once there are no more tasks.
+    bool stopping = false;
+
+    /// The mutex protecting the state shared with the worker threads.
+    std::mutex mutex;
+
+    /// The condition signaled when a task is submitted or the pool is stopping.
+    std::condition_variable submitted;
+
+    /// The condition signaled when all submitted tasks have finished.
+    std::condition_variable finished;
+
+    Impl(Index nthreads)
+    : nthreads(nthreads)
+    {
+        error(nthreads < 0, "Cannot create a TaskPool object with a negative number of threads.");
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        submitted.notify_all();
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    auto work() -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            submitted.wait(lock, [&] { return stopping || !tasks.empty(); });
+            if(tasks.empty())
+                return;
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            lock.unlock();
+            std::exception_ptr thrown;
+            try { task(); }
+            catch(...) { thrown = std::current_exception(); }
+            lock.lock();
+            if(thrown && !exception)
+                exception = thrown;
+            if(--unfinished == 0)
+                finished.notify_all();
+        }
+    }
+
+    auto enqueue(std::function<void()> task) -> void
+    {
+        // The permission for heap allocations by Eigen checked in builds with
+        // EIGEN_RUNTIME_NO_MALLOC is shared by all threads in the process.
+        // Thus, the tasks are executed in the calling thread in these builds.
+        #ifdef EIGEN_RUNTIME_NO_MALLOC
+        const auto inlined = true;
+        #else
+        const auto inlined = nthreads == 0;
+        #endif
+
+        if(inlined)
+        {
+            task();
+            return;
+        }
+        if(workers.empty())
+        {
+            workers.reserve(nthreads);
+            for(Index i = 0; i < nthreads; ++i)
+                workers.emplace_back([this] { work(); });
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+            ++unfinished;
+        }
+        submitted.notify_one();
+    }
+
+    auto wait() -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return unfinished == 0; });
+        if(exception)
+            std::rethrow_exception(std::exchange(exception, nullptr));
+    }
+};
+
+TaskPool::TaskPool()
+: TaskPool(0)
+{}
+
+TaskPool::TaskPool(Index nthreads)
+: pimpl(new Impl(nthreads))
+{}
+
+TaskPool::TaskPool(const TaskPool& other)
+: pimpl(new Impl(other.size()))
+{}
+
+TaskPool::~TaskPool()
+{}
+
+auto TaskPool::operator=(TaskPool other) -> TaskPool&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto TaskPool::size() const -> Index
+{
+    return pimpl->nthreads;
+}
+
+auto TaskPool::enqueue(std::function<void()> task) -> void
+{
+    pimpl->enqueue(std::move(task));
+}
+
+auto TaskPool::wait() -> void
+{
+    pimpl->wait();
+}
+
+} // namespace Optima
@@ -0,0 +1,70 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <functional>
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+
+namespace Optima {
+
+/// Used to execute tasks concurrently on a small set of worker threads.
+/// Tasks are submitted with @ref enqueue and joined with @ref wait. A task
+/// pool without worker threads executes each task immediately in @ref enqueue.
+/// The worker threads are started only when the first task is submitted, and
+/// a copy of a task pool has its own worker threads (none are shared).
+/// In builds with `EIGEN_RUNTIME_NO_MALLOC`, all tasks are executed
+/// immediately in @ref enqueue (see @ref EigenMallocScope).
+class TaskPool
+{
+public:
+    /// Construct a TaskPool object without worker threads.
+    TaskPool();
+
+    /// Construct a TaskPool object with given number of worker threads.
+    explicit TaskPool(Index nthreads);
+
+    /// Construct a copy of a TaskPool object.
+    TaskPool(const TaskPool& other);
+
+    /// Destroy this TaskPool object after all its pending tasks are executed.
+    virtual ~TaskPool();
+
+    /// Assign a TaskPool object to this.
+    auto operator=(TaskPool other) -> TaskPool&;
+
+    /// Return the number of worker threads in this task pool.
+    auto size() const -> Index;
+
+    /// Submit a task for execution in one of the worker threads.
+    auto enqueue(std::function<void()> task) -> void;
+
+    /// Wait until all submitted tasks have been executed.
+    /// If a task has thrown an exception, the first one is rethrown here.
+    auto wait() -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -0,0 +1,264 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <cmath>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/ObjectiveFunction.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+/// The options for TinySolver.
+struct TinySolverOptions
+{
+    /// The tolerance for the residual error of the optimality and feasibility conditions.
+    double tolerance = 1.0e-8;
+
+    /// The maximum number of iterations.
+    Index maxiterations = 100;
+};
+
+/// Used for solving tiny optimization problems whose dimensions have compile-time maximum values.
+/// The problem is to minimize *f(x)* subject to *Ax x = b* and *xlower <= x <= xupper*.
+/// This uses the Newton method of MasterSolver on the optimality conditions,
+/// with the variables partitioned into stable ones and unstable ones (those at
+/// their bounds that would move past them), but without its indirections: all
+/// vectors and matrices have fixed capacity (no heap allocation), the objective
+/// function is a functor whose calls can be inlined, and there is no pimpl. The
+/// fixed costs of these dominate the solution of tiny problems (e.g., with
+/// *nx <= 16* and *ny <= 6*), for which this is an order of magnitude faster
+/// (see bench/BenchTinySolver.cpp). Unlike MasterSolver, this has the following limits:
+/// - *Ax* is not echelonized, and so its rows must be linearly independent;
+/// - there is no line search, and the error control only halves the steps that do not decrease the error;
+/// - there are no parameters *p*, no nonlinear constraints and no external constraints.
+/// @tparam MaxNx The maximum number of variables in *x*.
+/// @tparam MaxNy The maximum number of linear equality constraints.
+template<int MaxNx, int MaxNy>
+class TinySolver
+{
+public:
+    static_assert(MaxNx > 0 && MaxNy > 0, "The maximum dimensions of TinySolver must be positive.");
+
+    /// The type of the vectors with dimension up to *MaxNx*.
+    using VectorX = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, MaxNx, 1>;
+
+    /// The type of the vectors with dimension up to *MaxNy*.
+    using VectorY = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, MaxNy, 1>;
+
+    /// The type of the matrices with dimensions up to *MaxNx* by *MaxNx*.
+    using MatrixXX = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, MaxNx, MaxNx>;
+
+    /// The type of the matrices with dimensions up to *MaxNy* by *MaxNx*.
+    using MatrixYX = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, MaxNy, MaxNx>;
+
+    /// The type of the result of the objective function evaluation (only `f`, `fx`, `fxx` and `succeeded` are used).
+    using ObjectiveResult = ObjectiveResultBase<double, bool, VectorX, MatrixXX>;
+
+    /// The tiny optimization problem.
+    struct Problem
+    {
+        MatrixYX Ax;    ///< The coefficient matrix of the linear equality constraints.
+        VectorY b;      ///< The right-hand side vector of the linear equality constraints.
+        VectorX xlower; ///< The lower bounds of the variables *x*.
+        VectorX xupper; ///< The upper bounds of the variables *x*.
+    };
+
+    /// Set the options of the calculation.
+    auto setOptions(const TinySolverOptions& opts) -> void
+    {
+        options = opts;
+    }
+
+    /// Solve a tiny optimization problem.
+    /// @param problem The tiny optimization problem.
+    /// @param f The objective function, called as `f(res, x)` with `res` of type ObjectiveResult.
+    /// @param[in,out] x The initial guess and the solution for *x*.
+    /// @param[in,out] y The initial guess and the solution for the Lagrange multipliers *y* (set to zero if empty).
+    template<typename Objective>
+    auto solve(const Problem& problem, const Objective& f, VectorX& x, VectorY& y) -> Result
+    {
+        const auto nx = problem.xlower.size();
+        const auto ny = problem.b.size();
+        const auto& Ax = problem.Ax;
+        const auto& xlower = problem.xlower;
+        const auto& xupper = problem.xupper;
+
+        error(problem.xupper.size() != nx, "Expecting xlower and xupper with the same dimension.");
+        error(Ax.rows() != ny || Ax.cols() != nx, "Expecting Ax with dimensions ", ny, " by ", nx, ".");
+        error(x.size() != nx, "Expecting x with dimension ", nx, ".");
+        error(y.size() != ny && y.size() != 0, "Expecting y with dimension ", ny, ".");
+
+        if(y.size() == 0)
+            y.setZero(ny);
+
+        x = x.cwiseMax(xlower).cwiseMin(xupper);
+
+        Result result;
+        ObjectiveResult res(nx, 0);
+
+        // The stable variables, the stability of the variables and the residual of Ax*x = b
+        Eigen::Matrix<Index, Eigen::Dynamic, 1, 0, MaxNx, 1> js(nx);
+        Index ns = 0;
+        VectorX s(nx);
+        VectorY ew(ny);
+
+        // Evaluate f(x) and the residual errors at (x, y), returning infinity if f(x) could not be evaluated
+        const auto evaluate = [&]() -> double
+        {
+            res.fx.setZero();
+            res.fxx.setZero();
+            res.succeeded = true;
+            f(res, x);
+            result.num_objective_evals += 1;
+
+            if(!res.succeeded || !std::isfinite(res.f) || !res.fx.allFinite())
+                return infinity();
+
+            s.noalias() = res.fx + Ax.transpose()*y;
+            ew.noalias() = Ax*x - problem.b;
+
+            ns = 0;
+            for(Index i = 0; i < nx; ++i)
+            {
+                const auto lowerunstable = x[i] == xlower[i] && s[i] > 0.0;
+                const auto upperunstable = x[i] == xupper[i] && s[i] < 0.0;
+                if(!lowerunstable && !upperunstable)
+                    js[ns++] = i;
+            }
+
+            result.error_optimality = 0.0;
+            for(Index k = 0; k < ns; ++k)
+                result.error_optimality = std::max(result.error_optimality, std::abs(s[js[k]]));
+            result.error_feasibility = ny ? ew.cwiseAbs().maxCoeff() : 0.0;
+            result.error = std::max(result.error_optimality, result.error_feasibility);
+            return result.error;
+        };
+
+        // The last iterate (xo, yo) and the Newton step from it
+        VectorX xo(nx), dx(nx);
+        VectorY yo(ny), dy(ny);
+
+        auto error = evaluate();
+
+        while(true)
+        {
+            if(!std::isfinite(error))
+            {
+                result.failure_reason = "The objective function could not be evaluated.";
+                break;
+            }
+
+            if(error < options.tolerance)
+            {
+                result.succeeded = true;
+                break;
+            }
+
+            if(result.iterations == options.maxiterations)
+            {
+                result.failure_reason = "The maximum number of iterations has been reached.";
+                break;
+            }
+
+            // The Newton step for the stable variables and y, with the unstable variables kept at their bounds
+            const auto nt = ns + ny;
+            K.setZero(nt, nt);
+            r.resize(nt);
+            for(Index a = 0; a < ns; ++a)
+            {
+                for(Index c = 0; c < ns; ++c)
+                    K(a, c) = res.fxx(js[a], js[c]);
+                for(Index k = 0; k < ny; ++k)
+                {
+                    K(a, ns + k) = Ax(k, js[a]);
+                    K(ns + k, a) = Ax(k, js[a]);
+                }
+                r[a] = -s[js[a]];
+            }
+            r.tail(ny) = -ew;
+
+            lu.compute(K);
+            d.noalias() = lu.solve(r);
+
+            dx.setZero();
+            for(Index a = 0; a < ns; ++a)
+                dx[js[a]] = d[a];
+            dy = d.tail(ny);
+
+            xo = x;
+            yo = y;
+
+            // Halve the step while the error does not decrease (a simpler
+            // version of the error control of MasterSolver), and take the
+            // Newton step as is if this fails to decrease the error.
+            const auto erroro = error;
+            auto alpha = 1.0;
+            while(true)
+            {
+                x = (xo + alpha*dx).cwiseMax(xlower).cwiseMin(xupper);
+                y = yo + alpha*dy;
+                error = evaluate();
+                if(error < erroro || alpha < 1e-3)
+                    break;
+                alpha *= 0.5;
+            }
+
+            if(!(error < erroro) && alpha != 1.0)
+            {
+                x = (xo + dx).cwiseMax(xlower).cwiseMin(xupper);
+                y = yo + dy;
+                error = evaluate();
+            }
+
+            result.iterations += 1;
+        }
+
+        return result;
+    }
+
+private:
+    /// The type of the matrices with dimensions up to *(MaxNx + MaxNy)* by *(MaxNx + MaxNy)*.
+    using MatrixK = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, MaxNx + MaxNy, MaxNx + MaxNy>;
+
+    /// The type of the vectors with dimension up to *(MaxNx + MaxNy)*.
+    using VectorK = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, MaxNx + MaxNy, 1>;
+
+    /// The options of the calculation.
+    TinySolverOptions options;
+
+    /// The Jacobian matrix of the Newton step.
+    MatrixK K;
+
+    /// The right-hand side vector of the Newton step.
+    VectorK r;
+
+    /// The solution of the Newton step.
+    VectorK d;
+
+    /// The LU decomposition of the Jacobian matrix of the Newton step.
+    Eigen::PartialPivLU<MatrixK> lu;
+};
+
+} // namespace Optima
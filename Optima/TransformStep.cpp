@@ -19,6 +19,7 @@
 
 // Optima includes
 #include <Optima/Constants.hpp>
+#include <Optima/Memory.hpp>
 
 namespace Optima {
 
@@ -49,12 +50,14 @@ struct TransformStep::Impl
 
         ubkp = u;
 
-        const auto outcome = phi(uo.x, u.x);
+        const auto outcome = [&] {
+            EigenMallocScope malloc(true); // the user function is allowed to allocate memory
+            return phi(uo.x, u.x);
+        }();
 
+        // Note: F and E have not been updated yet, so only u needs to be restored.
         if(outcome == FAILED) {
             u = ubkp;
-            F.update(u);
-            E.update(u, F);
             return FAILED;
         }
 
@@ -62,6 +65,11 @@ struct TransformStep::Impl
 
         const auto errorcurr = E.error;
 
+        // Save the evaluated state of F and E so that a rejected step does
+        // not require their re-evaluation.
+        F.checkpoint();
+        E.checkpoint();
+
         F.update(u);
         E.update(u, F);
 
@@ -69,8 +77,8 @@ struct TransformStep::Impl
 
         if(errornext > errorcurr) {
             u = ubkp;
-            F.update(u);
-            E.update(u, F);
+            F.restore();
+            E.restore();
             return FAILED;
         }
 
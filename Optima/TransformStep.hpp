@@ -53,6 +53,8 @@ public:
     auto initialize(const MasterProblem& problem) -> void;
 
     /// Execute the custom transformation on the just computed state of master variables.
+    /// If the transformation fails or increases the error, *u* is restored and
+    /// *F* and *E* are rolled back to their state at entry, without re-evaluation.
     auto execute(MasterVectorView uo, MasterVectorRef u, ResidualFunction& F, ResidualErrors& E) -> bool;
 };
 
@@ -257,218 +257,6 @@ auto greaterThan(double lhs, double rhs, double baseval) -> bool
     return lhs > rhs - 10.0 * epsilon * std::abs(baseval);
 }
 
-auto bfgs() -> std::function<Matrix(const Vector&, const Vector&)>
-{
-    Vector x0;
-    Vector g0;
-    Vector dx;
-    Vector dg;
-    Matrix H;
-
-    std::function<Matrix(const Vector&, const Vector&)> f = [=](const Vector& x, const Vector& g) mutable
-    {
-        if(x0.size() == 0)
-        {
-            x0.noalias() = x;
-            g0.noalias() = g;
-            H = diag(x);
-            return H;
-        }
-
-        dx.noalias() = x - x0;
-        dg.noalias() = g - g0;
-        x0.noalias() = x;
-        g0.noalias() = g;
-
-        const unsigned n = x.size();
-        const double a = dx.dot(dg);
-        const auto I = Eigen::identity(n, n);
-
-        H = (I - dx*tr(dg)/a)*H*(I - dg*tr(dx)/a) + dx*tr(dx)/a;
-
-        return H;
-    };
-
-    return f;
-}
-
-auto minimizeGoldenSectionSearch(const std::function<double(double)>& f, double tol) -> double
-{
-    //---------------------------------------------------------------
-    // Reference: http://en.wikipedia.org/wiki/Golden_section_search
-    //---------------------------------------------------------------
-
-    // The golden ratio
-    const double phi = 0.61803398875;
-
-    double a = 0.0;
-    double b = 1.0;
-
-    double c = 1 - phi;
-    double d = phi;
-
-    if(std::abs(c - d) < tol)
-        return (b + a)/2.0;
-
-    double fc = f(c);
-    double fd = f(d);
-
-    while(std::abs(c - d) > tol)
-    {
-        if(fc < fd)
-        {
-            b = d;
-            d = c;
-            c = b - phi*(b - a);
-            fd = fc;
-            fc = f(c);
-        }
-        else
-        {
-            a = c;
-            c = d;
-            d = a + phi*(b - a);
-            fc = fd;
-            fd = f(d);
-        }
-    }
-
-    return (b + a)/2.0;
-}
-
-
-auto minimizeGoldenSectionSearch(const std::function<double(double)>& f, double a, double b, double tol) -> double
-{
-    auto g = [=](double x)
-    {
-        return f(a + x*(b - a));
-    };
-
-    const double xmin = minimizeGoldenSectionSearch(g, tol);
-    return a + xmin*(b - a);
-}
-
-auto minimizeBrent(const std::function<double(double)>& f, double min, double max, double tolerance, unsigned maxiters) -> double
-{
-    //-------------------------------------------------------------------
-    // The code below was adapted from boost library, found at header
-    // boost/math/tools/minima.hpp under the name brent_find_minima.
-    //-------------------------------------------------------------------
-    double x; // minima so far
-    double w; // second best point
-    double v; // previous value of w
-    double u; // most recent evaluation point
-    double delta; // The distance moved in the last step
-    double delta2; // The distance moved in the step before last
-    double fu, fv, fw, fx; // function evaluations at u, v, w, x
-    double mid; // midpoint of min and max
-    double fract1, fract2; // minimal relative movement in x
-
-    const double golden = 0.3819660;// golden ratio, don't need too much precision here!
-
-    x = w = v = max;
-    fw = fv = fx = f(x);
-    delta2 = delta = 0;
-
-    unsigned count = maxiters;
-
-    do
-    {
-        // get midpoint
-        mid = (min + max)/2;
-
-        // work out if we're done already:
-        fract1 = tolerance * fabs(x) + tolerance/4;
-        fract2 = 2 * fract1;
-
-        if(fabs(x - mid) <= (fract2 - (max - min)/2))
-            break;
-
-        if(fabs(delta2) > fract1)
-        {
-            // try and construct a parabolic fit:
-            double r = (x - w) * (fx - fv);
-            double q = (x - v) * (fx - fw);
-            double p = (x - v) * q - (x - w) * r;
-            q = 2 * (q - r);
-            if(q > 0)
-            p = -p;
-            q = fabs(q);
-            double td = delta2;
-            delta2 = delta;
-
-            // determine whether a parabolic step is acceptible or not:
-            if((fabs(p) >= fabs(q * td / 2)) || (p <= q * (min - x)) || (p >= q * (max - x)))
-            {
-                // nope, try golden section instead
-                delta2 = (x >= mid) ? min - x : max - x;
-                delta = golden * delta2;
-            }
-            else
-            {
-                // when, parabolic fit:
-                delta = p / q;
-                u = x + delta;
-                if(((u - min) < fract2) || ((max- u) < fract2))
-                delta = (mid - x) < 0 ? -fabs(fract1) : fabs(fract1);
-            }
-        }
-        else
-        {
-            // golden section:
-            delta2 = (x >= mid) ? min - x : max - x;
-            delta = golden * delta2;
-        }
-        // update current position:
-        u = (fabs(delta) >= fract1) ? x + delta : (delta > 0 ? x + fabs(fract1) : x - fabs(fract1));
-        fu = f(u);
-        if(fu <= fx)
-        {
-            // good new point is an improvement!
-            // update brackets:
-            if(u >= x)
-            min = x;
-            else
-            max = x;
-            // update control points:
-            v = w;
-            w = x;
-            x = u;
-            fv = fw;
-            fw = fx;
-            fx = fu;
-        }
-        else
-        {
-            // Oh dear, point u is worse than what we have already,
-            // even so it *must* be better than one of our endpoints:
-            if(u < x)
-            min = u;
-            else
-            max = u;
-            if((fu <= fw) || (w == x))
-            {
-                // however it is at least second best:
-                v = w;
-                w = u;
-                fv = fw;
-                fw = fu;
-            }
-            else if((fu <= fv) || (v == x) || (v == w))
-            {
-                // third best:
-                v = u;
-                fv = fu;
-            }
-        }
-
-    } while(--count);
-
-    maxiters -= count;
-
-    return x;
-}
-
 auto inverseShermanMorrison(const Matrix& invA, const Vector& D) -> Matrix
 {
     Matrix invM = invA;
@@ -558,6 +346,13 @@ auto cleanResidualRoundoffErrors(MatrixRef mat) -> void
 }
 
 auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x) -> Vector
+{
+    Vector b(A.rows());
+    multiplyMatrixVectorWithoutResidualRoundOffError(A, x, b);
+    return b;
+}
+
+auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x, VectorRef b) -> void
 {
     // In this method, we use b' = |A|*|x| as a reference to determine which
     // small entries in b should be regarded as residual round-off error. The
@@ -565,16 +360,16 @@ auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x
     // errors, then b'[i] should also be small.
 
     assert(A.cols() == x.rows());
+    assert(A.rows() == b.rows());
 
-    Vector b = A * x;
+    b.noalias() = A * x;
     const auto eps = std::numeric_limits<double>::epsilon();
     for(auto i = 0; i < b.size(); ++i)
     {
-        const double ref = A.row(i).cwiseAbs() * x.cwiseAbs();
+        const double ref = A.row(i).cwiseAbs().dot(x.cwiseAbs().transpose());
         if(std::abs(b[i]) < ref * eps)
             b[i] = 0.0;
     }
-    return b;
 }
 
 auto matrixStructure(MatrixView mat) -> MatrixStructure
@@ -584,6 +379,19 @@ auto matrixStructure(MatrixView mat) -> MatrixStructure
     return MatrixStructure::Zero;
 }
 
+auto detectMatrixStructure(MatrixView mat) -> MatrixStructure
+{
+    if(mat.size() == 0) return MatrixStructure::Zero;
+    const auto m = mat.rows();
+    const auto n = mat.cols();
+    for(Index j = 0; j < n; ++j)
+        for(Index i = 0; i < m; ++i)
+            if(i != j && mat(i, j) != 0.0)
+                return MatrixStructure::Dense;
+    if((mat.diagonal().array() == 0.0).all()) return MatrixStructure::Zero;
+    return m == n ? MatrixStructure::Diagonal : MatrixStructure::Dense;
+}
+
 auto isZeroMatrix(MatrixView mat) -> bool
 {
     return mat.size() == 0;
@@ -616,4 +424,12 @@ auto ensureMinimumDimension(Matrix& mat, Index rows, Index cols) -> void
     mat.resize(m, n);
 }
 
+auto perturbed(VectorView x) -> Vector
+{
+    Vector xp(x.size());
+    for(auto j = 0; j < x.size(); ++j)
+        xp[j] = x[j] + 0.01 * (1.0 + 0.1 * (j % 10)) * std::max(1.0, std::abs(x[j]));
+    return xp;
+}
+
 } // namespace Optima
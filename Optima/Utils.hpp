@@ -18,6 +18,7 @@
 #pragma once
 
 // C++ includes
+#include <cmath>
 #include <functional>
 #include <tuple>
 
@@ -120,14 +121,189 @@ constexpr auto epsilon() -> double
     return std::numeric_limits<double>::epsilon();
 }
 
-/// Return an inverse Hessian function based on the BFGS Hessian approximation
-auto bfgs() -> std::function<Matrix(const Vector&, const Vector&)>;
+/// Calculate the minimum of a single variable function in the interval [0, 1] using the Golden Section Search algorithm.
+template<typename Function>
+auto minimizeGoldenSectionSearch(const Function& f, double tol) -> double
+{
+    //---------------------------------------------------------------
+    // Reference: http://en.wikipedia.org/wiki/Golden_section_search
+    //---------------------------------------------------------------
+
+    // The golden ratio
+    const double phi = 0.61803398875;
+
+    double a = 0.0;
+    double b = 1.0;
+
+    double c = 1 - phi;
+    double d = phi;
+
+    if(std::abs(c - d) < tol)
+        return (b + a)/2.0;
+
+    double fc = f(c);
+    double fd = f(d);
+
+    while(std::abs(c - d) > tol)
+    {
+        if(fc < fd)
+        {
+            b = d;
+            d = c;
+            c = b - phi*(b - a);
+            fd = fc;
+            fc = f(c);
+        }
+        else
+        {
+            a = c;
+            c = d;
+            d = a + phi*(b - a);
+            fc = fd;
+            fd = f(d);
+        }
+    }
+
+    return (b + a)/2.0;
+}
 
 /// Calculate the minimum of a single variable function using the Golden Section Search algorithm.
-auto minimizeGoldenSectionSearch(const std::function<double(double)>& f, double a, double b, double tol = 1e-5) -> double;
+/// The function is a template parameter so that calls to it can be inlined.
+template<typename Function>
+auto minimizeGoldenSectionSearch(const Function& f, double a, double b, double tol = 1e-5) -> double
+{
+    auto g = [&](double x)
+    {
+        return f(a + x*(b - a));
+    };
+
+    const double xmin = minimizeGoldenSectionSearch(g, tol);
+    return a + xmin*(b - a);
+}
 
 /// Calculate the minimum of a single variable function using the Brent algorithm.
-auto minimizeBrent(const std::function<double(double)>& f, double min, double max, double tolerance = 1e-5, unsigned maxiters = 100) -> double;
+/// The function is a template parameter so that calls to it can be inlined.
+template<typename Function>
+auto minimizeBrent(const Function& f, double min, double max, double tolerance = 1e-5, unsigned maxiters = 100) -> double
+{
+    //-------------------------------------------------------------------
+    // The code below was adapted from boost library, found at header
+    // boost/math/tools/minima.hpp under the name brent_find_minima.
+    //-------------------------------------------------------------------
+    double x; // minima so far
+    double w; // second best point
+    double v; // previous value of w
+    double u; // most recent evaluation point
+    double delta; // The distance moved in the last step
+    double delta2; // The distance moved in the step before last
+    double fu, fv, fw, fx; // function evaluations at u, v, w, x
+    double mid; // midpoint of min and max
+    double fract1, fract2; // minimal relative movement in x
+
+    const double golden = 0.3819660;// golden ratio, don't need too much precision here!
+
+    x = w = v = max;
+    fw = fv = fx = f(x);
+    delta2 = delta = 0;
+
+    unsigned count = maxiters;
+
+    do
+    {
+        // get midpoint
+        mid = (min + max)/2;
+
+        // work out if we're done already:
+        fract1 = tolerance * fabs(x) + tolerance/4;
+        fract2 = 2 * fract1;
+
+        if(fabs(x - mid) <= (fract2 - (max - min)/2))
+            break;
+
+        if(fabs(delta2) > fract1)
+        {
+            // try and construct a parabolic fit:
+            double r = (x - w) * (fx - fv);
+            double q = (x - v) * (fx - fw);
+            double p = (x - v) * q - (x - w) * r;
+            q = 2 * (q - r);
+            if(q > 0)
+            p = -p;
+            q = fabs(q);
+            double td = delta2;
+            delta2 = delta;
+
+            // determine whether a parabolic step is acceptible or not:
+            if((fabs(p) >= fabs(q * td / 2)) || (p <= q * (min - x)) || (p >= q * (max - x)))
+            {
+                // nope, try golden section instead
+                delta2 = (x >= mid) ? min - x : max - x;
+                delta = golden * delta2;
+            }
+            else
+            {
+                // when, parabolic fit:
+                delta = p / q;
+                u = x + delta;
+                if(((u - min) < fract2) || ((max- u) < fract2))
+                delta = (mid - x) < 0 ? -fabs(fract1) : fabs(fract1);
+            }
+        }
+        else
+        {
+            // golden section:
+            delta2 = (x >= mid) ? min - x : max - x;
+            delta = golden * delta2;
+        }
+        // update current position:
+        u = (fabs(delta) >= fract1) ? x + delta : (delta > 0 ? x + fabs(fract1) : x - fabs(fract1));
+        fu = f(u);
+        if(fu <= fx)
+        {
+            // good new point is an improvement!
+            // update brackets:
+            if(u >= x)
+            min = x;
+            else
+            max = x;
+            // update control points:
+            v = w;
+            w = x;
+            x = u;
+            fv = fw;
+            fw = fx;
+            fx = fu;
+        }
+        else
+        {
+            // Oh dear, point u is worse than what we have already,
+            // even so it *must* be better than one of our endpoints:
+            if(u < x)
+            min = u;
+            else
+            max = u;
+            if((fu <= fw) || (w == x))
+            {
+                // however it is at least second best:
+                v = w;
+                w = u;
+                fv = fw;
+                fw = fu;
+            }
+            else if((fu <= fv) || (v == x) || (v == w))
+            {
+                // third best:
+                v = u;
+                fv = fu;
+            }
+        }
+
+    } while(--count);
+
+    maxiters -= count;
+
+    return x;
+}
 
 /// Calculate the inverse of `A + D` where `inv(A)` is already known and `D` is a diagonal matrix.
 /// @param invA[in,out] The inverse of the matrix `A` and the final inverse of `A + D`
@@ -162,6 +338,9 @@ auto cleanResidualRoundoffErrors(MatrixRef mat) -> void;
 /// Multiply a matrix and a vector and clean residual round-off errors.
 auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x) -> Vector;
 
+/// Multiply a matrix and a vector and clean residual round-off errors, storing the result in `b` (without memory allocation).
+auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x, VectorRef b) -> void;
+
 /// Used to describe the structure of a matrix.
 enum class MatrixStructure
 {
@@ -173,6 +352,13 @@ enum class MatrixStructure
 /// Return the structure type of the given matrix.
 auto matrixStructure(MatrixView mat) -> MatrixStructure;
 
+/// Return the structure type of the given matrix by inspecting its entries.
+/// Differently from @ref matrixStructure, which relies on how the matrix is
+/// represented, this method returns MatrixStructure::Zero if the matrix is
+/// empty or has only zero entries, and MatrixStructure::Diagonal if the
+/// matrix is square with zero entries off its diagonal.
+auto detectMatrixStructure(MatrixView mat) -> MatrixStructure;
+
 /// Return `true` if given matrix is a zero matrix, represented by an empty matrix.
 auto isZeroMatrix(MatrixView mat) -> bool;
 
@@ -190,4 +376,9 @@ auto operator<<=(MatrixRef mat, MatrixView other) -> MatrixRef;
 /// then no resizing is performed.
 auto ensureMinimumDimension(Matrix& mat, Index rows, Index cols) -> void;
 
+/// Return the point near *x* at which a sparsity pattern is detected in addition to *x*.
+/// The perturbations differ among the variables, so that entries depending on
+/// differences or ratios of variables do not vanish at both points.
+auto perturbed(VectorView x) -> Vector;
+
 } // namespace Optima
@@ -0,0 +1,80 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+// Optima includes
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+const Index samples = 100000;
+
+/// Return the elapsed time since *begin* in nanoseconds.
+auto elapsed(std::chrono::steady_clock::time_point begin) -> double
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/// Return the time per call (in nanoseconds) of the given minimization of the functions f(x) = (x - c)² + exp(x)/100
+/// with *c* in [0.2, 0.8], as well as the sum of their minima (so that the calls are not optimized away).
+template<typename Minimize>
+auto measure(const Minimize& minimize, double& summin) -> double
+{
+    summin = 0.0;
+    const auto begin = std::chrono::steady_clock::now();
+    for(Index i = 0; i < samples; ++i)
+    {
+        const auto c = 0.2 + 0.6*i/samples;
+        summin += minimize(c);
+    }
+    return elapsed(begin)/samples;
+}
+
+int main()
+{
+    // The objective function as a lambda, whose calls can be inlined in the templated minimizers
+    const auto flambda = [](double c)
+    {
+        return [c](double x) { return (x - c)*(x - c) + std::exp(x)/100.0; };
+    };
+
+    // The same objective function behind a std::function, whose calls are indirect
+    const auto ffunction = [&](double c)
+    {
+        return std::function<double(double)>(flambda(c));
+    };
+
+    double sum1 = 0.0, sum2 = 0.0, sum3 = 0.0, sum4 = 0.0;
+
+    const auto brentlambda   = measure([&](double c) { return minimizeBrent(flambda(c), 0.0, 1.0); }, sum1);
+    const auto brentfunction = measure([&](double c) { return minimizeBrent(ffunction(c), 0.0, 1.0); }, sum2);
+    const auto goldenlambda   = measure([&](double c) { return minimizeGoldenSectionSearch(flambda(c), 0.0, 1.0); }, sum3);
+    const auto goldenfunction = measure([&](double c) { return minimizeGoldenSectionSearch(ffunction(c), 0.0, 1.0); }, sum4);
+
+    std::cout << "Minimization of f(x) = (x - c)^2 + exp(x)/100 in [0, 1] (" << samples << " samples of c)" << std::endl;
+    std::cout << "Brent (lambda):                 " << brentlambda << " ns per call" << std::endl;
+    std::cout << "Brent (std::function):          " << brentfunction << " ns per call" << std::endl;
+    std::cout << "Speedup: " << brentfunction/brentlambda << std::endl;
+    std::cout << "Golden section (lambda):        " << goldenlambda << " ns per call" << std::endl;
+    std::cout << "Golden section (std::function): " << goldenfunction << " ns per call" << std::endl;
+    std::cout << "Speedup: " << goldenfunction/goldenlambda << std::endl;
+    std::cout << "Max difference in the sums of the minima: " << std::max(std::abs(sum1 - sum2), std::abs(sum3 - sum4)) << std::endl;
+}
@@ -0,0 +1,140 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Optima includes
+#include <Optima/MasterSolver.hpp>
+#include <Optima/TinySolver.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+// The number of heap allocations in the program, counted to check that TinySolver does not allocate
+std::size_t allocations = 0;
+
+auto operator new(std::size_t size) -> void*
+{
+    ++allocations;
+    if(void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+auto operator delete(void* ptr) noexcept -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept -> void
+{
+    std::free(ptr);
+}
+
+const Index nx = 12;
+const Index ny = 4;
+const Index samples = 1000;
+
+using Tiny = TinySolver<16, 6>;
+
+/// Return the elapsed time since *begin* in microseconds.
+auto elapsed(std::chrono::steady_clock::time_point begin) -> double
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main()
+{
+    // The entropy minimization problem: min sum(x*(log(x) - 1 + c)) subject to Ax*x = b and x > 0
+    const Matrix Ax = Matrix::Random(ny, nx).array() + 1.0;
+    const Vector c = Vector::Random(nx);
+    const Vector xs = Vector::Random(nx).array() + 1.1;
+    const Vector b = Ax*xs;
+
+    // Solve the problem with MasterSolver
+    MasterProblem mproblem;
+    mproblem.f = [&](ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions /*opts*/)
+    {
+        res.f = (x.array() * (x.array().log() - 1.0 + c.array())).sum();
+        res.fx = x.array().log() + c.array();
+        res.fxx.diagonal() = 1.0/x.array();
+        res.diagfxx = true;
+    };
+    mproblem.Ax = Ax;
+    mproblem.Ap = zeros(ny, 0);
+    mproblem.b = b;
+    mproblem.xlower = constants(nx, 1e-40);
+    mproblem.xupper = constants(nx, infinity());
+    mproblem.plower = zeros(0);
+    mproblem.pupper = zeros(0);
+
+    const MasterDims dims(nx, 0, ny, 0);
+    MasterSolver msolver(dims);
+    MasterVector u(dims);
+    Result mresult;
+
+    auto begin = std::chrono::steady_clock::now();
+    for(Index i = 0; i < samples; ++i)
+    {
+        u.x.fill(1.0);
+        u.w.fill(0.0);
+        mresult = msolver.solve(mproblem, u);
+    }
+    const auto mtime = elapsed(begin)/samples;
+
+    // Solve the same problem with TinySolver
+    Tiny::Problem tproblem;
+    tproblem.Ax = Ax;
+    tproblem.b = b;
+    tproblem.xlower.setConstant(nx, 1e-40);
+    tproblem.xupper.setConstant(nx, infinity());
+
+    const Tiny::VectorX cx = c;
+    const auto f = [&](Tiny::ObjectiveResult& res, const Tiny::VectorX& x)
+    {
+        res.f = (x.array() * (x.array().log() - 1.0 + cx.array())).sum();
+        res.fx = x.array().log() + cx.array();
+        res.fxx.diagonal() = 1.0/x.array();
+    };
+
+    Tiny tsolver;
+    Tiny::VectorX x(nx);
+    Tiny::VectorY y(ny);
+    Result tresult;
+
+    const auto allocationsbefore = allocations;
+    begin = std::chrono::steady_clock::now();
+    for(Index i = 0; i < samples; ++i)
+    {
+        x.fill(1.0);
+        y.fill(0.0);
+        tresult = tsolver.solve(tproblem, f, x, y);
+    }
+    const auto ttime = elapsed(begin)/samples;
+    const auto tallocations = allocations - allocationsbefore;
+
+    std::cout << "Entropy minimization problem with nx = " << nx << " and ny = " << ny << std::endl;
+    std::cout << "MasterSolver: " << mtime << " us per solve (" << mresult.iterations << " iterations, succeeded: " << mresult.succeeded << ")" << std::endl;
+    std::cout << "TinySolver:   " << ttime << " us per solve (" << tresult.iterations << " iterations, succeeded: " << tresult.succeeded << ")" << std::endl;
+    std::cout << "Speedup: " << mtime/ttime << std::endl;
+    std::cout << "Heap allocations in TinySolver: " << tallocations << std::endl;
+    std::cout << "Max difference in x: " << (u.x - Vector(x)).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << "Max difference in y: " << (u.w - Vector(y)).cwiseAbs().maxCoeff() << std::endl;
+}
@@ -0,0 +1,150 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <algorithm>
+#include <string>
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/BatchSolver.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+using namespace Optima;
+
+namespace {
+
+/// Copy a stacked array (one row of given length per problem in the batch) into the columns of a matrix.
+/// Nothing is done if the array is None, so that the corresponding data in Problem is used.
+auto stackedInput(const py::object& obj, Index length, Index size, const char* name, Matrix& mat) -> void
+{
+    if(obj.is_none())
+        return;
+    auto arr = py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(obj);
+    error(!arr, "Expecting argument ", name, " in BatchSolver.solve to be a numeric array.");
+    error(arr.ndim() != 2 || arr.shape(0) != size || arr.shape(1) != length,
+        "Expecting argument ", name, " in BatchSolver.solve to have shape (", size, ", ", length, ").");
+    mat = Eigen::Map<const Matrix>(arr.data(), length, size); // a row-major (size, length) array is a column-major (length, size) matrix
+}
+
+/// Return the data of a preallocated stacked array in which the results of the problems in the batch are written.
+/// The array must be writeable, C-contiguous and of type T, so that the results are not written in a temporary copy.
+template<typename T>
+auto stackedOutput(const py::object& obj, std::initializer_list<Index> shape, const char* name) -> T*
+{
+    error(!py::isinstance<py::array_t<T>>(obj), "Expecting argument ", name, " in BatchSolver.solve "
+        "to be a NumPy array with dtype ", py::str(py::dtype::of<T>()).cast<std::string>(), ".");
+    auto arr = py::reinterpret_borrow<py::array_t<T>>(obj);
+    std::string expected;
+    for(auto n : shape)
+        expected += (expected.empty() ? "(" : ", ") + std::to_string(n);
+    expected += shape.size() == 1 ? ",)" : ")";
+    error(arr.ndim() != py::ssize_t(shape.size()) || !std::equal(shape.begin(), shape.end(), arr.shape()),
+        "Expecting argument ", name, " in BatchSolver.solve to have shape ", expected, ".");
+    error(!(arr.flags() & py::array::c_style), "Expecting argument ", name, " in BatchSolver.solve to be a C-contiguous array.");
+    error(!arr.writeable(), "Expecting argument ", name, " in BatchSolver.solve to be a writeable array.");
+    return arr.mutable_data();
+}
+
+} // namespace
+
+void exportBatchSolver(py::module& m)
+{
+    auto solve = [](BatchSolver& self, const Problem& problem, py::object x,
+        py::object be, py::object bg, py::object xlower, py::object xupper, py::object plower, py::object pupper,
+        py::object p, py::object w, py::object s, py::object iterations, py::object succeeded, py::object setup)
+    {
+        const auto& dims = problem.dims;
+        const auto nw = dims.be + dims.bg + dims.he + dims.hg;
+
+        error(!py::isinstance<py::array>(x) || py::reinterpret_borrow<py::array>(x).ndim() != 2,
+            "Expecting argument x in BatchSolver.solve to be a two-dimensional array with one row per problem.");
+
+        const auto size = Index(py::reinterpret_borrow<py::array>(x).shape(0));
+
+        BatchProblem batch;
+        stackedInput(be, dims.be, size, "be", batch.be);
+        stackedInput(bg, dims.bg, size, "bg", batch.bg);
+        stackedInput(xlower, dims.x, size, "xlower", batch.xlower);
+        stackedInput(xupper, dims.x, size, "xupper", batch.xupper);
+        stackedInput(plower, dims.p, size, "plower", batch.plower);
+        stackedInput(pupper, dims.p, size, "pupper", batch.pupper);
+
+        double* xdata = stackedOutput<double>(x, {size, dims.x}, "x");
+        double* pdata = p.is_none() ? nullptr : stackedOutput<double>(p, {size, dims.p}, "p");
+        double* wdata = w.is_none() ? nullptr : stackedOutput<double>(w, {size, nw}, "w");
+        double* sdata = s.is_none() ? nullptr : stackedOutput<double>(s, {size, dims.x}, "s");
+        Index* itdata = iterations.is_none() ? nullptr : stackedOutput<Index>(iterations, {size}, "iterations");
+        bool* sucdata = succeeded.is_none() ? nullptr : stackedOutput<bool>(succeeded, {size}, "succeeded");
+
+        // The Python set-up function is called with the GIL acquired by the worker thread
+        BatchSolver::Setup setupfn;
+        if(!setup.is_none())
+            setupfn = [&](Problem& worker_problem, Index i)
+            {
+                py::gil_scoped_acquire acquire;
+                setup(py::cast(&worker_problem, py::return_value_policy::reference), i);
+            };
+
+        // Python callbacks in the problem (e.g., Problem.f) acquire the GIL when called
+        py::gil_scoped_release release;
+
+        BatchState state(dims, size);
+
+        state.x = Eigen::Map<const Matrix>(xdata, dims.x, size);
+        if(pdata) state.p = Eigen::Map<const Matrix>(pdata, dims.p, size);
+        if(wdata) state.w = Eigen::Map<const Matrix>(wdata, nw, size);
+
+        const auto result = self.solve(problem, batch, setupfn, state);
+
+        Eigen::Map<Matrix>(xdata, dims.x, size) = state.x;
+        if(pdata) Eigen::Map<Matrix>(pdata, dims.p, size) = state.p;
+        if(wdata) Eigen::Map<Matrix>(wdata, nw, size) = state.w;
+        if(sdata) Eigen::Map<Matrix>(sdata, dims.x, size) = state.s;
+        if(itdata) Eigen::Map<Indices>(itdata, size) = state.iterations;
+        if(sucdata) for(Index i = 0; i < size; ++i) sucdata[i] = state.succeeded[i] != 0;
+
+        return result;
+    };
+
+    py::class_<BatchSolver>(m, "BatchSolver")
+        .def(py::init<const Problem&>())
+        .def("setOptions", &BatchSolver::setOptions)
+        .def("solve", solve,
+            py::arg("problem"),
+            py::arg("x"),
+            py::arg("be") = py::none(),
+            py::arg("bg") = py::none(),
+            py::arg("xlower") = py::none(),
+            py::arg("xupper") = py::none(),
+            py::arg("plower") = py::none(),
+            py::arg("pupper") = py::none(),
+            py::arg("p") = py::none(),
+            py::arg("w") = py::none(),
+            py::arg("s") = py::none(),
+            py::arg("iterations") = py::none(),
+            py::arg("succeeded") = py::none(),
+            py::arg("setup") = py::none())
+        ;
+}
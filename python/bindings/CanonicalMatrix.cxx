@@ -26,6 +26,16 @@ using namespace Optima;
 
 void exportCanonicalMatrix(py::module& m)
 {
+    py::class_<CanonicalStructure>(m, "CanonicalStructure")
+        .def(py::init<>())
+        .def_readwrite("Hss"  , &CanonicalStructure::Hss)
+        .def_readwrite("Hsp"  , &CanonicalStructure::Hsp)
+        .def_readwrite("Vps"  , &CanonicalStructure::Vps)
+        .def_readwrite("Vpp"  , &CanonicalStructure::Vpp)
+        .def_readwrite("Sbsns", &CanonicalStructure::Sbsns)
+        .def_readwrite("Sbsp" , &CanonicalStructure::Sbsp)
+        ;
+
     py::class_<CanonicalMatrix>(m, "CanonicalMatrix")
         .def(py::init<CanonicalMatrix const&>())
         .def_readonly("dims" , &CanonicalMatrix::dims)
@@ -40,5 +50,6 @@ void exportCanonicalMatrix(py::module& m)
         .def_readonly("jn"   , &CanonicalMatrix::jn)
         .def_readonly("js"   , &CanonicalMatrix::js)
         .def_readonly("ju"   , &CanonicalMatrix::ju)
+        .def_readonly("structure", &CanonicalMatrix::structure)
         ;
 }
@@ -33,6 +33,7 @@ void exportCanonicalizer(py::module& m)
         .def(py::init<const MasterDims&>())
         .def(py::init<const MasterMatrix&>())
         .def(py::init<const Canonicalizer&>())
+        .def("setOrderByIndex", &Canonicalizer::setOrderByIndex)
         .def("update", &Canonicalizer::update)
         .def("canonicalMatrix", &Canonicalizer::canonicalMatrix, PYBINDX_ENSURE_MUTUAL_EXISTENCE)
         ;
@@ -0,0 +1,46 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/FiniteDifferences.hpp>
+using namespace Optima;
+
+void exportFiniteDifferences(py::module& m)
+{
+    auto colorColumns4py = [](MatrixView4py pattern) { return colorColumns(pattern); };
+
+    auto finiteDifferenceObjectiveFunction4py = [](const ObjectiveFunction& f, MatrixView4py pattern)
+    {
+        return finiteDifferenceObjectiveFunction(f, pattern);
+    };
+
+    auto finiteDifferenceConstraintFunction4py = [](const ConstraintFunction& c, MatrixView4py pattern)
+    {
+        return finiteDifferenceConstraintFunction(c, pattern);
+    };
+
+    m.def("colorColumns", colorColumns4py);
+    m.def("finiteDifferenceObjectiveFunction", py::overload_cast<const ObjectiveFunction&>(finiteDifferenceObjectiveFunction));
+    m.def("finiteDifferenceObjectiveFunction", finiteDifferenceObjectiveFunction4py);
+    m.def("finiteDifferenceConstraintFunction", py::overload_cast<const ConstraintFunction&>(finiteDifferenceConstraintFunction));
+    m.def("finiteDifferenceConstraintFunction", finiteDifferenceConstraintFunction4py);
+}
@@ -29,6 +29,7 @@ void exportLineSearchOptions(py::module& m)
         .def(py::init<>())
         .def_readwrite("tolerance", &LineSearchOptions::tolerance)
         .def_readwrite("maxiterations", &LineSearchOptions::maxiterations)
+        .def_readwrite("parallel", &LineSearchOptions::parallel)
         .def_readwrite("trigger_when_current_error_is_greater_than_initial_error_by_factor", &LineSearchOptions::trigger_when_current_error_is_greater_than_initial_error_by_factor)
         .def_readwrite("trigger_when_current_error_is_greater_than_previous_error_by_factor", &LineSearchOptions::trigger_when_current_error_is_greater_than_previous_error_by_factor)
         ;
@@ -28,7 +28,8 @@ void exportMasterSolver(py::module& m)
 {
     py::class_<MasterSolver>(m, "MasterSolver")
         .def(py::init<const MasterDims&>())
+        .def(py::init<const MasterSolver&>())
         .def("setOptions", &MasterSolver::setOptions)
-        .def("solve", &MasterSolver::solve)
+        .def("solve", &MasterSolver::solve, py::call_guard<py::gil_scoped_release>()) // Python callbacks in the problem acquire the GIL when called
         ;
 }
@@ -34,8 +34,9 @@ void exportMatrixViewH(py::module& m)
         .def(py::init<MatrixView4py, MatrixView4py, bool>(),
             pyx::keep_argument_alive<0>(),
             pyx::keep_argument_alive<1>())
-        .def_readonly("Hxx"      , &MatrixViewH::Hxx)
-        .def_readonly("Hxp"      , &MatrixViewH::Hxp)
-        .def_readonly("isHxxDiag", &MatrixViewH::isHxxDiag)
+        .def_readonly("Hxx"            , &MatrixViewH::Hxx)
+        .def_readonly("Hxp"            , &MatrixViewH::Hxp)
+        .def_readonly("isHxxDiag"      , &MatrixViewH::isHxxDiag)
+        .def_readonly("isHxx4basicvars", &MatrixViewH::isHxx4basicvars)
         ;
 }
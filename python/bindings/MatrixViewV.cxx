@@ -34,7 +34,8 @@ void exportMatrixViewV(py::module& m)
         .def(py::init<MatrixView4py, MatrixView4py>(),
             pyx::keep_argument_alive<0>(),
             pyx::keep_argument_alive<1>())
-        .def_readonly("Vpx", &MatrixViewV::Vpx)
-        .def_readonly("Vpp", &MatrixViewV::Vpp)
+        .def_readonly("Vpx"            , &MatrixViewV::Vpx)
+        .def_readonly("Vpp"            , &MatrixViewV::Vpp)
+        .def_readonly("isVpx4basicvars", &MatrixViewV::isVpx4basicvars)
         ;
 }
@@ -29,6 +29,8 @@ void exportNewtonStep(py::module& m)
     py::class_<NewtonStep>(m, "NewtonStep")
         .def(py::init<const MasterDims&>())
         .def("setOptions", &NewtonStep::setOptions)
+        .def("initialize", &NewtonStep::initialize)
         .def("apply", &NewtonStep::apply)
+        .def("numDecompositions", &NewtonStep::numDecompositions)
         ;
 }
@@ -21,6 +21,7 @@ namespace py = pybind11;
 
 void exportEigen(py::module& m);
 void exportConstants(py::module& m);
+void exportCancellationToken(py::module& m);
 void exportCanonicalDims(py::module& m);
 void exportCanonicalizer(py::module& m);
 void exportCanonicalMatrix(py::module& m);
@@ -30,6 +31,7 @@ void exportDims(py::module& m);
 void exportEchelonizer(py::module& m);
 void exportEchelonizerExtended(py::module& m);
 void exportEchelonizerW(py::module& m);
+void exportFiniteDifferences(py::module& m);
 void exportIndex(py::module& m);
 void exportIndexUtils(py::module& m);
 void exportLineSearchOptions(py::module& m);
@@ -53,9 +55,11 @@ void exportOutputter(py::module& m);
 void exportOptions(py::module& m);
 void exportProblem(py::module& m);
 void exportResidualFunction(py::module& m);
+void exportResidualFunctionOptions(py::module& m);
 void exportResidualVector(py::module& m);
 void exportResult(py::module& m);
 void exportSolver(py::module& m);
+void exportBatchSolver(py::module& m);
 void exportStablePartition(py::module& m);
 void exportStability(py::module& m);
 void exportState(py::module& m);
@@ -66,6 +70,7 @@ PYBIND11_MODULE(optima4py, m)
 {
     exportEigen(m);
     exportConstants(m);
+    exportCancellationToken(m);
     exportCanonicalDims(m);
     exportCanonicalizer(m);
     exportCanonicalMatrix(m);
@@ -75,6 +80,7 @@ PYBIND11_MODULE(optima4py, m)
     exportEchelonizer(m);
     exportEchelonizerExtended(m);
     exportEchelonizerW(m);
+    exportFiniteDifferences(m);
     exportIndex(m);
     exportIndexUtils(m);
     exportLineSearchOptions(m);
@@ -98,9 +104,11 @@ PYBIND11_MODULE(optima4py, m)
     exportOptions(m);
     exportProblem(m);
     exportResidualFunction(m);
+    exportResidualFunctionOptions(m);
     exportResidualVector(m);
     exportResult(m);
     exportSolver(m);
+    exportBatchSolver(m);
     exportStablePartition(m);
     exportStability(m);
     exportState(m);
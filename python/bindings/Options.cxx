@@ -50,14 +50,49 @@ void exportOptions(py::module& m)
         .def_readwrite("maxiters", &SteepestDescentOptions::maxiters)
         ;
 
+    py::class_<BatchOptions>(m, "BatchOptions")
+        .def(py::init<>())
+        .def_readwrite("threads", &BatchOptions::threads)
+        .def_readwrite("lanes", &BatchOptions::lanes)
+        ;
+
+    py::class_<DecomposeOptions>(m, "DecomposeOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &DecomposeOptions::active)
+        .def_readwrite("threads", &DecomposeOptions::threads)
+        .def_readwrite("fxx", &DecomposeOptions::fxx)
+        .def_readwrite("Jex", &DecomposeOptions::Jex)
+        .def_readwrite("Jgx", &DecomposeOptions::Jgx)
+        .def_readwrite("detect", &DecomposeOptions::detect)
+        ;
+
+    py::class_<PresolveOptions>(m, "PresolveOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &PresolveOptions::active)
+        .def_readwrite("tolerance", &PresolveOptions::tolerance)
+        ;
+
+    py::class_<SolutionCacheOptions>(m, "SolutionCacheOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &SolutionCacheOptions::active)
+        .def_readwrite("capacity", &SolutionCacheOptions::capacity)
+        ;
+
     py::class_<Options>(m, "Options")
         .def(py::init<>())
         .def_readwrite("output", &Options::output)
         .def_readwrite("maxiterations", &Options::maxiterations)
+        .def_readwrite("timelimit", &Options::timelimit)
+        .def_readwrite("cancellation", &Options::cancellation)
         .def_readwrite("linesearch", &Options::linesearch)
         .def_readwrite("steepestdescent", &Options::steepestdescent)
         .def_readwrite("backtrack", &Options::backtrack)
         .def_readwrite("newtonstep", &Options::newtonstep)
         .def_readwrite("convergence", &Options::convergence)
+        .def_readwrite("residualfunction", &Options::residualfunction)
+        .def_readwrite("solutioncache", &Options::solutioncache)
+        .def_readwrite("presolve", &Options::presolve)
+        .def_readwrite("decompose", &Options::decompose)
+        .def_readwrite("batch", &Options::batch)
         ;
 }
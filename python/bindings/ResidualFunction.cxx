@@ -44,13 +44,17 @@ void exportResidualFunction(py::module& m)
         .def_property_readonly("Fc",              [](const ResidualFunctionResult& self) { return self.Fc;              })
         .def_property_readonly("stabilitystatus", [](const ResidualFunctionResult& self) { return self.stabilitystatus; })
         .def_property_readonly("succeeded",       [](const ResidualFunctionResult& self) { return self.succeeded;       })
+        .def_property_readonly("constant",        [](const ResidualFunctionResult& self) { return self.constant;        })
         ;
 
     py::class_<ResidualFunction>(m, "ResidualFunction")
         .def(py::init<const MasterDims&>())
+        .def("setOptions"                  , &ResidualFunction::setOptions)
         .def("initialize"                  , &ResidualFunction::initialize)
         .def("update"                      , &ResidualFunction::update)
         .def("updateSkipJacobian"          , &ResidualFunction::updateSkipJacobian)
         .def("result"                      , &ResidualFunction::result, py::return_value_policy::reference_internal)
+        .def("checkpoint"                  , &ResidualFunction::checkpoint)
+        .def("restore"                     , &ResidualFunction::restore)
         ;
 }
@@ -0,0 +1,39 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/ResidualFunctionOptions.hpp>
+using namespace Optima;
+
+void exportResidualFunctionOptions(py::module& m)
+{
+    py::enum_<HessianMethod>(m, "HessianMethod")
+        .value("Exact", HessianMethod::Exact)
+        .value("BFGS", HessianMethod::BFGS)
+        .value("Constant", HessianMethod::Constant)
+        ;
+
+    py::class_<ResidualFunctionOptions>(m, "ResidualFunctionOptions")
+        .def(py::init<>())
+        .def_readwrite("hessian", &ResidualFunctionOptions::hessian)
+        .def_readwrite("concurrent", &ResidualFunctionOptions::concurrent)
+        ;
+}
@@ -30,6 +30,8 @@ void exportResult(py::module& m)
         .def(py::init<>())
         .def_readwrite("succeeded", &Result::succeeded)
         .def_readwrite("iterations", &Result::iterations)
+        .def_readwrite("predicted", &Result::predicted)
+        .def_readwrite("interrupted", &Result::interrupted)
         .def_readwrite("error", &Result::error)
         .def_readwrite("error_optimality", &Result::error_optimality)
         .def_readwrite("error_feasibility", &Result::error_feasibility)
@@ -38,6 +40,8 @@ void exportResult(py::module& m)
         .def_readwrite("num_objective_evals_fx", &Result::num_objective_evals_fx)
         .def_readwrite("num_objective_evals_fxx", &Result::num_objective_evals_fxx)
         .def_readwrite("num_objective_evals_fxp", &Result::num_objective_evals_fxp)
+        .def_readwrite("num_linear_decompositions", &Result::num_linear_decompositions)
+        .def_readwrite("num_echelonizations", &Result::num_echelonizations)
         .def_readwrite("time", &Result::time)
         .def_readwrite("time_objective_evals", &Result::time_objective_evals)
         .def_readwrite("time_objective_evals_f", &Result::time_objective_evals_f)
@@ -33,6 +33,6 @@ void exportSolver(py::module& m)
     py::class_<Solver>(m, "Solver")
         .def(py::init<const Problem&>())
         .def("setOptions", &Solver::setOptions)
-        .def("solve", &Solver::solve)
+        .def("solve", &Solver::solve, py::call_guard<py::gil_scoped_release>()) // Python callbacks in the problem acquire the GIL when called
         ;
 }
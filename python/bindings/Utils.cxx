@@ -35,6 +35,10 @@ void exportUtils(py::module& m)
     auto largestStep1 = static_cast<double(*)(const Vector&, const Vector&)>(&largestStep);
     auto largestStep2 = static_cast<double(*)(const Vector&, const Vector&, const Vector&, const Vector&)>(&largestStep);
 
+    using Function = std::function<double(double)>;
+
+    auto minimizeGoldenSectionSearch = static_cast<double(*)(const Function&, double, double, double)>(&Optima::minimizeGoldenSectionSearch<Function>);
+
     auto multiplyMatrixVectorWithoutResidualRoundOffError = [](MatrixView4py A, VectorView x)
     {
         return Optima::multiplyMatrixVectorWithoutResidualRoundOffError(A, x);
@@ -47,14 +51,14 @@ void exportUtils(py::module& m)
     m.def("lessThan", &lessThan);
     m.def("greaterThan", &greaterThan);
     m.def("infinity", &infinity);
-    m.def("bfgs", &bfgs);
-    m.def("minimizeGoldenSectionSearch", &minimizeGoldenSectionSearch);
-    m.def("minimizeBrent", &minimizeBrent);
+    m.def("minimizeGoldenSectionSearch", minimizeGoldenSectionSearch);
+    m.def("minimizeBrent", &minimizeBrent<Function>);
     m.def("inverseShermanMorrison", &inverseShermanMorrison);
     m.def("rational", &rational);
     m.def("rationalize", &rationalize);
     m.def("multiplyMatrixVectorWithoutResidualRoundOffError", multiplyMatrixVectorWithoutResidualRoundOffError);
     m.def("matrixStructure", &matrixStructure);
+    m.def("detectMatrixStructure", &detectMatrixStructure);
     m.def("isZeroMatrix", &isZeroMatrix);
     m.def("isDiagonalMatrix", &isDiagonalMatrix);
     m.def("isDenseMatrix", &isDenseMatrix);
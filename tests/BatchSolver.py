@@ -0,0 +1,95 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2020 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from numpy import *
+
+
+@pytest.mark.parametrize("threads", [0, 4])
+def testBatchSolver(threads):
+
+    nx = 10   # the number of variables in each problem
+    nb = 100  # the number of problems in the batch
+
+    #---------------------------------------------------------------
+    # The problem: minimize 0.5*||x - 1||^2 subject to sum(x) = b
+    # and x >= 0, whose solution is x = 1 + (b - nx)/nx for b >= 0
+    #---------------------------------------------------------------
+
+    def objectivefn(res, x, p, opts):
+        res.f = 0.5 * sum((x - 1.0)**2)
+        res.fx = x - 1.0
+        res.fxx = eye(nx)
+        res.diagfxx = True
+        res.succeeded = True
+
+    dims = Dims()
+    dims.x = nx
+    dims.be = 1
+
+    problem = Problem(dims)
+    problem.f = objectivefn
+    problem.Aex = ones((1, nx))
+    problem.be = array([nx])
+    problem.xlower = zeros(nx)
+    problem.xupper = full(nx, inf)
+
+    options = Options()
+    options.batch.threads = threads
+
+    solver = BatchSolver(problem)
+    solver.setOptions(options)
+
+    be = random.uniform(nx, 2 * nx, (nb, 1))  # the stacked right-hand sides, one row per problem
+
+    x = ones((nb, nx))         # the stacked initial guesses, overwritten with the solutions
+    w = zeros((nb, 1))         # the stacked Lagrange multipliers
+    iterations = zeros(nb, dtype=int64)
+    succeeded = zeros(nb, dtype=bool)
+
+    res = solver.solve(problem, x, be=be, w=w, iterations=iterations, succeeded=succeeded)
+
+    assert res.succeeded
+    assert all(succeeded)
+    assert all(iterations > 0)
+    assert allclose(x, 1.0 + (be - nx) / nx)
+    assert allclose(w, -(be - nx) / nx)
+
+    #---------------------------------------------------------------
+    # The same batch, with each problem prepared by a set-up function
+    #---------------------------------------------------------------
+
+    def setup(problem, i):
+        problem.be = be[i]
+
+    x = ones((nb, nx))
+
+    res = solver.solve(problem, x, setup=setup)
+
+    assert res.succeeded
+    assert allclose(x, 1.0 + (be - nx) / nx)
+
+    #---------------------------------------------------------------
+    # The outputs must be preallocated arrays of the expected shape
+    #---------------------------------------------------------------
+
+    with pytest.raises(Exception):
+        solver.solve(problem, ones((nb, nx + 1)), be=be)
+
+    with pytest.raises(Exception):
+        solver.solve(problem, ones((nb, nx)), be=be, succeeded=zeros(nb, dtype=int32))
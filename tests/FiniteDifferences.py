@@ -0,0 +1,40 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2020 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+from testing.optima import *
+
+
+def testFiniteDifferences():
+
+    #---------------------------------------------------------------
+    # Test method colorColumns
+    #---------------------------------------------------------------
+
+    def checkColoring(pattern):
+        colors = colorColumns(pattern)
+        m, n = pattern.shape
+        for i in range(m):
+            nonzeros = [j for j in range(n) if pattern[i, j] != 0.0]
+            assert len(set(colors[nonzeros])) == len(nonzeros)  # columns sharing a row have distinct colors
+        return colors.max() + 1 if n > 0 else 0
+
+    tridiagonal = npy.eye(10) + npy.eye(10, k=1) + npy.eye(10, k=-1)
+
+    assert checkColoring(npy.eye(10)) == 1
+    assert checkColoring(tridiagonal) == 3
+    assert checkColoring(npy.ones((4, 4))) == 4
+    assert checkColoring(npy.zeros((3, 0))) == 0
@@ -85,3 +85,68 @@ def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
     ju = M.ju  # the indices of the unstable variables in x
 
     assert all(u.x[ju] == a.x[ju])  # ensure ux[ju] == ax[ju]
+
+
+@pytest.mark.parametrize("method", tested_methods)
+def testLinearSolverWithStructuredBlocks(method):
+
+    nx, np, ny, nz = 15, 5, 5, 0
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    # Hxx is diagonal and the blocks Hxp, Vpx and Ap are zero, so that
+    # the linear solvers can skip the products with the corresponding
+    # canonical blocks, which must not change the solution
+    Hxx = npy.diag(random.rand(nx) + 1.0)
+    Hxp = npy.zeros((nx, np))
+    Vpx = npy.zeros((np, nx))
+    Vpp = npy.diag(random.rand(np) + 1.0)
+    Ax  = random.rand(ny, nx)
+    Ap  = npy.zeros((ny, np))
+    Jx  = npy.zeros((nz, nx))
+    Jp  = npy.zeros((nz, np))
+
+    H = MatrixViewH(Hxx, Hxp, True)
+    V = MatrixViewV(Vpx, Vpp)
+    W = MatrixViewW(Ax, Ap, Ax, Ap, Jx, Jp)
+
+    echelonizerW = EchelonizerW(dims)
+    echelonizerW.initialize(Ax, Ap)
+    echelonizerW.update(Jx, Jp, npy.ones(nx))
+
+    RWQ = echelonizerW.RWQ()
+
+    jsu = StablePartition(nx)
+    jsu.setUnstable(RWQ.jn[:2])
+
+    M = MasterMatrix(dims, H, V, W, RWQ, jsu.stable(), jsu.unstable())
+
+    canonicalizer = Canonicalizer(M)
+
+    Mc = canonicalizer.canonicalMatrix()
+
+    assert Mc.structure.Hss  == MatrixStructure.Diagonal
+    assert Mc.structure.Hsp  == MatrixStructure.Zero
+    assert Mc.structure.Vps  == MatrixStructure.Zero
+    assert Mc.structure.Vpp  == MatrixStructure.Diagonal
+    assert Mc.structure.Sbsp == MatrixStructure.Zero
+
+    uexp = MasterVector(dims)
+    uexp.x = npy.linspace(1, nx, nx)
+    uexp.p = npy.linspace(1, np, np)
+    uexp.w = npy.linspace(1, ny, ny)
+
+    a = M * uexp
+
+    options = LinearSolverOptions()
+    options.method = method
+
+    linearsolver = LinearSolver(dims)
+    linearsolver.setOptions(options)
+
+    u = MasterVector(dims)
+
+    linearsolver.decompose(Mc)
+    linearsolver.solve(Mc, a, u)
+
+    assert_almost_equal( (M * u).array(), a.array() )
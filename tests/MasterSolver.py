@@ -156,3 +156,580 @@ def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
         print(f"    Jp  = {repr(Jp)}")
 
     assert res.succeeded
+
+    #---------------------------------------------------------------
+    # Test the solution cache, whose first-order prediction is exact
+    # for this quadratic problem under a small perturbation of b
+    #---------------------------------------------------------------
+
+    options.solutioncache.active = True
+    solver.setOptions(options)
+
+    u = MasterVector(dims)
+    res = solver.solve(problem, u)
+
+    assert res.succeeded
+    assert not res.predicted
+
+    problem.b = (Ax @ cx + Ap @ cp) * (1.0 + 1e-4)
+
+    u = MasterVector(dims)
+    res = solver.solve(problem, u)
+
+    assert res.succeeded
+    assert res.predicted
+    assert res.iterations == 0
+
+
+@pytest.mark.parametrize("method", [LinearSolverMethod.Fullspace, LinearSolverMethod.Nullspace, LinearSolverMethod.Rangespace])
+@pytest.mark.parametrize("nz"    , [0, 1])
+def testMasterSolverWithoutHeapAllocations(method, nz):
+
+    # This test is most useful with Optima compiled with EIGEN_RUNTIME_NO_MALLOC
+    # and assertions enabled (see notes/how-to-execute-tests.md), in which any
+    # heap allocation by Eigen from the initialization to the finalization of
+    # a calculation (except in the functions f, h and v) aborts the tests. The
+    # initial guess below is far from the solution of this entropy
+    # minimization problem, so that the error control steps are also used.
+
+    nx, np, ny = 12, 0, 4
+
+    Ax = random.rand(ny, nx)
+    Jx = random.rand(nz, nx)
+    cx = random.rand(nx)
+    xs = random.rand(nx)
+
+    def objectivefn_f(res, x, p, opts):
+        res.f   = sum(x * (log(x) - 1.0 + cx))
+        res.fx  = log(x) + cx
+        res.fxx = diag(1.0 / x)
+        res.diagfxx = True
+        res.succeeded = True
+
+    def constraintfn_h(res, x, p, opts):
+        res.val = Jx @ (x - xs)
+        res.ddx = Jx
+        res.succeeded = True
+
+    def constraintfn_v(res, x, p, opts):
+        res.succeeded = True
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.h = constraintfn_h
+    problem.v = constraintfn_v
+    problem.Ax = Ax
+    problem.Ap = zeros((ny, np))
+    problem.b = Ax @ xs
+    problem.xlower = full(nx, 1e-40)
+    problem.xupper = full(nx, inf)
+    problem.plower = full(np, -inf)
+    problem.pupper = full(np,  inf)
+    problem.phi = None
+
+    options = Options()
+    options.newtonstep.linearsolver.method = method
+    options.solutioncache.active = True
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    solver = MasterSolver(dims)
+    solver.setOptions(options)
+
+    u = MasterVector(dims)
+    u.x = full(nx, 10.0)
+
+    res = solver.solve(problem, u)
+
+    assert res.succeeded
+
+    # The calculation is now warm-started from the prediction of the solution cache
+    problem.b = Ax @ xs * (1.0 + 1e-4)
+
+    u = MasterVector(dims)
+    u.x = full(nx, 10.0)
+
+    res = solver.solve(problem, u)
+
+    assert res.succeeded
+
+
+@pytest.mark.parametrize("method", [LinearSolverMethod.Fullspace, LinearSolverMethod.Nullspace, LinearSolverMethod.Rangespace])
+@pytest.mark.parametrize("solved", [False, True])
+def testMasterSolverCopy(method, solved):
+
+    # A copy of a master solver shares the echelon form of Ax and the cached
+    # solutions of the original one, and creates its own workspace only in
+    # its first solve call. Its calculations must be the same as those of
+    # the original one, whether this has solved a problem before or not.
+
+    nx, np, ny, nz = 12, 0, 4, 1
+
+    Ax = random.rand(ny, nx)
+    Jx = random.rand(nz, nx)
+    cx = random.rand(nx)
+    xs = random.rand(nx)
+
+    def objectivefn_f(res, x, p, opts):
+        res.f   = sum(x * (log(x) - 1.0 + cx))
+        res.fx  = log(x) + cx
+        res.fxx = diag(1.0 / x)
+        res.diagfxx = True
+        res.succeeded = True
+
+    def constraintfn_h(res, x, p, opts):
+        res.val = Jx @ (x - xs)
+        res.ddx = Jx
+        res.succeeded = True
+
+    def constraintfn_v(res, x, p, opts):
+        res.succeeded = True
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.h = constraintfn_h
+    problem.v = constraintfn_v
+    problem.Ax = Ax
+    problem.Ap = zeros((ny, np))
+    problem.b = Ax @ xs
+    problem.xlower = full(nx, 1e-40)
+    problem.xupper = full(nx, inf)
+    problem.plower = full(np, -inf)
+    problem.pupper = full(np,  inf)
+    problem.phi = None
+
+    options = Options()
+    options.newtonstep.linearsolver.method = method
+    options.solutioncache.active = True
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    solver = MasterSolver(dims)
+    solver.setOptions(options)
+
+    if solved:
+        u = MasterVector(dims)
+        u.x = full(nx, 10.0)
+        assert solver.solve(problem, u).succeeded
+
+    copy = MasterSolver(solver)
+    copyofcopy = MasterSolver(copy)
+
+    problem.b = Ax @ xs * (1.0 + 1e-3)
+
+    results, solutions = [], []
+
+    for s in [solver, copy, copyofcopy]:
+        u = MasterVector(dims)
+        u.x = full(nx, 10.0)
+        results.append(s.solve(problem, u))
+        solutions.append(u)
+
+    for res, u in zip(results, solutions):
+        assert res.succeeded
+        assert res.iterations == results[0].iterations
+        assert res.predicted == results[0].predicted
+        assert all(u.x == solutions[0].x)
+        assert all(u.w == solutions[0].w)
+
+
+def createQuadraticProblemForConcurrencyTests(nx, np, ny, nz):
+
+    Hxx = random.rand(nx, nx)
+    Hxp = random.rand(nx, np)
+    Vpx = random.rand(np, nx)
+    Vpp = random.rand(np, np) + nx * eye(np)
+    Ax  = random.rand(ny, nx)
+    Ap  = random.rand(ny, np)
+    Jx  = random.rand(nz, nx)
+    Jp  = random.rand(nz, np)
+
+    Hxx = Hxx.T @ Hxx + eye(nx)
+
+    cx = ones(nx)
+    cp = ones(np)
+
+    def objectivefn_f(res, x, p, opts):
+        dx = x - cx
+        dp = p - cp
+        res.f   = 0.5 * dx.T @ Hxx @ dx + dx.T @ Hxp @ dp
+        res.fx  = Hxx @ dx + Hxp @ dp
+        res.fxx = Hxx
+        res.fxp = Hxp
+        res.succeeded = True
+
+    def constraintfn_h(res, x, p, opts):
+        res.val = Jx @ (x - cx) + Jp @ (p - cp)
+        res.ddx = Jx
+        res.ddp = Jp
+        res.succeeded = True
+
+    def constraintfn_v(res, x, p, opts):
+        res.val = Vpx @ (x - cx) + Vpp @ (p - cp)
+        res.ddx = Vpx
+        res.ddp = Vpp
+        res.succeeded = True
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.h = constraintfn_h
+    problem.v = constraintfn_v
+    problem.Ax = Ax
+    problem.Ap = Ap
+    problem.b = Ax @ cx + Ap @ cp
+    problem.xlower = full(nx, 0.5)
+    problem.xupper = full(nx, inf)
+    problem.plower = full(np, -inf)
+    problem.pupper = full(np,  inf)
+    problem.phi = None
+
+    problem.xlower[0] = 1.5  # the bound is then active at the solution, which takes more than one iteration
+
+    return problem
+
+
+@pytest.mark.parametrize("np", [0, 2])
+@pytest.mark.parametrize("nz", [0, 2])
+def testMasterSolverWithConcurrentEvaluations(np, nz):
+
+    # The concurrent evaluation of f, h and v (and the echelonization of W
+    # overlapping with them) must produce the same calculation as the
+    # sequential one, since only the order of independent evaluations changes.
+
+    nx, ny = 10, 3
+
+    problem = createQuadraticProblemForConcurrencyTests(nx, np, ny, nz)
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    results, solutions = [], []
+
+    for concurrent in [False, True]:
+        options = Options()
+        options.residualfunction.concurrent = concurrent
+
+        solver = MasterSolver(dims)
+        solver.setOptions(options)
+
+        u = MasterVector(dims)
+        results.append(solver.solve(problem, u))
+        solutions.append(u)
+
+    sequential, concurrent = results
+    usequential, uconcurrent = solutions
+
+    assert sequential.succeeded
+    assert concurrent.succeeded
+    assert concurrent.iterations == sequential.iterations
+    assert all(uconcurrent.x == usequential.x)
+    assert all(uconcurrent.p == usequential.p)
+    assert all(uconcurrent.w == usequential.w)
+
+
+@pytest.mark.parametrize("failing", ["f", "h", "v"])
+def testMasterSolverWithConcurrentEvaluationsAndFailingFunction(failing):
+
+    # An exception raised by one of the functions evaluated concurrently is
+    # raised by solve once all evaluations have finished, and the solver can
+    # be used again afterwards.
+
+    nx, np, ny, nz = 10, 2, 3, 2
+
+    problem = createQuadraticProblemForConcurrencyTests(nx, np, ny, nz)
+
+    function = getattr(problem, failing)
+
+    def failingfn(res, x, p, opts):
+        raise RuntimeError(f"The evaluation of {failing} failed.")
+
+    setattr(problem, failing, failingfn)
+
+    options = Options()
+    options.residualfunction.concurrent = True
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    solver = MasterSolver(dims)
+    solver.setOptions(options)
+
+    u = MasterVector(dims)
+
+    with pytest.raises(RuntimeError, match=f"The evaluation of {failing} failed."):
+        solver.solve(problem, u)
+
+    setattr(problem, failing, function)
+
+    u = MasterVector(dims)
+
+    assert solver.solve(problem, u).succeeded
+
+
+@pytest.mark.parametrize("failing", ["f", "h", "v"])
+def testMasterSolverWithConcurrentEvaluationsAndUnsuccessfulFunction(failing):
+
+    # In a concurrent evaluation, the echelonization of W overlaps with the
+    # evaluation of f and v, and so it happens even if these do not succeed.
+    # This is also the case in a sequential evaluation, so that both produce
+    # the same calculation when the functions do not succeed at some points.
+
+    nx, np, ny, nz = 10, 2, 3, 2
+
+    problem = createQuadraticProblemForConcurrencyTests(nx, np, ny, nz)
+
+    function = getattr(problem, failing)
+
+    def unsuccessfulfn(res, x, p, opts):
+        function(res, x, p, opts)
+        res.succeeded = bool(x[1] < 0.9)
+
+    setattr(problem, failing, unsuccessfulfn)
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    results, solutions = [], []
+
+    for concurrent in [False, True]:
+        options = Options()
+        options.residualfunction.concurrent = concurrent
+        options.maxiterations = 20
+
+        solver = MasterSolver(dims)
+        solver.setOptions(options)
+
+        u = MasterVector(dims)
+        results.append(solver.solve(problem, u))
+        solutions.append(u)
+
+    sequential, concurrent = results
+    usequential, uconcurrent = solutions
+
+    assert concurrent.succeeded == sequential.succeeded
+    assert concurrent.iterations == sequential.iterations
+    assert all(uconcurrent.x == usequential.x)
+    assert all(uconcurrent.p == usequential.p)
+    assert all(uconcurrent.w == usequential.w)
+
+
+def createQuarticProblemForErrorControlTests(evaluations):
+
+    # The Newton steps from points near x = 0 overshoot the solution x = 1 of
+    # fx = x**3 - 1 = 0 by far, which triggers the line search. The points at
+    # which fxx is evaluated (i.e., the full evaluations) are appended to
+    # the given list.
+
+    nx, np, ny = 3, 0, 1
+
+    def objectivefn_f(res, x, p, opts):
+        res.f   = sum(x**4)/4 - sum(x)
+        res.fx  = x**3 - 1
+        res.fxx = diag(3*x**2)
+        res.diagfxx = True
+        res.succeeded = True
+        if opts.eval.fxx:
+            evaluations.append(x.copy())
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.Ax = array([[1.0, 0.0, 0.0]])
+    problem.Ap = zeros((ny, np))
+    problem.b = ones(ny)
+    problem.xlower = full(nx, -inf)
+    problem.xupper = full(nx,  inf)
+    problem.plower = full(np, -inf)
+    problem.pupper = full(np,  inf)
+    problem.phi = None
+
+    return problem
+
+
+@pytest.mark.parametrize("hessian", [HessianMethod.Exact, HessianMethod.BFGS])
+def testMasterSolverWithParallelLineSearch(hessian):
+
+    # In the parallel mode of the line search, the trial states are evaluated
+    # with residual functions allocated once and reused in the next line
+    # searches and solves.
+
+    nx, np, ny, nz = 3, 0, 1, 0
+
+    problem = createQuarticProblemForErrorControlTests([])
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    for parallel in [0, 4]:
+        options = Options()
+        options.maxiterations = 100
+        options.linesearch.parallel = parallel
+        options.residualfunction.concurrent = parallel > 1  # required by the parallel mode
+        options.residualfunction.hessian = hessian
+
+        solver = MasterSolver(dims)
+        solver.setOptions(options)
+
+        results, solutions = [], []
+
+        for _ in range(2):
+            u = MasterVector(dims)
+            u.x = full(nx, 0.05)
+            results.append(solver.solve(problem, u))
+            solutions.append(u)
+
+        assert results[0].succeeded
+        assert allclose(solutions[0].x, ones(nx))
+
+        # A second solve with the same solver repeats the same calculation
+        assert results[1].iterations == results[0].iterations
+        assert all(solutions[1].x == solutions[0].x)
+        assert all(solutions[1].w == solutions[0].w)
+
+
+@pytest.mark.parametrize("x0", [0.001, 0.01])
+@pytest.mark.parametrize("parallel", [0, 4])
+def testMasterSolverWithLineSearchNotDecreasingError(x0, parallel):
+
+    # From these initial guesses, the line search sometimes cannot decrease
+    # the error and the Newton step is then taken as is. Its evaluation is
+    # kept for this case, and so no point is evaluated in full twice.
+
+    nx, np, ny, nz = 3, 0, 1, 0
+
+    evaluations = []
+
+    problem = createQuarticProblemForErrorControlTests(evaluations)
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    options = Options()
+    options.maxiterations = 100
+    options.linesearch.parallel = parallel
+    options.residualfunction.concurrent = parallel > 1  # required by the parallel mode
+
+    solver = MasterSolver(dims)
+    solver.setOptions(options)
+
+    u = MasterVector(dims)
+    u.x = full(nx, x0)
+
+    res = solver.solve(problem, u)
+
+    assert res.succeeded
+    assert allclose(u.x, ones(nx))
+
+    points = set(tuple(x) for x in evaluations)
+
+    assert len(points) == len(evaluations)
+
+
+def testMasterSolverWithHessianApproximatedByBFGS():
+
+    # The minimization of the Gibbs energy of an ideal solution, whose Hessian
+    # matrix is diagonal. With BFGS approximations of the Hessian matrix, the
+    # same solution is found without evaluations of fxx, but in more
+    # iterations (16 instead of 7).
+
+    nx, np, ny, nz = 5, 0, 2, 0
+
+    c = array([0.0, -1.0, -3.0, -2.0, 1.0])
+
+    fxxevaluated = []
+
+    def objectivefn_f(res, x, p, opts):
+        res.f   = sum(x * (log(x) + c))
+        res.fx  = log(x) + c + 1
+        res.fxx = diag(1/x)
+        res.diagfxx = True
+        res.succeeded = True
+        fxxevaluated.append(opts.eval.fxx)
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.Ax = array([[1.0, 0.0, 1.0, 2.0, 1.0],
+                        [0.0, 1.0, 1.0, 1.0, 2.0]])
+    problem.Ap = zeros((ny, np))
+    problem.b = array([1.0, 2.0])
+    problem.xlower = full(nx, 1e-20)
+    problem.xupper = full(nx, inf)
+    problem.plower = full(np, -inf)
+    problem.pupper = full(np,  inf)
+    problem.phi = None
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    results, solutions = [], []
+
+    for hessian in [HessianMethod.Exact, HessianMethod.BFGS]:
+        options = Options()
+        options.maxiterations = 100
+        options.residualfunction.hessian = hessian
+
+        solver = MasterSolver(dims)
+        solver.setOptions(options)
+
+        fxxevaluated.clear()
+
+        u = MasterVector(dims)
+        u.x = ones(nx)
+        results.append(solver.solve(problem, u))
+        solutions.append(u)
+
+    exact, bfgs = results
+    uexact, ubfgs = solutions
+
+    assert exact.succeeded
+    assert bfgs.succeeded
+    assert not any(fxxevaluated)
+    assert allclose(ubfgs.x, uexact.x)
+    assert exact.iterations < bfgs.iterations <= 3 * exact.iterations
+
+
+@pytest.mark.parametrize("nz", [0, 2])
+def testMasterSolverWithConstantHessian(nz):
+
+    # A quadratic program, whose Hessian matrix is then evaluated only once.
+    # The solution and the number of iterations are the same as with exact
+    # Hessian matrices. The Jacobian matrix is decomposed at most once per
+    # Newton step in both cases (see tests/NewtonStep.py for its reuse).
+
+    nx, np, ny = 10, 0, 3
+
+    problem = createQuadraticProblemForConcurrencyTests(nx, np, ny, nz)
+
+    objectivefn_f = problem.f
+
+    fxxevaluated = []
+
+    def objectivefn_f_counted(res, x, p, opts):
+        objectivefn_f(res, x, p, opts)
+        fxxevaluated.append(opts.eval.fxx)
+
+    problem.f = objectivefn_f_counted
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    results, solutions, fxxevaluations = [], [], []
+
+    for hessian in [HessianMethod.Exact, HessianMethod.Constant]:
+        options = Options()
+        options.residualfunction.hessian = hessian
+
+        solver = MasterSolver(dims)
+        solver.setOptions(options)
+
+        fxxevaluated.clear()
+
+        u = MasterVector(dims)
+        results.append(solver.solve(problem, u))
+        solutions.append(u)
+        fxxevaluations.append(sum(fxxevaluated))
+
+    exact, constant = results
+    uexact, uconstant = solutions
+
+    assert exact.succeeded
+    assert constant.succeeded
+    assert constant.iterations == exact.iterations
+    assert allclose(uconstant.x, uexact.x)
+    assert allclose(uconstant.w, uexact.w)
+    assert fxxevaluations[0] > 1
+    assert fxxevaluations[1] == 1
+    assert 0 < constant.num_linear_decompositions <= exact.num_linear_decompositions
+    assert exact.num_linear_decompositions <= exact.iterations
@@ -0,0 +1,88 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2020 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+
+
+@pytest.mark.parametrize("hessian", [HessianMethod.Exact, HessianMethod.Constant])
+def testNewtonStepWithConstantJacobianMatrix(hessian):
+
+    # The Newton steps of a quadratic program without functions h and v. With
+    # a constant Hessian matrix, the Jacobian matrix is then constant and its
+    # decomposition is reused while the basic and stable variables remain the
+    # same. Otherwise, it is decomposed in every Newton step. The Newton
+    # steps land on the solution x = cx in both cases.
+
+    nx, np, ny, nz = 5, 0, 2, 0
+
+    Hxx = random.rand(nx, nx)
+    Ax  = random.rand(ny, nx)
+    cx  = random.rand(nx)
+
+    Hxx = Hxx.T @ Hxx + eye(nx)
+
+    def objectivefn_f(res, x, p, opts):
+        dx = x - cx
+        res.f  = 0.5 * dx.T @ Hxx @ dx
+        res.fx = Hxx @ dx
+        if opts.eval.fxx:
+            res.fxx = Hxx
+        res.succeeded = True
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.Ax = Ax
+    problem.Ap = zeros((ny, np))
+    problem.b = Ax @ cx
+    problem.xlower = full(nx, -1e3)
+    problem.xupper = full(nx,  1e3)
+    problem.plower = full(np, -inf)
+    problem.pupper = full(np,  inf)
+    problem.phi = None
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    options = ResidualFunctionOptions()
+    options.hessian = hessian
+
+    F = ResidualFunction(dims)
+    F.setOptions(options)
+    F.initialize(problem)
+
+    step = NewtonStep(dims)
+    step.initialize(problem)
+
+    x0s = [1.0, 2.0, 3.0]
+
+    for x0 in x0s:
+        uo = MasterVector(dims)
+        uo.x = full(nx, x0)
+
+        F.update(uo)
+
+        assert F.result().constant == (hessian == HessianMethod.Constant)
+
+        u = MasterVector(dims)
+        step.apply(F, uo, u)
+
+        assert u.x == approx(cx)
+
+    if hessian == HessianMethod.Constant:
+        assert step.numDecompositions() == 1
+    else:
+        assert step.numDecompositions() == len(x0s)
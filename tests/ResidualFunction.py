@@ -168,3 +168,137 @@ def testResidualFunction(nx, np, ny, nz, nl, nu, b1, b2, b3, b4, b5, b6, b7):
 
     assert result.stabilitystatus.s == approx(g + Wx.T @ w)
 
+
+    # Check that a checkpoint of F is recovered by restore without re-evaluation
+    fx = result.f.fx.copy()
+    Fm = result.Fm.array().copy()
+
+    F.checkpoint()
+
+    v = MasterVector(u)
+    v.x = u.x + 0.1 * abs(random.rand(dims.nx))
+    F.update(v)
+
+    F.restore()
+
+    result = F.result()
+
+    assert result.f.fx == approx(fx)
+    assert result.Fm.array() == approx(Fm)
+
+
+def testResidualFunctionWithDerivativesForBasicVariables():
+
+    nx, np, ny, nz = 8, 0, 2, 3
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    Hxx = random.rand(nx, nx)
+    Hxx = Hxx.T @ Hxx
+    Ax  = random.rand(ny, nx)
+    Jx  = random.rand(nz, nx)
+    cx  = random.rand(nx)
+
+    Jx[random.rand(nz, nx) < 0.3] = 0.0  # zero entries make the basic variables depend on the columns evaluated
+
+    evaluated = {}  # the basic variables in the last evaluation of the derivatives of each function
+
+    def objectivefn_f(res, x, p, opts):
+        res.f  = 0.5 * (x - cx).T @ Hxx @ (x - cx)
+        res.fx = Hxx @ (x - cx)
+        if opts.eval.fxx:
+            jb = list(opts.ibasicvars)
+            res.fxx = 0.0 * Hxx
+            res.fxx[:, jb] = Hxx[:, jb]
+            evaluated["f"] = set(jb)
+        res.fxx4basicvars = True
+
+    def constraintfn_h(res, x, p, opts):
+        res.val = Jx @ (x - cx)
+        if opts.eval.ddx:
+            jb = list(opts.ibasicvars)
+            res.ddx = 0.0 * Jx
+            res.ddx[:, jb] = Jx[:, jb]
+            evaluated["h"] = set(jb)
+        res.ddx4basicvars = True
+
+    def constraintfn_v(res, x, p, opts):
+        pass
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.h = constraintfn_h
+    problem.v = constraintfn_v
+    problem.Ax = Ax
+    problem.Ap = npy.zeros((ny, np))
+    problem.b = Ax @ cx
+    problem.xlower = npy.full(nx, -npy.inf)
+    problem.xupper = npy.full(nx,  npy.inf)
+    problem.phi = None
+
+    u = MasterVector(dims)
+    u.x = random.rand(nx)
+    u.w = random.rand(ny + nz)
+
+    F = ResidualFunction(dims)
+    F.initialize(problem)
+    F.update(u)
+
+    jb = set(F.result().Jm.RWQ.jb)
+
+    # The columns of fxx and ddx must have been evaluated for every basic variable
+    # in the final echelon form of W, which depends on the columns of ddx evaluated
+    assert jb.issubset(evaluated["f"])
+    assert jb.issubset(evaluated["h"])
+
+
+def testResidualFunctionStructureOfCanonicalBlocks():
+
+    nx, np, ny, nz = 8, 2, 3, 0
+
+    dims = MasterDims(nx, np, ny, nz)
+
+    Hxx = random.rand(nx, nx)
+    Hxx = Hxx.T @ Hxx
+    Vpp = npy.eye(np)
+
+    def objectivefn_f(res, x, p, opts):
+        res.f   = 0.5 * x.T @ Hxx @ x
+        res.fx  = Hxx @ x
+        res.fxx = Hxx
+
+    def constraintfn_h(res, x, p, opts):
+        pass
+
+    def constraintfn_v(res, x, p, opts):
+        res.val = p
+        res.ddp = Vpp
+
+    problem = MasterProblem()
+    problem.f = objectivefn_f
+    problem.h = constraintfn_h
+    problem.v = constraintfn_v
+    problem.Ax = random.rand(ny, nx)
+    problem.Ap = npy.zeros((ny, np))
+    problem.b = random.rand(ny)
+    problem.xlower = npy.full(nx, -npy.inf)
+    problem.xupper = npy.full(nx,  npy.inf)
+    problem.phi = None
+
+    u = MasterVector(dims)
+    u.x = random.rand(nx)
+
+    F = ResidualFunction(dims)
+
+    # Sbsp = Rbs * Ap is zero, and its structure is reused in the second update, with the same W = [Ax Ap]
+    F.initialize(problem)
+    F.update(u)
+    assert F.result().Jc.structure.Sbsp == MatrixStructure.Zero
+    F.update(u)
+    assert F.result().Jc.structure.Sbsp == MatrixStructure.Zero
+
+    # The structure of Sbsp must be detected again once Ap changes
+    problem.Ap = random.rand(ny, np)
+    F.initialize(problem)
+    F.update(u)
+    assert F.result().Jc.structure.Sbsp == MatrixStructure.Dense
@@ -161,3 +161,38 @@ def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
     res = solver.solve(problem, state)
 
     assert res.succeeded
+
+    #---------------------------------------------------------------
+    # Test the presolve stage, with an additional fixed variable and
+    # the rows of Ax that are zero (redundant if np = 0)
+    #---------------------------------------------------------------
+
+    xlower[nx - 1] = 1.0  # this variable is not expected to be unstable
+    xupper[nx - 1] = 1.0
+
+    problem.xlower = xlower
+    problem.xupper = xupper
+
+    options.presolve.active = True
+    solver.setOptions(options)
+
+    state = State(dims)
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+    assert state.x[nx - 1] == 1.0
+
+    #---------------------------------------------------------------
+    # Test the interruption of the calculation with a cancelled token
+    #---------------------------------------------------------------
+
+    options.cancellation.cancel()
+    solver.setOptions(options)
+
+    state = State(dims)
+
+    res = solver.solve(problem, state)
+
+    assert res.interrupted
+    assert not res.succeeded
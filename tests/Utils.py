@@ -49,3 +49,13 @@ def testUtils():
     assert bprime[2] == nCaCO3  # b'(CaCO3)
     assert bprime[3] == nCO2    # b'(CO2)
     assert bprime[4] == 0.0     # b'(O2) (ensure here no residual round-off error - sharp zero!)
+
+    #---------------------------------------------------------------
+    # Test method detectMatrixStructure
+    #---------------------------------------------------------------
+
+    assert detectMatrixStructure(npy.zeros((0, 0))) == MatrixStructure.Zero
+    assert detectMatrixStructure(npy.zeros((3, 4))) == MatrixStructure.Zero
+    assert detectMatrixStructure(npy.diag([1.0, 2.0, 3.0])) == MatrixStructure.Diagonal
+    assert detectMatrixStructure(npy.eye(3, 4)) == MatrixStructure.Dense
+    assert detectMatrixStructure(npy.ones((3, 3))) == MatrixStructure.Dense
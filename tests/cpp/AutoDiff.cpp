@@ -0,0 +1,227 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <cmath>
+
+// Optima includes
+#include <Optima/AutoDiff.hpp>
+#include <Optima/IndexUtils.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The objective function used in the tests, with derivatives along all pairs of variables in blocks of different directions.
+const auto objectivefn = [](const auto& x, const auto& p)
+{
+    using std::exp; using std::log; using std::sin;
+    return x[0]*x[0]*x[1] + exp(0.1*x[2])*x[3] + log(1.0 + x[4]*x[4]) + sin(x[5])*x[6]
+         + x[6]*x[6]*x[1] + x[2]*x[5] + p[0]*x[0]*x[2] + p[1]*p[1]*x[5];
+};
+
+/// The constraint function used in the tests.
+const auto constraintfn = [](const auto& x, const auto& p)
+{
+    using std::exp; using std::sin;
+    using Scalar = std::decay_t<decltype(x[0])>;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1> c(3);
+    c[0] = x[0]*x[1] + p[0];
+    c[1] = sin(x[2])*x[3]*p[1];
+    c[2] = exp(x[4]) - x[5]*x[6];
+    return c;
+};
+
+/// The indices of the basic variables given to functions whose derivatives are not computed only for these.
+const Indices nobasicvars;
+
+/// The step length in the central finite differences.
+const auto h = 1e-6;
+
+/// Return the gradient of the objective function computed with central finite differences.
+auto finiteDifferenceGradient(VectorView x, VectorView p) -> Vector
+{
+    Vector fx(x.size());
+    for(Index i = 0; i < x.size(); ++i)
+    {
+        Vector xf = x, xb = x;
+        xf[i] += h;
+        xb[i] -= h;
+        fx[i] = (objectivefn(xf, Vector(p)) - objectivefn(xb, Vector(p)))/(2*h);
+    }
+    return fx;
+}
+
+auto testAutodiffObjectiveFunction() -> void
+{
+    const Index nx = 7, np = 2;
+
+    Vector x(nx), p(np);
+    x << 0.3, -1.2, 0.7, 2.0, -0.5, 1.1, 0.4;
+    p << 1.5, -0.8;
+
+    const auto f = autodiffObjectiveFunction(objectivefn);
+
+    // Return the gradient fx computed with automatic differentiation.
+    const auto gradient = [&](VectorView x, VectorView p) -> Vector
+    {
+        ObjectiveResult res(nx, np);
+        f(res, x, p, ObjectiveOptions{{false, false}, nobasicvars});
+        return res.fx;
+    };
+
+    // The derivatives fxx and fxp computed with central finite differences of fx.
+    Matrix fxx(nx, nx), fxp(nx, np);
+    for(Index j = 0; j < nx; ++j)
+    {
+        Vector xf = x, xb = x;
+        xf[j] += h;
+        xb[j] -= h;
+        fxx.col(j) = (gradient(xf, p) - gradient(xb, p))/(2*h);
+    }
+    for(Index j = 0; j < np; ++j)
+    {
+        Vector pf = p, pb = p;
+        pf[j] += h;
+        pb[j] -= h;
+        fxp.col(j) = (gradient(x, pf) - gradient(x, pb))/(2*h);
+    }
+
+    const auto fx = finiteDifferenceGradient(x, p);
+
+    ObjectiveResult res(nx, np);
+
+    f(res, x, p, ObjectiveOptions{{true, true}, nobasicvars});
+
+    check("f", Vector::Constant(1, res.f), Vector::Constant(1, objectivefn(x, p)), 1e-14);
+    check("fx", res.fx, fx, 1e-8);
+    check("fxx", res.fxx, fxx, 1e-6);
+    check("fxp", res.fxp, fxp, 1e-6);
+    check("fxx4basicvars is false by default", !res.fxx4basicvars);
+
+    // Only the columns of fxx for the basic variables are computed if these are fewer than half of the variables.
+    const auto fb = autodiffObjectiveFunction(objectivefn, true);
+
+    const Indices jb = (Indices(3) << 1, 4, 6).finished();
+
+    ObjectiveResult resb(nx, np);
+
+    fb(resb, x, p, ObjectiveOptions{{true, true}, jb});
+
+    Matrix fxxb = zeros(nx, nx);
+    fxxb(Eigen::all, jb) = fxx(Eigen::all, jb);
+
+    check("fx with basic variables", resb.fx, fx, 1e-8);
+    check("fxx with basic variables", resb.fxx, fxxb, 1e-6);
+    check("fxp with basic variables", resb.fxp, fxp, 1e-6);
+    check("fxx4basicvars with basic variables", resb.fxx4basicvars);
+
+    // Otherwise, fxx is computed in full.
+    const Indices jall = indices(nx);
+
+    fb(resb, x, p, ObjectiveOptions{{true, true}, jall});
+
+    check("fxx with all variables basic", resb.fxx, fxx, 1e-6);
+    check("fxx4basicvars with all variables basic", !resb.fxx4basicvars);
+
+    // The gradient is computed even if there are no basic variables and fxp is not needed.
+    ObjectiveResult res0(nx, np);
+
+    fb(res0, x, p, ObjectiveOptions{{true, false}, nobasicvars});
+
+    check("fx without basic variables", res0.fx, fx, 1e-8);
+    check("fxx without basic variables", res0.fxx, zeros(nx, nx), 0.0);
+}
+
+auto testAutodiffConstraintFunction() -> void
+{
+    const Index nx = 7, np = 2, nc = 3;
+
+    Vector x(nx), p(np);
+    x << 0.3, -1.2, 0.7, 2.0, -0.5, 1.1, 0.4;
+    p << 1.5, -0.8;
+
+    const auto c = autodiffConstraintFunction(constraintfn);
+
+    Matrix ddx(nc, nx), ddp(nc, np);
+    for(Index j = 0; j < nx; ++j)
+    {
+        Vector xf = x, xb = x;
+        xf[j] += h;
+        xb[j] -= h;
+        ddx.col(j) = (constraintfn(xf, p) - constraintfn(xb, p))/(2*h);
+    }
+    for(Index j = 0; j < np; ++j)
+    {
+        Vector pf = p, pb = p;
+        pf[j] += h;
+        pb[j] -= h;
+        ddp.col(j) = (constraintfn(x, pf) - constraintfn(x, pb))/(2*h);
+    }
+
+    ConstraintResult res(nc, nx, np);
+
+    c(res, x, p, ConstraintOptions{{true, true}, nobasicvars});
+
+    check("val", res.val, constraintfn(x, p), 1e-14);
+    check("ddx", res.ddx, ddx, 1e-8);
+    check("ddp", res.ddp, ddp, 1e-8);
+    check("ddx4basicvars without basic variables", !res.ddx4basicvars);
+
+    // The number of evaluations of the constraint function, counted below.
+    Index calls = 0;
+
+    const auto counted = [&](const auto& x, const auto& p) { ++calls; return constraintfn(x, p); };
+
+    // Only the columns of ddx for the basic variables are computed by default, in fewer passes than those for all variables.
+    const auto cb = autodiffConstraintFunction(counted);
+
+    const Indices jb = (Indices(3) << 1, 4, 6).finished();
+
+    ConstraintResult resb(nc, nx, np);
+
+    cb(resb, x, p, ConstraintOptions{{true, false}, jb});
+
+    Matrix ddxb = zeros(nc, nx);
+    ddxb(Eigen::all, jb) = ddx(Eigen::all, jb);
+
+    check("val with basic variables", resb.val, constraintfn(x, p), 1e-14);
+    check("ddx with basic variables", resb.ddx, ddxb, 1e-8);
+    check("ddx4basicvars with basic variables", resb.ddx4basicvars);
+    check("one evaluation for ddx with 3 basic variables", calls == 1);
+
+    // Otherwise, if disabled, ddx is computed in full, in a pass for each 4 variables.
+    const auto cf = autodiffConstraintFunction(counted, false);
+
+    ConstraintResult resf(nc, nx, np);
+
+    calls = 0;
+
+    cf(resf, x, p, ConstraintOptions{{true, false}, jb});
+
+    check("ddx with basic variables disabled", resf.ddx, ddx, 1e-8);
+    check("ddx4basicvars with basic variables disabled", !resf.ddx4basicvars);
+    check("two evaluations for ddx with 7 variables", calls == 2);
+}
+
+int main()
+{
+    testAutodiffObjectiveFunction();
+    testAutodiffConstraintFunction();
+
+    return exitStatus();
+}
@@ -0,0 +1,115 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <cmath>
+
+// Optima includes
+#include <Optima/BacktrackSearch.hpp>
+#include <Optima/MasterProblem.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/ResidualErrors.hpp>
+#include <Optima/ResidualFunction.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The dimensions of the master problem in the tests.
+const MasterDims dims(3, 0, 1, 0);
+
+/// Return the master problem of minimizing f = sum(x ln x) subject to x0 + x1 + x2 = 1, whose error is not finite if some x is negative.
+auto createMasterProblem() -> MasterProblem
+{
+    MasterProblem problem;
+    problem.f = [](ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions /*opts*/)
+    {
+        res.f = (x.array() * x.array().log()).sum();
+        res.fx = x.array().log() + 1.0;
+        res.fxx.diagonal() = 1.0/x.array();
+        res.diagfxx = true;
+    };
+    problem.Ax = Matrix::Ones(1, 3);
+    problem.Ap = zeros(1, 0);
+    problem.b = constants(1, 1.0);
+    problem.xlower = constants(3, -infinity());
+    problem.xupper = constants(3, infinity());
+    problem.plower = zeros(0);
+    problem.pupper = zeros(0);
+    return problem;
+}
+
+/// Return true if the backtrack search with given maximum number of iterations finds a trial state with finite error
+/// along the step from x = (0.3, 0.3, 0.3) to x = (-10, 0.3, 0.3), whose error is not finite, with the result in *u*.
+/// The search is performed with the given cancellation token.
+auto backtrack(double maxiters, MasterVector& u, CancellationToken cancellation = CancellationToken()) -> bool
+{
+    const auto problem = createMasterProblem();
+
+    ResidualFunction F(dims);
+    ResidualErrors E(dims);
+    F.initialize(problem);
+    E.initialize(problem);
+
+    MasterVector uo(dims);
+    uo.x.fill(0.3);
+    uo.w.fill(0.0);
+
+    F.update(uo);
+    E.update(uo, F);
+
+    u = uo;
+    u.x[0] = -10.0;
+
+    Options options;
+    options.backtrack.maxiters = maxiters;
+    options.cancellation = cancellation;
+
+    BacktrackSearch backtracksearch(dims);
+    backtracksearch.setOptions(options);
+
+    return backtracksearch.start(uo, u, F, E);
+}
+
+auto testBacktrackSearch() -> void
+{
+    MasterVector u(dims);
+
+    // The first trial state, with x0 = 0.9*0.3 - 0.1*10, has an error that is not finite, unlike the second one
+    check("backtrack search found", backtrack(10, u));
+    check("backtrack search x0", std::abs(u.x[0] - (0.99*0.3 - 0.01*10.0)) < 1e-14);
+
+    check("backtrack search with one iteration not found", !backtrack(1, u));
+    check("backtrack search with one iteration x0 unchanged", u.x[0] == -10.0);
+
+    check("backtrack search without iterations not found", !backtrack(0, u));
+    check("backtrack search without iterations x0 unchanged", u.x[0] == -10.0);
+
+    CancellationToken token;
+    token.cancel();
+
+    check("backtrack search with cancellation not found", !backtrack(10, u, token));
+    check("backtrack search with cancellation x0 unchanged", u.x[0] == -10.0);
+}
+
+int main()
+{
+    testBacktrackSearch();
+
+    return exitStatus();
+}
@@ -0,0 +1,255 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Optima includes
+#include <Optima/BatchLockstepSolver.hpp>
+#include <Optima/BatchLU.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/TinySolver.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The tolerance for the computed solutions.
+const auto tol = 1e-6;
+
+/// Check the LU decompositions of matrices that need pivoting and of a singular one against dense solutions.
+auto testBatchLU() -> void
+{
+    const Index n = 4;
+    const Index lanes = 5;
+
+    std::vector<Matrix> A(lanes);
+    for(Index l = 0; l < lanes; ++l)
+        A[l] = Matrix::Random(n, n) + 4.0*(l % 2)*identity(n, n);
+    A[1](0, 0) = 0.0;                            // needs a row swap in the first step
+    A[2] << 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 0; // needs a row swap in every step
+    A[3].row(2).setZero();                       // singular
+
+    LaneMatrix Alanes(n*n, lanes);
+    LaneMatrix b = LaneMatrix::Random(n, lanes);
+    for(Index l = 0; l < lanes; ++l)
+        for(Index i = 0; i < n; ++i)
+            for(Index j = 0; j < n; ++j)
+                Alanes(i*n + j, l) = A[l](i, j);
+
+    BatchLU lu;
+    lu.decompose(Alanes);
+
+    LaneMatrix x = b;
+    lu.solve(x);
+
+    for(Index l = 0; l < lanes; ++l)
+    {
+        const auto lane = "BatchLU lane " + std::to_string(l);
+        check((lane + " singular").c_str(), lu.singular()[l] == (l == 3));
+        if(l != 3)
+            check((lane + " solution").c_str(), x.col(l), A[l].fullPivLu().solve(Vector(b.col(l))), 1e-10);
+    }
+}
+
+/// Check the lockstep solutions of entropy minimization problems against those of TinySolver.
+/// The problems differ in *be* and in a shift of the standard chemical potentials that depends
+/// on the index of the problem (as the temperature of a cell would), and *Aex* has a dependent row.
+auto testEntropyMinimization(Index threads) -> void
+{
+    const Index nx = 6;
+    const Index ny = 3;
+    const Index size = 19; // more problems than lanes, and not a multiple of the number of lanes
+
+    Matrix Ax = Matrix::Random(ny, nx).array() + 1.0;
+    const Vector c = Vector::Random(nx);
+
+    LockstepProblem problem(Dims{nx, 0, ny + 1});
+    problem.Aex << Ax, Ax.row(0) + Ax.row(1);
+    problem.xlower = constants(nx, 1e-40);
+    problem.f = [&](LaneMatrixView x, Index offset, LaneMatrixRef fx, LaneMatrixRef fxx)
+    {
+        for(Index i = 0; i < nx; ++i)
+        {
+            fx.row(i).array() = x.row(i).array().log() + c[i];
+            for(Index l = 0; l < x.cols(); ++l)
+                fx(i, l) += 0.01*(offset + l);
+            fxx.row(i*nx + i).array() = 1.0/x.row(i).array();
+        }
+    };
+
+    BatchProblem batch;
+    batch.be.resize(ny + 1, size);
+    for(Index k = 0; k < size; ++k)
+    {
+        const Vector xs = Vector::Random(nx).array() + 1.1;
+        batch.be.col(k) = problem.Aex * xs;
+    }
+
+    Options options;
+    options.batch.lanes = 8;
+    options.batch.threads = threads;
+
+    BatchLockstepSolver solver(problem);
+    solver.setOptions(options);
+
+    BatchState state(problem.dims, size);
+    state.x.fill(1.0);
+
+    const auto result = solver.solve(problem, batch, state);
+
+    check("entropy minimization result", result.succeeded);
+
+    using Tiny = TinySolver<8, 4>;
+
+    Tiny::Problem tproblem;
+    tproblem.Ax = Ax;
+    tproblem.xlower.setConstant(nx, 1e-40);
+    tproblem.xupper.setConstant(nx, infinity());
+
+    Tiny tsolver;
+
+    for(Index k = 0; k < size; ++k)
+    {
+        const auto f = [&](Tiny::ObjectiveResult& res, const Tiny::VectorX& x)
+        {
+            res.f = (x.array() * (x.array().log() - 1.0 + c.array() + 0.01*k)).sum();
+            res.fx = x.array().log() + c.array() + 0.01*k;
+            res.fxx.diagonal() = 1.0/x.array();
+        };
+
+        tproblem.b = batch.be.col(k).head(ny);
+
+        Tiny::VectorX x = Vector::Ones(nx);
+        Tiny::VectorY y;
+        const auto tresult = tsolver.solve(tproblem, f, x, y);
+
+        const auto name = "entropy minimization problem " + std::to_string(k);
+        check((name + " succeeded").c_str(), state.succeeded[k] == 1 && tresult.succeeded);
+        check((name + " iterations").c_str(), std::abs(state.iterations[k] - tresult.iterations) <= 1); // the feasibility errors are measured with the echelonized Aex
+        check((name + " x").c_str(), state.x.col(k), x, tol);
+        check((name + " w").c_str(), problem.Aex.transpose() * state.w.col(k), Ax.transpose() * y, tol);
+    }
+}
+
+/// Check the lockstep solutions of projections onto the simplex, whose active bounds differ between the lanes.
+auto testSimplexProjection() -> void
+{
+    const Index nx = 5;
+    const Index size = 11;
+
+    LockstepProblem problem(Dims{nx, 0, 1});
+    problem.Aex.fill(1.0);
+    problem.be.fill(1.0);
+    problem.xlower.fill(0.0);
+
+    const Matrix points = 2.0*Matrix::Random(nx, size);
+
+    problem.f = [&](LaneMatrixView x, Index offset, LaneMatrixRef fx, LaneMatrixRef fxx)
+    {
+        fx = x - points.middleCols(offset, x.cols());
+        for(Index i = 0; i < nx; ++i)
+            fxx.row(i*nx + i).fill(1.0);
+    };
+
+    Options options;
+    options.batch.lanes = 4;
+
+    BatchLockstepSolver solver(problem);
+    solver.setOptions(options);
+
+    BatchState state(problem.dims, size);
+    state.x.fill(0.2);
+
+    const auto result = solver.solve(problem, BatchProblem(), state);
+
+    check("simplex projection result", result.succeeded);
+
+    for(Index k = 0; k < size; ++k)
+    {
+        // The projection of the point onto the simplex, with the threshold found from the sorted coordinates
+        Vector sorted = points.col(k);
+        std::sort(sorted.data(), sorted.data() + nx, std::greater<double>());
+        double threshold = 0.0;
+        double sum = 0.0;
+        for(Index i = 0; i < nx; ++i)
+        {
+            sum += sorted[i];
+            if(sorted[i] - (sum - 1.0)/(i + 1) > 0.0)
+                threshold = (sum - 1.0)/(i + 1);
+        }
+        const Vector expected = (points.col(k).array() - threshold).max(0.0);
+
+        const auto name = "simplex projection problem " + std::to_string(k);
+        check((name + " succeeded").c_str(), state.succeeded[k] == 1);
+        check((name + " x").c_str(), state.x.col(k), expected, tol);
+    }
+}
+
+/// Check that a lane whose objective function cannot be evaluated fails without affecting the others.
+auto testFailedLane() -> void
+{
+    const Index nx = 2;
+    const Index size = 6;
+
+    LockstepProblem problem(Dims{nx, 0, 1});
+    problem.Aex << 1.0, 1.0;
+    problem.be << 1.0;
+
+    problem.f = [&](LaneMatrixView x, Index offset, LaneMatrixRef fx, LaneMatrixRef fxx)
+    {
+        fx = x;
+        fxx.row(0).fill(1.0);
+        fxx.row(3).fill(1.0);
+        for(Index l = 0; l < x.cols(); ++l)
+            if(offset + l == 3)
+                fx(0, l) = NAN;
+    };
+
+    BatchLockstepSolver solver(problem);
+
+    BatchState state(problem.dims, size);
+
+    const auto result = solver.solve(problem, BatchProblem(), state);
+
+    check("failed lane result", !result.succeeded);
+    check("failed lane reason", result.failure_reason == "The objective function could not be evaluated.");
+
+    for(Index k = 0; k < size; ++k)
+    {
+        const auto name = "failed lane problem " + std::to_string(k);
+        check((name + " succeeded").c_str(), state.succeeded[k] == (k != 3));
+        if(k != 3)
+            check((name + " x").c_str(), state.x.col(k), Vector::Constant(nx, 0.5), tol);
+    }
+}
+
+int main()
+{
+    testBatchLU();
+    testEntropyMinimization(0);
+    testEntropyMinimization(2);
+    testSimplexProjection();
+    testFailedLane();
+    return exitStatus();
+}
@@ -0,0 +1,191 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <cmath>
+
+// Optima includes
+#include <Optima/Decomposer.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The tolerance for the computed solutions.
+const auto tol = 1e-4;
+
+/// The objective function f = (x0 - 1)² + (x1 - 2)² + x0²x1² + x2² + 2x3².
+/// Its entries fxx(0, 1) = fxx(1, 0) = 4x0x1 are zero at x = 0.
+auto objectivefn(ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions opts) -> void
+{
+    res.f = (x[0] - 1)*(x[0] - 1) + (x[1] - 2)*(x[1] - 2) + x[0]*x[0]*x[1]*x[1] + x[2]*x[2] + 2*x[3]*x[3];
+    res.fx[0] = 2*(x[0] - 1) + 2*x[0]*x[1]*x[1];
+    res.fx[1] = 2*(x[1] - 2) + 2*x[0]*x[0]*x[1];
+    res.fx[2] = 2*x[2];
+    res.fx[3] = 4*x[3];
+    if(!opts.eval.fxx) return;
+    res.fxx.setZero();
+    res.fxx(0, 0) = 2 + 2*x[1]*x[1];
+    res.fxx(1, 1) = 2 + 2*x[0]*x[0];
+    res.fxx(0, 1) = res.fxx(1, 0) = 4*x[0]*x[1];
+    res.fxx(2, 2) = 2;
+    res.fxx(3, 3) = 4;
+}
+
+/// The objective function f = (x0 - 1)² + (x1 - 2)² + x1·max(0, x0 - 0.5)³ + x2² + 2x3².
+/// Its entries fxx(0, 1) = fxx(1, 0) = 3max(0, x0 - 0.5)² are zero near x = 0, but not at the solution.
+auto objectivefnHiddenCoupling(ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions opts) -> void
+{
+    const auto t = std::max(0.0, x[0] - 0.5);
+    res.f = (x[0] - 1)*(x[0] - 1) + (x[1] - 2)*(x[1] - 2) + x[1]*t*t*t + x[2]*x[2] + 2*x[3]*x[3];
+    res.fx[0] = 2*(x[0] - 1) + 3*x[1]*t*t;
+    res.fx[1] = 2*(x[1] - 2) + t*t*t;
+    res.fx[2] = 2*x[2];
+    res.fx[3] = 4*x[3];
+    if(!opts.eval.fxx) return;
+    res.fxx.setZero();
+    res.fxx(0, 0) = 2 + 6*x[1]*t;
+    res.fxx(1, 1) = 2;
+    res.fxx(0, 1) = res.fxx(1, 0) = 3*t*t;
+    res.fxx(2, 2) = 2;
+    res.fxx(3, 3) = 4;
+}
+
+/// Return the problem with the given objective function and the linear equality constraint x2 + x3 = 1.
+auto createProblem(const ObjectiveFunction& f) -> Problem
+{
+    Problem problem(Dims{4, 0, 1, 0, 0, 0});
+    problem.Aex << 0.0, 0.0, 1.0, 1.0;
+    problem.be << 1.0;
+    problem.f = f;
+    return problem;
+}
+
+/// Return the options of the solver with the decomposition of the problem active.
+auto createOptions() -> Options
+{
+    Options options;
+    options.decompose.active = true;
+    return options;
+}
+
+auto testDecomposerWithDetectedPattern() -> void
+{
+    const auto problem = createProblem(ObjectiveFunction(objectivefn));
+
+    auto options = createOptions();
+    options.decompose.detect = true;
+
+    // The coupling of x0 and x1 vanishes at x = 0, but not at the point near it
+    State state(problem.dims);
+    state.x.fill(0.0);
+
+    Decomposer decomposer(problem.dims);
+    decomposer.setOptions(options);
+
+    check("decomposition with detected pattern", decomposer.decompose(problem, state));
+    check("number of subproblems with detected pattern", decomposer.numSubproblems() == 2);
+    check("detected pattern", decomposer.detected());
+
+    Solver solver(problem);
+    solver.setOptions(options);
+
+    const auto result = solver.solve(problem, state);
+
+    check("success with detected pattern", result.succeeded);
+    check("x with detected pattern", state.x, (Vector(4) << 0.214821, 1.911788, 2.0/3.0, 1.0/3.0).finished(), tol);
+}
+
+auto testDecomposerWithGivenPattern() -> void
+{
+    const auto problem = createProblem(ObjectiveFunction(objectivefn));
+
+    State state(problem.dims);
+    state.x.fill(0.0);
+
+    Decomposer decomposer(problem.dims);
+
+    // The non-linear objective function couples all variables if its pattern is neither given nor detected
+    auto options = createOptions();
+    decomposer.setOptions(options);
+
+    check("no decomposition without pattern", !decomposer.decompose(problem, state));
+
+    // The given pattern is used even if the coupling of x0 and x1 vanishes at x = 0
+    options.decompose.fxx = identity(4, 4);
+    options.decompose.fxx(0, 1) = options.decompose.fxx(1, 0) = 1.0;
+    decomposer.setOptions(options);
+
+    check("decomposition with given pattern", decomposer.decompose(problem, state));
+    check("number of subproblems with given pattern", decomposer.numSubproblems() == 2);
+    check("given pattern", !decomposer.detected());
+
+    Solver solver(problem);
+    solver.setOptions(options);
+
+    const auto result = solver.solve(problem, state);
+
+    check("success with given pattern", result.succeeded);
+    check("x with given pattern", state.x, (Vector(4) << 0.214821, 1.911788, 2.0/3.0, 1.0/3.0).finished(), tol);
+}
+
+auto testDecomposerWithMissedCoupling() -> void
+{
+    const auto problem = createProblem(ObjectiveFunction(objectivefnHiddenCoupling));
+
+    auto options = createOptions();
+    options.decompose.detect = true;
+
+    // The coupling of x0 and x1 vanishes at x = 0 and at the point near it
+    State state(problem.dims);
+    state.x.fill(0.0);
+
+    Decomposer decomposer(problem.dims);
+    decomposer.setOptions(options);
+
+    check("decomposition with missed coupling", decomposer.decompose(problem, state));
+    check("number of subproblems with missed coupling", decomposer.numSubproblems() == 3);
+
+    // The stitched solution is not optimal, and so the original problem is solved from it
+    Solver solver(problem);
+    solver.setOptions(options);
+
+    const auto result = solver.solve(problem, state);
+
+    ObjectiveResult res(4, 0);
+    objectivefnHiddenCoupling(res, state.x, state.p, ObjectiveOptions{{false, false}, Indices()});
+
+    check("success with missed coupling", result.succeeded);
+    check("fx0 with missed coupling", Vector::Constant(1, res.fx[0]), zeros(1), tol);
+    check("fx1 with missed coupling", Vector::Constant(1, res.fx[1]), zeros(1), tol);
+    check("x0 coupled to x1 with missed coupling", state.x[0] > 0.5 && state.x[1] < 2.0);
+    check("x2 and x3 with missed coupling", state.x.tail(2), (Vector(2) << 2.0/3.0, 1.0/3.0).finished(), tol);
+}
+
+int main()
+{
+    testDecomposerWithDetectedPattern();
+    testDecomposerWithGivenPattern();
+    testDecomposerWithMissedCoupling();
+
+    return exitStatus();
+}
@@ -0,0 +1,136 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// Optima includes
+#include <Optima/FiniteDifferences.hpp>
+#include <Optima/IndexUtils.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The indices of the basic variables given to the functions (not used by the finite difference functions).
+const Indices nobasicvars;
+
+/// The tolerance for the derivatives computed with forward differences.
+const auto tol = 1e-6;
+
+/// The objective function f = x0²x1² + |x|² + p0²x1 evaluating only f and fx.
+/// Its entries fxx(0, 1) = fxx(1, 0) = 4x0x1 are zero at x = 0.
+auto objectivefn(ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions /*opts*/) -> void
+{
+    res.f = x[0]*x[0]*x[1]*x[1] + x.squaredNorm() + p[0]*p[0]*x[1];
+    res.fx[0] = 2*x[0]*x[1]*x[1] + 2*x[0];
+    res.fx[1] = 2*x[0]*x[0]*x[1] + 2*x[1] + p[0]*p[0];
+}
+
+/// The constraint function c = (x0x1, x1 + x2², p0x2), whose entries ddx(0, 0), ddx(0, 1) and ddx(1, 2) are zero at x = 0.
+auto constraintfn(ConstraintResultRef res, VectorView x, VectorView p, ConstraintOptions /*opts*/) -> void
+{
+    res.val[0] = x[0]*x[1];
+    res.val[1] = x[1] + x[2]*x[2];
+    res.val[2] = p[0]*x[2];
+}
+
+/// Evaluate an objective function at *(x, p)* with all its derivatives.
+auto evaluate(const ObjectiveFunction& f, VectorView x, VectorView p) -> ObjectiveResult
+{
+    ObjectiveResult res(x.size(), p.size());
+    f(res, x, p, ObjectiveOptions{{true, true}, nobasicvars});
+    return res;
+}
+
+/// Evaluate a constraint function at *(x, p)* with all its derivatives.
+auto evaluate(const ConstraintFunction& c, Index nc, VectorView x, VectorView p) -> ConstraintResult
+{
+    ConstraintResult res(nc, x.size(), p.size());
+    c(res, x, p, ConstraintOptions{{true, true}, nobasicvars});
+    return res;
+}
+
+auto testFiniteDifferenceObjectiveFunction() -> void
+{
+    const Vector p = constants(1, 2.0);
+
+    const Matrix fxx = (Matrix(2, 2) << 4.0, 4.0, 4.0, 4.0).finished(); // at x = (1, 1)
+    const Matrix fxp = (Matrix(2, 1) << 0.0, 4.0).finished();           // at p = 2
+
+    // The sparsity pattern of fxx detected in the first evaluation at x = 0 is also valid at x = (1, 1).
+    const auto f = finiteDifferenceObjectiveFunction(ObjectiveFunction(objectivefn));
+
+    const auto res0 = evaluate(f, zeros(2), p);
+
+    check("fxx at x = 0", res0.fxx, 2.0*identity(2, 2), tol);
+
+    const auto res1 = evaluate(f, ones(2), p);
+
+    check("f at x = 1", Vector::Constant(1, res1.f), Vector::Constant(1, 7.0), 0.0);
+    check("fx at x = 1", res1.fx, (Vector(2) << 4.0, 8.0).finished(), 0.0);
+    check("fxx at x = 1 after x = 0", res1.fxx, fxx, tol);
+    check("fxp at x = 1 after x = 0", res1.fxp, fxp, tol);
+
+    // The sparsity pattern is given, and so it is not detected.
+    const auto fp = finiteDifferenceObjectiveFunction(ObjectiveFunction(objectivefn), ones(2, 2));
+
+    check("fxx at x = 1 with given pattern", evaluate(fp, ones(2), p).fxx, fxx, tol);
+
+    // All entries of fxx are considered non-zero if the evaluation fails at the perturbed point.
+    auto failingfn = [](ObjectiveResultRef res, VectorView x, VectorView p, ObjectiveOptions opts)
+    {
+        objectivefn(res, x, p, opts);
+        res.succeeded = x[0] <= 0.005 || x[0] >= 0.5;
+    };
+
+    const auto ff = finiteDifferenceObjectiveFunction(ObjectiveFunction(failingfn));
+
+    check("fxx at x = 0 with failure at the perturbed point", evaluate(ff, zeros(2), p).fxx, 2.0*identity(2, 2), tol);
+    check("fxx at x = 1 with failure at the perturbed point", evaluate(ff, ones(2), p).fxx, fxx, tol);
+}
+
+auto testFiniteDifferenceConstraintFunction() -> void
+{
+    const Vector p = constants(1, 2.0);
+
+    const Matrix ddx = (Matrix(3, 3) << 1.0, 1.0, 0.0, 0.0, 1.0, 2.0, 0.0, 0.0, 2.0).finished(); // at x = (1, 1, 1)
+    const Matrix ddp = (Matrix(3, 1) << 0.0, 0.0, 1.0).finished();
+
+    // The sparsity pattern of ddx detected in the first evaluation at x = 0 is also valid at x = (1, 1, 1).
+    const auto c = finiteDifferenceConstraintFunction(ConstraintFunction(constraintfn));
+
+    const auto res0 = evaluate(c, 3, zeros(3), p);
+
+    check("ddx at x = 0", res0.ddx, (Matrix(3, 3) << 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 2.0).finished(), tol);
+
+    const auto res1 = evaluate(c, 3, ones(3), p);
+
+    check("val at x = 1", res1.val, (Vector(3) << 1.0, 2.0, 2.0).finished(), 0.0);
+    check("ddx at x = 1 after x = 0", res1.ddx, ddx, tol);
+    check("ddp at x = 1 after x = 0", res1.ddp, ddp, tol);
+
+    // The sparsity pattern is given, and so it is not detected.
+    const auto cp = finiteDifferenceConstraintFunction(ConstraintFunction(constraintfn), ddx);
+
+    check("ddx at x = 1 with given pattern", evaluate(cp, 3, ones(3), p).ddx, ddx, tol);
+}
+
+int main()
+{
+    testFiniteDifferenceObjectiveFunction();
+    testFiniteDifferenceConstraintFunction();
+
+    return exitStatus();
+}
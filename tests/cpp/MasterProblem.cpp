@@ -0,0 +1,158 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <cmath>
+
+// Optima includes
+#include <Optima/MasterProblem.hpp>
+#include <Optima/MasterSolver.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+#include <Optima/Utils.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The tolerance for the computed solutions.
+const auto tol = 1e-6;
+
+/// Return the master problem of minimizing f = sum(x ln x) + x0 x1 subject to x0 + x1 + x2 = 1,
+/// h = x0 - 2 x1 = 0 and x > 0. Its functions count in *zeroed* the evaluations of the
+/// derivatives on zeroed storage, and in *kept* those on storage with the entries written
+/// in a previous evaluation. Its functions never write the entries of fxx and of the
+/// Jacobian matrix of h that are constant zeros, and count in *dirty* those found not zero.
+auto createMasterProblem(Index& zeroed, Index& kept, Index& dirty) -> MasterProblem
+{
+    MasterProblem problem;
+
+    problem.f = [&](ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions opts)
+    {
+        res.f = (x.array() * x.array().log()).sum() + x[0]*x[1];
+        res.fx = x.array().log() + 1.0;
+        res.fx[0] += x[1];
+        res.fx[1] += x[0];
+        if(!opts.eval.fxx)
+            return;
+        zeroed += res.fxx.isZero(0.0);
+        kept += res.fxx(0, 1) == 1.0 && res.fxx(1, 0) == 1.0;
+        dirty += res.fxx(0, 2) != 0.0 || res.fxx(2, 0) != 0.0 || res.fxx(1, 2) != 0.0 || res.fxx(2, 1) != 0.0;
+        res.fxx(0, 1) = res.fxx(1, 0) = 1.0;
+        res.fxx.diagonal() = 1.0/x.array();
+    };
+
+    problem.h = [&](ConstraintResultRef res, VectorView x, VectorView /*p*/, ConstraintOptions opts)
+    {
+        res.val[0] = x[0] - 2*x[1];
+        if(!opts.eval.ddx)
+            return;
+        zeroed += res.ddx.isZero(0.0);
+        kept += res.ddx(0, 0) == 1.0 && res.ddx(0, 1) == -2.0;
+        dirty += res.ddx(0, 2) != 0.0;
+        res.ddx(0, 0) = 1.0;
+        res.ddx(0, 1) = -2.0;
+    };
+
+    problem.Ax = Matrix::Ones(1, 3);
+    problem.Ap = zeros(1, 0);
+    problem.b = constants(1, 1.0);
+    problem.xlower = constants(3, 1e-40);
+    problem.xupper = constants(3, infinity());
+    problem.plower = zeros(0);
+    problem.pupper = zeros(0);
+
+    return problem;
+}
+
+/// Check that the storage of the results of the functions of a master problem is not zeroed between their evaluations.
+auto testMasterProblemWithStorageNotZeroedPerCall() -> void
+{
+    const MasterDims dims(3, 0, 1, 1);
+
+    Index zeroed = 0;
+    Index kept = 0;
+    Index dirty = 0;
+
+    MasterSolver solver(dims);
+
+    MasterVector u(dims);
+    u.x.fill(0.3);
+    u.w.fill(0.0);
+
+    const auto result = solver.solve(createMasterProblem(zeroed, kept, dirty), u);
+
+    // Only the first evaluation of f and h on each storage (of the current and the checkpointed states of the residual function) finds it zeroed
+    check("storage not zeroed per call succeeded", result.succeeded);
+    check("storage not zeroed per call zeroed", zeroed <= 4);
+    check("storage not zeroed per call kept", kept > 0);
+    check("storage not zeroed per call dirty", dirty == 0);
+    check("storage not zeroed per call h", std::abs(u.x[0] - 2*u.x[1]) < tol);
+    check("storage not zeroed per call Ax", std::abs(u.x.sum() - 1.0) < tol);
+}
+
+/// Check that the functions of Problem are still evaluated on zeroed results, with slack variables in the master problem.
+auto testProblemWithZeroedResults() -> void
+{
+    Problem problem(Dims{3, 0, 1, 1, 1, 0});
+    problem.Aex << 1.0, 1.0, 1.0;
+    problem.be << 1.0;
+    problem.Agx << 1.0, 0.0, 0.0;
+    problem.bg << 0.5;
+    problem.xlower.fill(1e-40);
+
+    Index notzeroed = 0;
+
+    problem.f = [&](ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions /*opts*/)
+    {
+        notzeroed += !res.fx.isZero(0.0) || !res.fxx.isZero(0.0) || !res.fxp.isZero(0.0);
+        res.f = (x.array() * x.array().log()).sum();
+        res.fx = x.array().log() + 1.0;
+        res.fxx.diagonal() = 1.0/x.array();
+        res.diagfxx = true;
+    };
+
+    problem.he = [&](ConstraintResultRef res, VectorView x, VectorView /*p*/, ConstraintOptions /*opts*/)
+    {
+        notzeroed += !res.val.isZero(0.0) || !res.ddx.isZero(0.0);
+        res.val[0] = x[1] - x[2];
+        res.ddx(0, 1) = 1.0;
+        res.ddx(0, 2) = -1.0;
+    };
+
+    Solver solver(problem);
+
+    State state(problem.dims);
+    state.x.fill(0.3);
+
+    const auto result = solver.solve(problem, state);
+
+    check("zeroed results succeeded", result.succeeded);
+    check("zeroed results", notzeroed == 0);
+    check("zeroed results x", state.x, (Vector(3) << 0.5, 0.25, 0.25).finished(), tol);
+}
+
+int main()
+{
+    testMasterProblemWithStorageNotZeroedPerCall();
+    testProblemWithZeroedResults();
+
+    return exitStatus();
+}
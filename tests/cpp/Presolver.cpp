@@ -0,0 +1,121 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <string>
+
+// Optima includes
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The number of variables in the test problems.
+const Index nx = 5;
+
+/// The tolerance in the comparison of the solutions with and without presolve.
+const auto tol = 1e-6;
+
+/// Return a problem of minimizing f = ½|x - c|² with c = (1, 2, 3, 4, 5), subject to
+/// *nbe* linear equality constraints and a linear inequality constraint.
+auto createProblem(Index nbe) -> Problem
+{
+    Problem problem(Dims{nx, 0, nbe, 1, 0, 0});
+    problem.f = [](ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions /*opts*/)
+    {
+        const Vector c = linspace(nx, 1.0, 5.0);
+        res.f = 0.5 * (x - c).squaredNorm();
+        res.fx = x - c;
+        res.fxx.diagonal().fill(1.0);
+        res.diagfxx = true;
+    };
+    return problem;
+}
+
+/// Check that the solutions of the given problem with and without presolve are the same.
+auto checkPresolve(const std::string& name, const Problem& problem) -> void
+{
+    const auto solve = [&](bool presolve)
+    {
+        Options options;
+        options.presolve.active = presolve;
+
+        Solver solver(problem);
+        solver.setOptions(options);
+
+        State state(problem.dims);
+
+        const auto result = solver.solve(problem, state);
+
+        check((name + (presolve ? " succeeded with presolve" : " succeeded without presolve")).c_str(), result.succeeded);
+
+        return state;
+    };
+
+    const auto expected = solve(false);
+    const auto actual = solve(true);
+
+    check((name + " x").c_str(), actual.x, expected.x, tol);
+    check((name + " ye").c_str(), actual.ye, expected.ye, tol);
+    check((name + " yg").c_str(), actual.yg, expected.yg, tol);
+    check((name + " s").c_str(), actual.s, expected.s, tol);
+}
+
+auto testPresolverWithSingletonRows() -> void
+{
+    // The row x0 = 0.5 is a singleton row, and so is x0 + x1 = 2 once x0 is eliminated.
+    // The inequality constraint x2 - x3 ≥ 0.5 is active.
+    Problem problem = createProblem(3);
+    problem.Aex << 1.0, 0.0, 0.0, 0.0, 0.0,
+                   1.0, 1.0, 0.0, 0.0, 0.0,
+                   0.0, 0.0, 1.0, 1.0, 1.0;
+    problem.be << 0.5, 2.0, 3.0;
+    problem.Agx << 0.0, 0.0, 1.0, -1.0, 0.0;
+    problem.bg << 0.5;
+
+    checkPresolve("singleton rows", problem);
+}
+
+auto testPresolverWithLinearlyDependentRows() -> void
+{
+    // The third row is twice the first one, and the fourth one is the sum of the first and second ones.
+    // The inequality constraint -x4 ≥ -1.5 and the upper bound x3 ≤ 2 are active.
+    Problem problem = createProblem(4);
+    problem.Aex << 1.0,  1.0, 1.0, 1.0, 1.0,
+                   1.0, -1.0, 0.0, 0.0, 0.0,
+                   2.0,  2.0, 2.0, 2.0, 2.0,
+                   2.0,  0.0, 1.0, 1.0, 1.0;
+    problem.be << 5.0, 0.0, 10.0, 5.0;
+    problem.Agx << 0.0, 0.0, 0.0, 0.0, -1.0;
+    problem.bg << -1.5;
+    problem.xupper[3] = 2.0;
+
+    checkPresolve("linearly dependent rows", problem);
+}
+
+int main()
+{
+    testPresolverWithSingletonRows();
+    testPresolverWithLinearlyDependentRows();
+
+    return exitStatus();
+}
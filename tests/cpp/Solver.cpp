@@ -0,0 +1,232 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+
+// Optima includes
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+#include <Optima/Timing.hpp>
+using namespace Optima;
+
+// Test includes
+#include "Testing.hpp"
+
+/// The number of variables in the test problem.
+const Index nx = 3;
+
+/// The number of evaluations of the objective function and the point of the last one.
+struct Evaluations
+{
+    std::atomic<Index> count{0};
+    Vector xlast = zeros(nx);
+};
+
+/// Return the problem of minimizing f = sum(x⁴/4 - x) subject to x0 = 1, which takes many iterations from x = 0.01.
+/// Each evaluation of the objective function sleeps for the given time and is recorded in *evals*, which may
+/// also cancel the calculation with *token* once the given number of evaluations is reached.
+auto createProblem(Evaluations& evals, std::chrono::milliseconds sleep, CancellationToken token, Index cancelat) -> Problem
+{
+    Problem problem(Dims{nx, 0, 1, 0, 0, 0});
+    problem.Aex << 1.0, 0.0, 0.0;
+    problem.be << 1.0;
+    problem.f = [=, &evals](ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions opts) mutable
+    {
+        std::this_thread::sleep_for(sleep);
+        res.f = (x.array().pow(4)/4.0).sum() - x.sum();
+        res.fx = x.array().cube() - 1.0;
+        if(opts.eval.fxx)
+        {
+            res.fxx.setZero();
+            res.fxx.diagonal() = 3.0*x.array().square();
+        }
+        res.diagfxx = true;
+        evals.xlast = x;
+        if(++evals.count == cancelat)
+            token.cancel();
+    };
+    return problem;
+}
+
+auto testSolverWithTimeLimit() -> void
+{
+    Evaluations evals;
+    const auto problem = createProblem(evals, std::chrono::milliseconds(20), CancellationToken(), -1);
+
+    Options options;
+    options.timelimit = 0.1;
+
+    Solver solver(problem);
+    solver.setOptions(options);
+
+    State state(problem.dims);
+    state.x.fill(0.01);
+
+    Timer timer;
+    const auto result = solver.solve(problem, state);
+    const auto time = timer.elapsed();
+
+    check("time limit interrupted", result.interrupted && !result.succeeded);
+    check("time limit reason", result.failure_reason == "The calculation exceeded its time limit.");
+    check("time limit elapsed", time < 1.0);
+    check("time limit x", state.x.allFinite());
+}
+
+auto testSolverWithBestIterate() -> void
+{
+    // The calculation is cancelled at every evaluation in turn, so that it is
+    // interrupted both after the Newton steps and after the error control
+    for(Index cancelat = 1; cancelat <= 30; ++cancelat)
+    {
+        CancellationToken token;
+        Evaluations evals;
+        const auto problem = createProblem(evals, std::chrono::milliseconds(0), token, cancelat);
+
+        Options options;
+        options.cancellation = token;
+
+        Solver solver(problem);
+        solver.setOptions(options);
+
+        State state(problem.dims);
+        state.x.fill(0.01);
+
+        const auto result = solver.solve(problem, state);
+
+        // The residual function is evaluated at the returned iterate (e.g., for the output of the final state)
+        const auto name = "best iterate with cancellation at evaluation " + std::to_string(cancelat);
+        check((name + " interrupted").c_str(), result.interrupted && !result.succeeded);
+        check((name + " reason").c_str(), result.failure_reason == "The calculation was cancelled.");
+        check((name + " last evaluation").c_str(), evals.xlast, state.x, 0.0);
+        check((name + " error").c_str(), std::isfinite(result.error));
+    }
+}
+
+auto testSolverAsync() -> void
+{
+    // Without interruption, the asynchronous calculation is the same as the synchronous one
+    {
+        Evaluations evals;
+        const auto problem = createProblem(evals, std::chrono::milliseconds(0), CancellationToken(), -1);
+
+        Solver solver(problem);
+
+        State state(problem.dims);
+        state.x.fill(0.01);
+
+        State stateasync = state;
+
+        const auto result = solver.solve(problem, state);
+        const auto resultasync = solver.solveAsync(problem, stateasync).get();
+
+        check("async succeeded", result.succeeded && resultasync.succeeded);
+        check("async iterations", result.iterations == resultasync.iterations);
+        check("async x", stateasync.x, state.x, 0.0);
+        check("async w", stateasync.w, state.w, 0.0);
+    }
+
+    // The asynchronous calculation is cancelled from this thread while it runs
+    {
+        CancellationToken token;
+        Evaluations evals;
+        const auto problem = createProblem(evals, std::chrono::milliseconds(10), CancellationToken(), -1);
+
+        Options options;
+        options.cancellation = token;
+
+        Solver solver(problem);
+        solver.setOptions(options);
+
+        State state(problem.dims);
+        state.x.fill(0.01);
+
+        auto future = solver.solveAsync(problem, state);
+
+        while(evals.count < 3)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        token.cancel();
+
+        const auto result = future.get();
+
+        check("async cancelled", result.interrupted && !result.succeeded);
+        check("async cancelled reason", result.failure_reason == "The calculation was cancelled.");
+        check("async cancelled x", state.x.allFinite());
+    }
+}
+
+/// Check that a solve call with an unchanged problem reuses the echelon form of Ax of the previous one.
+auto testSolverWithUnchangedProblem() -> void
+{
+    // The problem of minimizing f = sum(x ln x) subject to x0 + x1 + x2 = be, with solution x = be/3
+    Problem problem(Dims{nx, 0, 1, 0, 0, 0});
+    problem.Aex << 1.0, 1.0, 1.0;
+    problem.be << 1.0;
+    problem.xlower.fill(1e-40);
+    problem.f = [](ObjectiveResultRef res, VectorView x, VectorView /*p*/, ObjectiveOptions /*opts*/)
+    {
+        res.f = (x.array() * x.array().log()).sum();
+        res.fx = x.array().log() + 1.0;
+        res.fxx.diagonal() = 1.0/x.array();
+        res.diagfxx = true;
+    };
+
+    Solver solver(problem);
+    State state(problem.dims);
+
+    auto result = solver.solve(problem, state);
+
+    check("unchanged problem first solve", result.succeeded && result.num_echelonizations == 1);
+
+    state.x.fill(1.0);
+    result = solver.solve(problem, state);
+
+    check("unchanged problem second solve", result.succeeded && result.num_echelonizations == 0);
+    check("unchanged problem second solve x", state.x, constants(nx, 1.0/3.0), 1e-6);
+
+    problem.be << 2.0;
+    state.x.fill(1.0);
+    result = solver.solve(problem, state);
+
+    check("changed be", result.succeeded && result.num_echelonizations == 0);
+    check("changed be x", state.x, constants(nx, 2.0/3.0), 1e-6);
+
+    problem.Aex << 2.0, 2.0, 2.0;
+    state.x.fill(1.0);
+    result = solver.solve(problem, state);
+
+    check("changed Aex", result.succeeded && result.num_echelonizations == 1);
+    check("changed Aex x", state.x, constants(nx, 1.0/3.0), 1e-6);
+}
+
+int main()
+{
+    testSolverWithTimeLimit();
+    testSolverWithBestIterate();
+    testSolverAsync();
+    testSolverWithUnchangedProblem();
+
+    return exitStatus();
+}
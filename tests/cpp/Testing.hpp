@@ -0,0 +1,61 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+// C++ includes
+#include <cstdlib>
+#include <iostream>
+
+// Optima includes
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// The number of failed checks in the test executable.
+inline int failures = 0;
+
+/// Check that the given matrices are equal within a tolerance relative to the largest entry in *expected* (or one).
+inline auto check(const char* name, MatrixView actual, MatrixView expected, double tol) -> void
+{
+    const auto error = actual.size() ? (actual - expected).cwiseAbs().maxCoeff() : 0.0;
+    const auto scale = expected.size() ? std::max(1.0, expected.cwiseAbs().maxCoeff()) : 1.0;
+    if(!(error <= tol * scale))
+    {
+        std::cerr << "Check failed for " << name << " with error " << error << std::endl;
+        ++failures;
+    }
+}
+
+/// Check that the given condition is true.
+inline auto check(const char* name, bool condition) -> void
+{
+    if(!condition)
+    {
+        std::cerr << "Check failed for " << name << std::endl;
+        ++failures;
+    }
+}
+
+/// Return the exit status of the test executable according to the failed checks.
+inline auto exitStatus() -> int
+{
+    if(failures)
+        std::cerr << failures << " checks failed." << std::endl;
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+} // namespace Optima